@@ -6,7 +6,7 @@
 -- This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
 -- distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 --
--- date: 2015-04-07
+-- date: 2015-06-04
 --
 
 ------------------------------------------------------------------------------------------------------------------------
@@ -69,6 +69,10 @@ CSTD = "-std=gnu99"
 -- debug flags
 DBGFLAGS = "-g -ggdb3"
 
+-- overrides of kernel configuration (distortosConfiguration.h) used by the test application - deferred processing of
+-- kernel requests made from interrupts and sleeping in idle thread are enabled, so that they are covered by the tests
+CONFIGFLAGS = "-DCONFIG_DEFERRED_INTERRUPT_REQUESTS=1 -DCONFIG_IDLE_SLEEP=1"
+
 ------------------------------------------------------------------------------------------------------------------------
 -- compilation flags
 ------------------------------------------------------------------------------------------------------------------------
@@ -81,6 +85,7 @@ CFLAGS += OPTIMIZATION
 CFLAGS += CWARNINGS
 CFLAGS += CSTD
 CFLAGS += DBGFLAGS
+CFLAGS += CONFIGFLAGS
 CFLAGS += "-ffunction-sections -fdata-sections"
 
 CXXFLAGS += COREFLAGS
@@ -88,6 +93,7 @@ CXXFLAGS += OPTIMIZATION
 CXXFLAGS += CXXWARNINGS
 CXXFLAGS += CXXSTD
 CXXFLAGS += DBGFLAGS
+CXXFLAGS += CONFIGFLAGS
 CXXFLAGS += "-ffunction-sections -fdata-sections -fno-rtti -fno-exceptions"
 
 LDFLAGS += COREFLAGS
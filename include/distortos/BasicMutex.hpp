@@ -0,0 +1,223 @@
+/**
+ * \file
+ * \brief BasicMutex class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-02
+ */
+
+#ifndef INCLUDE_DISTORTOS_BASICMUTEX_HPP_
+#define INCLUDE_DISTORTOS_BASICMUTEX_HPP_
+
+#include "distortos/Mutex.hpp"
+
+#include "distortos/synchronization/BasicMutexControlBlock.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief BasicMutex is a variant of Mutex with type and protocol selected at compile time.
+ *
+ * Behavior of BasicMutex is identical to Mutex with the same type and protocol, but the code of each variant handles
+ * only its own type and protocol. BasicMutex with Protocol::None doesn't have the storage for link on the list of
+ * mutexes owned by a thread, so it is also smaller than Mutex.
+ *
+ * Mutex should be used where type or protocol are known only at run-time or where one object must work with mutexes of
+ * different kinds (like ConditionVariable).
+ *
+ * \note All 9 variants are explicitly instantiated in BasicMutex.cpp.
+ *
+ * \param type is the type of mutex
+ * \param protocol is the mutex protocol
+ */
+
+template<Mutex::Type type, Mutex::Protocol protocol>
+class BasicMutex
+{
+public:
+
+	/// import Protocol type from Mutex
+	using Protocol = Mutex::Protocol;
+
+	/// import RecursiveLocksCount type from Mutex
+	using RecursiveLocksCount = Mutex::RecursiveLocksCount;
+
+	/// import Type type from Mutex
+	using Type = Mutex::Type;
+
+	/**
+	 * \brief Gets the maximum number of recursive locks possible before returning EAGAIN
+	 *
+	 * \note Actual number of lock() operations possible is getMaxRecursiveLocks() + 1.
+	 *
+	 * \return maximum number of recursive locks possible before returning EAGAIN
+	 */
+
+	constexpr static RecursiveLocksCount getMaxRecursiveLocks()
+	{
+		return Mutex::getMaxRecursiveLocks();
+	}
+
+	/**
+	 * \brief BasicMutex's constructor
+	 *
+	 * \param [in] priorityCeiling is the priority ceiling of mutex, ignored when protocol != Protocol::PriorityProtect,
+	 * default - 0
+	 * \param [in] competitive selects the unlocking mode when some threads are blocked on the mutex - false to transfer
+	 * ownership directly to the highest priority waiting thread, true to just unblock this thread and let it compete
+	 * for the mutex with other threads, default - false
+	 */
+
+	explicit BasicMutex(const uint8_t priorityCeiling = {}, const bool competitive = {}) :
+			controlBlock_{priorityCeiling, competitive},
+			recursiveLocksCount_{}
+	{
+
+	}
+
+	/**
+	 * \brief Locks the mutex.
+	 *
+	 * Same as Mutex::lock().
+	 *
+	 * \return zero if the caller successfully locked the mutex, error code otherwise:
+	 * - EAGAIN - the mutex could not be acquired because the maximum number of recursive locks for mutex has been
+	 * exceeded;
+	 * - EDEADLK - the mutex type is ErrorChecking and the current thread already owns the mutex;
+	 * - EINVAL - the mutex protocol is PriorityProtect and the calling thread's priority is higher than the mutex's
+	 * priority ceiling;
+	 */
+
+	int lock();
+
+	/**
+	 * \brief Tries to lock the mutex.
+	 *
+	 * Same as Mutex::tryLock().
+	 *
+	 * \return zero if the caller successfully locked the mutex, error code otherwise:
+	 * - EAGAIN - the mutex could not be acquired because the maximum number of recursive locks for mutex has been
+	 * exceeded;
+	 * - EBUSY - the mutex could not be acquired because it was already locked;
+	 * - EINVAL - the mutex protocol is PriorityProtect and the calling thread's priority is higher than the mutex's
+	 * priority ceiling;
+	 */
+
+	int tryLock();
+
+	/**
+	 * \brief Tries to lock the mutex for given duration of time.
+	 *
+	 * Same as Mutex::tryLockFor().
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated without locking the mutex
+	 *
+	 * \return zero if the caller successfully locked the mutex, error code otherwise:
+	 * - error codes returned by tryLockUntil();
+	 */
+
+	int tryLockFor(TickClock::duration duration);
+
+	/**
+	 * Tries to lock the mutex for given duration of time.
+	 *
+	 * Template variant of tryLockFor(TickClock::duration duration).
+	 *
+	 * \param Rep is type of tick counter
+	 * \param Period is std::ratio type representing the tick period of the clock, in seconds
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated without locking the mutex
+	 *
+	 * \return zero if the caller successfully locked the mutex, error code otherwise:
+	 * - error codes returned by tryLockUntil();
+	 */
+
+	template<typename Rep, typename Period>
+	int tryLockFor(const std::chrono::duration<Rep, Period> duration)
+	{
+		return tryLockFor(std::chrono::duration_cast<TickClock::duration>(duration));
+	}
+
+	/**
+	 * \brief Tries to lock the mutex until given time point.
+	 *
+	 * Same as Mutex::tryLockUntil().
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated without locking the mutex
+	 *
+	 * \return zero if the caller successfully locked the mutex, error code otherwise:
+	 * - EAGAIN - the mutex could not be acquired because the maximum number of recursive locks for mutex has been
+	 * exceeded;
+	 * - EDEADLK - the mutex type is ErrorChecking and the current thread already owns the mutex;
+	 * - EINVAL - the mutex protocol is PriorityProtect and the calling thread's priority is higher than the mutex's
+	 * priority ceiling;
+	 * - ETIMEDOUT - the mutex could not be locked before the specified timeout expired;
+	 */
+
+	int tryLockUntil(TickClock::time_point timePoint);
+
+	/**
+	 * \brief Tries to lock the mutex until given time point.
+	 *
+	 * Template variant of tryLockUntil(TickClock::time_point timePoint).
+	 *
+	 * \param Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated without locking the mutex
+	 *
+	 * \return zero if the caller successfully locked the mutex, error code otherwise:
+	 * - error codes returned by tryLockUntil(TickClock::time_point);
+	 */
+
+	template<typename Duration>
+	int tryLockUntil(const std::chrono::time_point<TickClock, Duration> timePoint)
+	{
+		return tryLockUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint));
+	}
+
+	/**
+	 * \brief Unlocks the mutex.
+	 *
+	 * Same as Mutex::unlock().
+	 *
+	 * \return zero if the caller successfully unlocked the mutex, error code otherwise:
+	 * - EPERM - the mutex type is ErrorChecking or Recursive, and the current thread does not own the mutex;
+	 */
+
+	int unlock();
+
+private:
+
+	/**
+	 * \brief Internal version of tryLock().
+	 *
+	 * Internal version with no interrupt masking and additional code for ErrorChecking type (which is not required for
+	 * tryLock()).
+	 *
+	 * \return zero if the caller successfully locked the mutex, error code otherwise:
+	 * - EAGAIN - the mutex could not be acquired because the maximum number of recursive locks for mutex has been
+	 * exceeded;
+	 * - EBUSY - the mutex could not be acquired because it was already locked;
+	 * - EDEADLK - the mutex type is ErrorChecking and the current thread already owns the mutex;
+	 * - EINVAL - the mutex protocol is PriorityProtect and the calling thread's priority is higher than the mutex's
+	 * priority ceiling;
+	 */
+
+	int tryLockInternal();
+
+	/// instance of control block
+	synchronization::BasicMutexControlBlock<protocol> controlBlock_;
+
+	/// number of recursive locks, used when mutex type is Recursive
+	RecursiveLocksCount recursiveLocksCount_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_BASICMUTEX_HPP_
@@ -0,0 +1,291 @@
+/**
+ * \file
+ * \brief Channel class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#ifndef INCLUDE_DISTORTOS_CHANNEL_HPP_
+#define INCLUDE_DISTORTOS_CHANNEL_HPP_
+
+#include "distortos/synchronization/MutexControlBlock.hpp"
+
+#include <utility>
+
+namespace distortos
+{
+
+/**
+ * \brief Channel is a synchronous (rendezvous) send/receive/reply IPC mechanism.
+ *
+ * Client sends a request with send() and stays blocked until the server replies. Server gets the request with
+ * receive() - it is given direct access to client's request and reply buffers (no copying is done by the Channel) - and
+ * unblocks the client with reply(). Many clients may send via one Channel at once, they are received in priority
+ * order. Only one thread at a time may act as a server of the Channel.
+ *
+ * Server inherits the priority of the highest priority client which is waiting to be received or waiting for reply.
+ * This is implemented with internal synchronization::MutexControlBlock with PriorityInheritance protocol owned by the
+ * server, so the regular boosted priority mechanism of mutexes is used. Changes of clients' priorities after they
+ * started waiting are not propagated to the server.
+ *
+ * Message of each client is reachable via its ThreadControlBlock (it is kept by the functor passed when the client
+ * blocks), so both send() and receive() are O(1) with respect to the number of waiting clients.
+ */
+
+class Channel
+{
+public:
+
+	/// single request-reply transaction, stored in client's stack for the whole duration of send()
+	class Message
+	{
+		friend class Channel;
+
+	public:
+
+		/**
+		 * \return pointer to client's reply buffer
+		 */
+
+		void* getReply() const
+		{
+			return reply_;
+		}
+
+		/**
+		 * \return size of client's reply buffer, bytes
+		 */
+
+		size_t getReplySize() const
+		{
+			return replySize_;
+		}
+
+		/**
+		 * \return pointer to client's request
+		 */
+
+		const void* getRequest() const
+		{
+			return request_;
+		}
+
+		/**
+		 * \return size of client's request, bytes
+		 */
+
+		size_t getRequestSize() const
+		{
+			return requestSize_;
+		}
+
+		Message(const Message&) = delete;
+		Message(Message&&) = delete;
+		const Message& operator=(const Message&) = delete;
+		Message& operator=(Message&&) = delete;
+
+	private:
+
+		/**
+		 * \brief Message's constructor
+		 *
+		 * \param [in] request is a pointer to client's request
+		 * \param [in] requestSize is the size of client's request, bytes
+		 * \param [in] reply is a pointer to client's reply buffer
+		 * \param [in] replySize is the size of client's reply buffer, bytes
+		 * \param [in] client is a reference to ThreadControlBlock of client
+		 */
+
+		constexpr Message(const void* const request, const size_t requestSize, void* const reply,
+				const size_t replySize, scheduler::ThreadControlBlock& client) :
+				request_{request},
+				requestSize_{requestSize},
+				reply_{reply},
+				replySize_{replySize},
+				client_{&client}
+		{
+
+		}
+
+		/// pointer to client's request
+		const void* request_;
+
+		/// size of client's request, bytes
+		size_t requestSize_;
+
+		/// pointer to client's reply buffer
+		void* reply_;
+
+		/// size of client's reply buffer, bytes
+		size_t replySize_;
+
+		/// pointer to ThreadControlBlock of client, nullptr after reply
+		scheduler::ThreadControlBlock* client_;
+	};
+
+	/**
+	 * \brief Channel's constructor
+	 */
+
+	Channel();
+
+	/**
+	 * \brief Receives request from the highest priority client, blocking until some client sends it.
+	 *
+	 * After successful return calling thread is the server of the Channel until all received messages are replied and
+	 * no clients are waiting.
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and pointer to received message; error codes:
+	 * - EBUSY - some other thread is the server of the Channel;
+	 */
+
+	std::pair<int, Message*> receive();
+
+	/**
+	 * \brief Replies to received message, unblocking the client.
+	 *
+	 * Reply must be written to Message::getReply() buffer before this function is called. \a message must not be used
+	 * after this call.
+	 *
+	 * \param [in] message is a reference to message received with receive() (or its variants)
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a message was not received from this Channel or it was already replied;
+	 */
+
+	int reply(Message& message);
+
+	/**
+	 * \brief Sends request to server and waits for reply.
+	 *
+	 * \param [in] request is a pointer to request
+	 * \param [in] requestSize is the size of \a request, bytes
+	 * \param [out] reply is a pointer to buffer for reply
+	 * \param [in] replySize is the size of \a reply, bytes
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EDEADLK - calling thread is the server of the Channel;
+	 */
+
+	int send(const void* request, size_t requestSize, void* reply, size_t replySize);
+
+	/**
+	 * \brief Sends request to server and waits for reply.
+	 *
+	 * \param Request is the type of request
+	 * \param Reply is the type of reply
+	 *
+	 * \param [in] request is a reference to request
+	 * \param [out] reply is a reference to object for reply
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by send(const void*, size_t, void*, size_t);
+	 */
+
+	template<typename Request, typename Reply>
+	int send(const Request& request, Reply& reply)
+	{
+		return send(&request, sizeof(request), &reply, sizeof(reply));
+	}
+
+	/**
+	 * \brief Tries to receive request from the highest priority client.
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and pointer to received message; error codes:
+	 * - EAGAIN - no client is waiting;
+	 * - EBUSY - some other thread is the server of the Channel;
+	 */
+
+	std::pair<int, Message*> tryReceive();
+
+	/**
+	 * \brief Tries to receive request from the highest priority client for given duration of time.
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated without receiving
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and pointer to received message; error codes:
+	 * - EBUSY - some other thread is the server of the Channel;
+	 * - ETIMEDOUT - no client sent a request before the specified timeout expired;
+	 */
+
+	std::pair<int, Message*> tryReceiveFor(TickClock::duration duration);
+
+	/**
+	 * \brief Tries to receive request from the highest priority client until given time point.
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated without receiving
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and pointer to received message; error codes:
+	 * - EBUSY - some other thread is the server of the Channel;
+	 * - ETIMEDOUT - no client sent a request before the specified timeout expired;
+	 */
+
+	std::pair<int, Message*> tryReceiveUntil(TickClock::time_point timePoint);
+
+	Channel(const Channel&) = delete;
+	Channel(Channel&&) = delete;
+	const Channel& operator=(const Channel&) = delete;
+	Channel& operator=(Channel&&) = delete;
+
+private:
+
+	/**
+	 * \brief Releases the server if it has nothing more to do.
+	 *
+	 * Ownership of \a serverControlBlock_ is released when no clients are waiting, no messages are waiting for reply and
+	 * the server is not blocked in receive().
+	 *
+	 * \attention This function must be called with interrupt masking enabled.
+	 */
+
+	void releaseServerIfIdle();
+
+	/**
+	 * \brief Implementation of receive(), tryReceive() and tryReceiveUntil().
+	 *
+	 * \param [in] nonBlocking selects whether this function operates in blocking mode (false) or non-blocking mode
+	 * (true)
+	 * \param [in] timePoint is a pointer to time point at which the wait will be terminated, used only if blocking
+	 * mode is selected, nullptr to block without timeout
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and pointer to received message; error codes:
+	 * - EAGAIN - no client is waiting and non-blocking mode was selected;
+	 * - EBUSY - some other thread is the server of the Channel;
+	 * - ETIMEDOUT - no client sent a request before specified \a timePoint;
+	 */
+
+	std::pair<int, Message*> receiveImplementation(bool nonBlocking, const TickClock::time_point* timePoint);
+
+	/**
+	 * \brief Updates priority inherited by the server.
+	 *
+	 * \attention This function must be called with interrupt masking enabled.
+	 *
+	 * \param [in] priority is the initial priority, this should be effective priority of the client that is about to
+	 * be blocked, default - 0
+	 */
+
+	void updateServerPriority(uint8_t priority = {});
+
+	/// control block (with PriorityInheritance protocol) owned by the server, used to boost its priority
+	synchronization::MutexControlBlock serverControlBlock_;
+
+	/// ThreadControlBlock objects of clients waiting to be received
+	scheduler::ThreadControlBlockList sendersList_;
+
+	/// ThreadControlBlock objects of clients waiting for reply
+	scheduler::ThreadControlBlockList repliesList_;
+
+	/// ThreadControlBlock object of server blocked in receive()
+	scheduler::ThreadControlBlockList receiverList_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_CHANNEL_HPP_
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-01-19
+ * \date 2015-05-26
  */
 
 #ifndef INCLUDE_DISTORTOS_FIFOQUEUE_HPP_
@@ -30,6 +30,8 @@
 namespace distortos
 {
 
+class WaitSet;
+
 /**
  * \brief FifoQueue class is a simple FIFO queue for thread-thread, thread-interrupt or interrupt-interrupt
  * communication. It supports multiple readers and multiple writers. It is implemented as a wrapper for
@@ -41,6 +43,8 @@ namespace distortos
 template<typename T>
 class FifoQueue
 {
+	friend class WaitSet;
+
 public:
 
 	/// type of uninitialized storage for data
@@ -164,6 +168,43 @@ public:
 		return pushInternal(semaphoreWaitFunctor, std::move(value));
 	}
 
+	/**
+	 * \brief Pushes the element to the queue and hands the CPU directly to the thread which was waiting for it.
+	 *
+	 * Same as push(const T&), but the "pop" semaphore is posted with Semaphore::postAndSwitch().
+	 *
+	 * \param [in] value is a reference to object that will be pushed, value in queue's storage is copy-constructed
+	 *
+	 * \return zero if element was pushed successfully, error code otherwise:
+	 * - error codes returned by Semaphore::wait();
+	 * - error codes returned by Semaphore::postAndSwitch();
+	 */
+
+	int pushAndSwitch(const T& value)
+	{
+		const synchronization::SemaphoreWaitFunctor semaphoreWaitFunctor;
+		return pushInternal(semaphoreWaitFunctor, value, true);
+	}
+
+	/**
+	 * \brief Pushes the element to the queue and hands the CPU directly to the thread which was waiting for it.
+	 *
+	 * Same as push(T&&), but the "pop" semaphore is posted with Semaphore::postAndSwitch().
+	 *
+	 * \param [in] value is a rvalue reference to object that will be pushed, value in queue's storage is
+	 * move-constructed
+	 *
+	 * \return zero if element was pushed successfully, error code otherwise:
+	 * - error codes returned by Semaphore::wait();
+	 * - error codes returned by Semaphore::postAndSwitch();
+	 */
+
+	int pushAndSwitch(T&& value)
+	{
+		const synchronization::SemaphoreWaitFunctor semaphoreWaitFunctor;
+		return pushInternal(semaphoreWaitFunctor, std::move(value), true);
+	}
+
 #if DISTORTOS_FIFOQUEUE_EMPLACE_SUPPORTED == 1 || DOXYGEN == 1
 
 	/**
@@ -681,13 +722,16 @@ private:
 	 *
 	 * \param [in] waitSemaphoreFunctor is a reference to SemaphoreFunctor which will be executed with \a pushSemaphore_
 	 * \param [in] value is a reference to object that will be pushed, value in queue's storage is copy-constructed
+	 * \param [in] switchToUnblocked selects whether the CPU is handed directly to the thread which was waiting for the
+	 * element (true) or not (false), default - false
 	 *
 	 * \return zero if element was pushed successfully, error code otherwise:
 	 * - error codes returned by \a waitSemaphoreFunctor's operator() call;
 	 * - error codes returned by Semaphore::post();
 	 */
 
-	int pushInternal(const synchronization::SemaphoreFunctor& waitSemaphoreFunctor, const T& value);
+	int pushInternal(const synchronization::SemaphoreFunctor& waitSemaphoreFunctor, const T& value,
+			bool switchToUnblocked = false);
 
 	/**
 	 * \brief Pushes the element to the queue.
@@ -697,13 +741,16 @@ private:
 	 * \param [in] waitSemaphoreFunctor is a reference to SemaphoreFunctor which will be executed with \a pushSemaphore_
 	 * \param [in] value is a rvalue reference to object that will be pushed, value in queue's storage is
 	 * move-constructed
+	 * \param [in] switchToUnblocked selects whether the CPU is handed directly to the thread which was waiting for the
+	 * element (true) or not (false), default - false
 	 *
 	 * \return zero if element was pushed successfully, error code otherwise:
 	 * - error codes returned by \a waitSemaphoreFunctor's operator() call;
 	 * - error codes returned by Semaphore::post();
 	 */
 
-	int pushInternal(const synchronization::SemaphoreFunctor& waitSemaphoreFunctor, T&& value);
+	int pushInternal(const synchronization::SemaphoreFunctor& waitSemaphoreFunctor, T&& value,
+			bool switchToUnblocked = false);
 
 	/// contained synchronization::FifoQueueBase object which implements whole functionality
 	synchronization::FifoQueueBase fifoQueueBase_;
@@ -733,17 +780,19 @@ int FifoQueue<T>::popInternal(const synchronization::SemaphoreFunctor& waitSemap
 }
 
 template<typename T>
-int FifoQueue<T>::pushInternal(const synchronization::SemaphoreFunctor& waitSemaphoreFunctor, const T& value)
+int FifoQueue<T>::pushInternal(const synchronization::SemaphoreFunctor& waitSemaphoreFunctor, const T& value,
+		const bool switchToUnblocked)
 {
 	const synchronization::CopyConstructQueueFunctor<T> copyConstructQueueFunctor {value};
-	return fifoQueueBase_.push(waitSemaphoreFunctor, copyConstructQueueFunctor);
+	return fifoQueueBase_.push(waitSemaphoreFunctor, copyConstructQueueFunctor, switchToUnblocked);
 }
 
 template<typename T>
-int FifoQueue<T>::pushInternal(const synchronization::SemaphoreFunctor& waitSemaphoreFunctor, T&& value)
+int FifoQueue<T>::pushInternal(const synchronization::SemaphoreFunctor& waitSemaphoreFunctor, T&& value,
+		const bool switchToUnblocked)
 {
 	const synchronization::MoveConstructQueueFunctor<T> moveConstructQueueFunctor {std::move(value)};
-	return fifoQueueBase_.push(waitSemaphoreFunctor, moveConstructQueueFunctor);
+	return fifoQueueBase_.push(waitSemaphoreFunctor, moveConstructQueueFunctor, switchToUnblocked);
 }
 
 }	// namespace distortos
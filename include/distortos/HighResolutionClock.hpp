@@ -0,0 +1,64 @@
+/**
+ * \file
+ * \brief HighResolutionClock class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#ifndef INCLUDE_DISTORTOS_HIGHRESOLUTIONCLOCK_HPP_
+#define INCLUDE_DISTORTOS_HIGHRESOLUTIONCLOCK_HPP_
+
+#include "distortos/TickClock.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief HighResolutionClock is a std::chrono clock with resolution of tick timer's clock (CONFIG_TICK_CLOCK),
+ * equivalent of std::chrono::high_resolution_clock
+ *
+ * Current time is a combination of tick count and current state of tick timer. The clock has the same epoch as
+ * TickClock and its time_point is a time point of TickClock (with finer duration), so it can be used directly with all
+ * functions that accept std::chrono::time_point<TickClock, Duration> - in that case the value is truncated to whole
+ * ticks.
+ */
+
+class HighResolutionClock
+{
+public:
+
+	/// type of counter
+	using rep = uint64_t;
+
+	/// std::ratio type representing the period of the clock, in seconds
+	using period = std::ratio<1, CONFIG_TICK_CLOCK>;
+
+	/// basic duration type of clock
+	using duration = std::chrono::duration<rep, period>;
+
+	/// basic time_point type of clock - time point of TickClock, as both clocks have the same epoch
+	using time_point = std::chrono::time_point<TickClock, duration>;
+
+	/**
+	 * \note Interrupts are masked for a short moment, as tick count and tick timer must be read consistently.
+	 * \note When called from an interrupt which preempted "tick" interrupt before it incremented tick count, the value
+	 * returned by previous call is returned again, so the clock is monotonic.
+	 *
+	 * \return time_point representing the current value of the clock
+	 */
+
+	static time_point now();
+
+	/// this is a steady clock - it cannot be adjusted
+	static constexpr bool is_steady = true;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_HIGHRESOLUTIONCLOCK_HPP_
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-01-19
+ * \date 2015-05-16
  */
 
 #ifndef INCLUDE_DISTORTOS_MESSAGEQUEUE_HPP_
@@ -26,6 +26,8 @@
 namespace distortos
 {
 
+class WaitSet;
+
 /// GCC 4.9 is needed for all MessageQueue::*emplace*() functions - earlier versions don't support parameter pack
 /// expansion in lambdas
 #define DISTORTOS_MESSAGEQUEUE_EMPLACE_SUPPORTED	__GNUC_PREREQ(4, 9)
@@ -43,6 +45,8 @@ namespace distortos
 template<typename T>
 class MessageQueue
 {
+	friend class WaitSet;
+
 public:
 
 	/// type of uninitialized storage for data
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-01-12
+ * \date 2015-05-14
  */
 
 #ifndef INCLUDE_DISTORTOS_MUTEX_HPP_
@@ -25,6 +25,14 @@ namespace distortos
  * Similar to std::mutex - http://en.cppreference.com/w/cpp/thread/mutex
  * Similar to POSIX pthread_mutex_t -
  * http://pubs.opengroup.org/onlinepubs/9699919799/functions/V2_chap02.html#tag_15_09 -> 2.9.3 Thread Mutexes
+ *
+ * \note Uncontended locking and unlocking of mutex with Protocol::None is done with lock-free fast path, without
+ * interrupt masking - the kernel is involved only when the mutex is already locked or some thread is blocked on it.
+ *
+ * \note By default unlocking of mutex with blocked threads transfers the ownership directly to the highest priority
+ * waiting thread, which is strictly fair, but a thread that unlocks and immediately locks the mutex again in a loop is
+ * forced to block on each iteration ("lock convoy"). In competitive mode the waiting thread is only unblocked and
+ * whichever thread runs first gets the mutex.
  */
 
 class Mutex
@@ -72,9 +80,13 @@ public:
 	 * \param [in] protocol is the mutex protocol, default - Protocol::None
 	 * \param [in] priorityCeiling is the priority ceiling of mutex, ignored when protocol != Protocol::PriorityProtect,
 	 * default - 0
+	 * \param [in] competitive selects the unlocking mode when some threads are blocked on the mutex - false to transfer
+	 * ownership directly to the highest priority waiting thread, true to just unblock this thread and let it compete
+	 * for the mutex with other threads, default - false
 	 */
 
-	explicit Mutex(Type type = Type::Normal, Protocol protocol = Protocol::None, uint8_t priorityCeiling = {});
+	explicit Mutex(Type type = Type::Normal, Protocol protocol = Protocol::None, uint8_t priorityCeiling = {},
+			bool competitive = {});
 
 	/**
 	 * \brief Locks the mutex.
@@ -231,7 +243,7 @@ public:
 	 * The mutex must be locked by the current thread, otherwise, the behavior is undefined. If there are threads
 	 * blocked on this mutex, the highest priority waiting thread shall be unblocked, and if there is more than one
 	 * highest priority thread blocked waiting, then the highest priority thread that has been waiting the longest shall
-	 * be unblocked.
+	 * be unblocked. Unless the mutex is in competitive mode, the unblocked thread becomes the new owner of the mutex.
 	 *
 	 * \return zero if the caller successfully unlocked the mutex, error code otherwise:
 	 * - EPERM - the mutex type is ErrorChecking or Recursive, and the current thread does not own the mutex;
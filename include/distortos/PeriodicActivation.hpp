@@ -0,0 +1,217 @@
+/**
+ * \file
+ * \brief PeriodicActivation class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-22
+ */
+
+#ifndef INCLUDE_DISTORTOS_PERIODICACTIVATION_HPP_
+#define INCLUDE_DISTORTOS_PERIODICACTIVATION_HPP_
+
+#include "distortos/HighResolutionClock.hpp"
+#include "distortos/ThisThread.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief PeriodicActivation class tracks releases of periodic thread.
+ *
+ * Object of this class is attached to a thread with ThisThread::startPeriodic(). Releases of the thread are scheduled
+ * at absolute time points (first release + n * period), so there is no drift. Each call to
+ * ThisThread::waitForNextPeriod() ends current activation of the thread and waits for the next release. During this
+ * call the activation is checked for missed deadline (activation ended at or after "release + deadline") and for
+ * overrun (activation ended at or after next release). Releases which were missed due to overrun are skipped and
+ * counted as overruns. Release latency (difference between scheduled release time point and the moment when the thread
+ * actually started running) is measured with HighResolutionClock.
+ */
+
+class PeriodicActivation
+{
+	friend int ThisThread::startPeriodic(PeriodicActivation&, TickClock::time_point);
+	friend int ThisThread::waitForNextPeriod();
+
+public:
+
+	/**
+	 * \brief Type of function executed by periodic thread when overrun is detected.
+	 *
+	 * The function is executed in the context of periodic thread, from ThisThread::waitForNextPeriod(). It may for
+	 * example send a signal to some supervising thread.
+	 *
+	 * \param [in] periodicActivation is a reference to PeriodicActivation object in which overrun was detected
+	 */
+
+	using OverrunHook = void(*)(PeriodicActivation& periodicActivation);
+
+	/**
+	 * \brief PeriodicActivation's constructor
+	 *
+	 * \param [in] period is the period of releases
+	 * \param [in] deadline is the relative deadline of each activation, zero to use \a period as deadline
+	 * \param [in] overrunHook is the function executed when overrun is detected, nullptr to disable
+	 */
+
+	constexpr explicit PeriodicActivation(const TickClock::duration period, const TickClock::duration deadline = {},
+			const OverrunHook overrunHook = {}) :
+			period_{period},
+			deadline_{deadline != TickClock::duration{} ? deadline : period},
+			releaseTimePoint_{},
+			minimumReleaseLatency_{HighResolutionClock::duration::max()},
+			maximumReleaseLatency_{},
+			totalReleaseLatency_{},
+			activationCount_{},
+			missedDeadlineCount_{},
+			overrunCount_{},
+			overrunHook_{overrunHook}
+	{
+
+	}
+
+	/**
+	 * \return number of activations (releases which were not skipped)
+	 */
+
+	uint64_t getActivationCount() const
+	{
+		return activationCount_;
+	}
+
+	/**
+	 * \return average release latency, zero if there were no activations yet
+	 */
+
+	HighResolutionClock::duration getAverageReleaseLatency() const
+	{
+		return activationCount_ != 0 ? totalReleaseLatency_ / activationCount_ : HighResolutionClock::duration{};
+	}
+
+	/**
+	 * \return relative deadline of each activation
+	 */
+
+	TickClock::duration getDeadline() const
+	{
+		return deadline_;
+	}
+
+	/**
+	 * \return maximum release latency, zero if there were no activations yet
+	 */
+
+	HighResolutionClock::duration getMaximumReleaseLatency() const
+	{
+		return maximumReleaseLatency_;
+	}
+
+	/**
+	 * \return minimum release latency, zero if there were no activations yet
+	 */
+
+	HighResolutionClock::duration getMinimumReleaseLatency() const
+	{
+		return activationCount_ != 0 ? minimumReleaseLatency_ : HighResolutionClock::duration{};
+	}
+
+	/**
+	 * \return number of activations which ended at or after their deadline
+	 */
+
+	uint64_t getMissedDeadlineCount() const
+	{
+		return missedDeadlineCount_;
+	}
+
+	/**
+	 * \return number of releases which were skipped, because previous activation ended after them
+	 */
+
+	uint64_t getOverrunCount() const
+	{
+		return overrunCount_;
+	}
+
+	/**
+	 * \return period of releases
+	 */
+
+	TickClock::duration getPeriod() const
+	{
+		return period_;
+	}
+
+	/**
+	 * \return time point of release of current activation (or of first release, if there were no activations yet)
+	 */
+
+	TickClock::time_point getReleaseTimePoint() const
+	{
+		return activationCount_ != 0 ? releaseTimePoint_ : releaseTimePoint_ + period_;
+	}
+
+	PeriodicActivation(const PeriodicActivation&) = delete;
+	PeriodicActivation(PeriodicActivation&&) = delete;
+	const PeriodicActivation& operator=(const PeriodicActivation&) = delete;
+	PeriodicActivation& operator=(PeriodicActivation&&) = delete;
+
+private:
+
+	/**
+	 * \brief Prepares the object for first release.
+	 *
+	 * Clears all counters and statistics.
+	 *
+	 * \param [in] firstRelease is the time point of first release
+	 */
+
+	void start(TickClock::time_point firstRelease);
+
+	/**
+	 * \brief Ends current activation and waits for next release.
+	 *
+	 * Checks current activation for missed deadline and overrun, skips missed releases (executing overrun hook if it
+	 * is set), sleeps until next release and updates release latency statistics.
+	 */
+
+	void waitForNextPeriod();
+
+	/// period of releases
+	TickClock::duration period_;
+
+	/// relative deadline of each activation
+	TickClock::duration deadline_;
+
+	/// time point of release of current activation, "first release - period" before first activation
+	TickClock::time_point releaseTimePoint_;
+
+	/// minimum release latency
+	HighResolutionClock::duration minimumReleaseLatency_;
+
+	/// maximum release latency
+	HighResolutionClock::duration maximumReleaseLatency_;
+
+	/// sum of release latencies of all activations
+	HighResolutionClock::duration totalReleaseLatency_;
+
+	/// number of activations
+	uint64_t activationCount_;
+
+	/// number of activations which ended at or after their deadline
+	uint64_t missedDeadlineCount_;
+
+	/// number of skipped releases
+	uint64_t overrunCount_;
+
+	/// function executed when overrun is detected, nullptr if disabled
+	OverrunHook overrunHook_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_PERIODICACTIVATION_HPP_
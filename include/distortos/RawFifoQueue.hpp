@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-01-19
+ * \date 2015-05-26
  */
 
 #ifndef INCLUDE_DISTORTOS_RAWFIFOQUEUE_HPP_
@@ -19,11 +19,15 @@
 namespace distortos
 {
 
+class WaitSet;
+
 /// RawFifoQueue class is very similar to FifoQueue, but optimized for binary serializable types (like POD types). Type
 /// T can be used with both RawFifoQueue and FifoQueue<T> only when std::is_trivially_copyable<T>::value == true,
 /// otherwise only FifoQueue<T> use is safe, while using RawFifoQueue results in undefined behavior.
 class RawFifoQueue
 {
+	friend class WaitSet;
+
 public:
 
 	/**
@@ -137,6 +141,41 @@ public:
 		return push(&data, sizeof(data));
 	}
 
+	/**
+	 * \brief Pushes the element to the queue and hands the CPU directly to the thread which was waiting for it.
+	 *
+	 * Same as push(const void*, size_t), but the "pop" semaphore is posted with Semaphore::postAndSwitch().
+	 *
+	 * \param [in] data is a pointer to data that will be pushed to RawFifoQueue
+	 * \param [in] size is the size of \a data, bytes - must be equal to the \a elementSize attribute of RawFifoQueue
+	 *
+	 * \return zero if element was pushed successfully, error code otherwise:
+	 * - EMSGSIZE - \a size doesn't match the \a elementSize attribute of RawFifoQueue;
+	 * - error codes returned by Semaphore::wait();
+	 * - error codes returned by Semaphore::postAndSwitch();
+	 */
+
+	int pushAndSwitch(const void* data, size_t size);
+
+	/**
+	 * \brief Pushes the element to the queue and hands the CPU directly to the thread which was waiting for it.
+	 *
+	 * \param T is the type of data pushed to the queue
+	 *
+	 * \param [in] data is a reference to data that will be pushed to RawFifoQueue
+	 *
+	 * \return zero if element was pushed successfully, error code otherwise:
+	 * - EMSGSIZE - sizeof(T) doesn't match the \a elementSize attribute of RawFifoQueue;
+	 * - error codes returned by Semaphore::wait();
+	 * - error codes returned by Semaphore::postAndSwitch();
+	 */
+
+	template<typename T>
+	int pushAndSwitch(const T& data)
+	{
+		return pushAndSwitch(&data, sizeof(data));
+	}
+
 	/**
 	 * \brief Tries to pop the oldest (first) element from the queue.
 	 *
@@ -471,6 +510,8 @@ private:
 	 * \param [in] waitSemaphoreFunctor is a reference to SemaphoreFunctor which will be executed with \a pushSemaphore_
 	 * \param [in] data is a pointer to data that will be pushed to RawFifoQueue
 	 * \param [in] size is the size of \a data, bytes - must be equal to the \a elementSize attribute of RawFifoQueue
+	 * \param [in] switchToUnblocked selects whether the CPU is handed directly to the thread which was waiting for the
+	 * element (true) or not (false), default - false
 	 *
 	 * \return zero if element was pushed successfully, error code otherwise:
 	 * - EMSGSIZE - \a size doesn't match the \a elementSize attribute of RawFifoQueue;
@@ -478,7 +519,8 @@ private:
 	 * - error codes returned by Semaphore::post();
 	 */
 
-	int pushInternal(const synchronization::SemaphoreFunctor& waitSemaphoreFunctor, const void* data, size_t size);
+	int pushInternal(const synchronization::SemaphoreFunctor& waitSemaphoreFunctor, const void* data, size_t size,
+			bool switchToUnblocked = false);
 
 	/// contained synchronization::FifoQueueBase object which implements base functionality
 	synchronization::FifoQueueBase fifoQueueBase_;
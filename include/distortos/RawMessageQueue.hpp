@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-01-18
+ * \date 2015-05-16
  */
 
 #ifndef INCLUDE_DISTORTOS_RAWMESSAGEQUEUE_HPP_
@@ -19,6 +19,8 @@
 namespace distortos
 {
 
+class WaitSet;
+
 /**
  * \brief RawMessageQueue class is very similar to MessageQueue, but optimized for binary serializable types (like POD
  * types). Type T can be used with both RawMessageQueue and MessageQueue<T> only when
@@ -30,6 +32,8 @@ namespace distortos
 
 class RawMessageQueue
 {
+	friend class WaitSet;
+
 public:
 
 	/// type of uninitialized storage for Entry with link
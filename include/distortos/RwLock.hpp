@@ -0,0 +1,426 @@
+/**
+ * \file
+ * \brief RwLock class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#ifndef INCLUDE_DISTORTOS_RWLOCK_HPP_
+#define INCLUDE_DISTORTOS_RWLOCK_HPP_
+
+#include "distortos/synchronization/MutexControlBlock.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief RwLock is a reader-writer lock - synchronization primitive which can be locked in shared mode (by many threads
+ * at once) or in exclusive mode (by one thread)
+ *
+ * Similar to std::shared_timed_mutex - http://en.cppreference.com/w/cpp/thread/shared_timed_mutex
+ * Similar to POSIX pthread_rwlock_t -
+ * http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_rdlock.html
+ *
+ * Exclusive ownership is implemented with synchronization::MutexControlBlock, so threads waiting for exclusive lock are
+ * kept in priority order and the selected priority protocol (priority inheritance or priority protection) applies to
+ * the thread that owns (or is about to own) the lock in exclusive mode. Threads waiting for shared lock are also kept in
+ * priority order, but priority protocols don't apply to them.
+ */
+
+class RwLock
+{
+public:
+
+	/// priority protocols of exclusive lock
+	using Protocol = synchronization::MutexControlBlock::Protocol;
+
+	/// type used for counting shared locks
+	using ReadersCount = uint16_t;
+
+	/// preference of RwLock when both readers and writers are waiting
+	enum class Preference : uint8_t
+	{
+		/// writers are preferred - shared lock is not granted when any thread owns or waits for exclusive lock, similar
+		/// to PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP
+		Writers,
+		/// readers are preferred - shared lock is granted as long as exclusive lock is not actually held, similar to
+		/// PTHREAD_RWLOCK_PREFER_READER_NP
+		Readers,
+	};
+
+	/**
+	 * \brief Gets the maximum number of shared locks possible before returning EAGAIN
+	 *
+	 * \return maximum number of shared locks possible before returning EAGAIN
+	 */
+
+	constexpr static ReadersCount getMaxReaders()
+	{
+		return std::numeric_limits<ReadersCount>::max();
+	}
+
+	/**
+	 * \brief RwLock constructor
+	 *
+	 * Similar to std::shared_timed_mutex::shared_timed_mutex() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/shared_timed_mutex
+	 * Similar to pthread_rwlock_init() -
+	 * http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_init.html
+	 *
+	 * \param [in] preference is the preference of RwLock, default - Preference::Writers
+	 * \param [in] protocol is the priority protocol of exclusive lock, default - Protocol::None
+	 * \param [in] priorityCeiling is the priority ceiling of exclusive lock, ignored when
+	 * protocol != Protocol::PriorityProtect, default - 0
+	 */
+
+	explicit RwLock(Preference preference = Preference::Writers, Protocol protocol = Protocol::None,
+			uint8_t priorityCeiling = {});
+
+	/**
+	 * \brief Locks the RwLock in exclusive mode.
+	 *
+	 * Similar to std::shared_timed_mutex::lock() - http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/lock
+	 * Similar to pthread_rwlock_wrlock() -
+	 * http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_wrlock.html
+	 *
+	 * If the RwLock is locked (in any mode) by another thread, the calling thread shall block until the lock becomes
+	 * available. The calling thread first becomes the owner of internal exclusive lock (waiting behind other writers if
+	 * necessary) and then waits until all current readers unlock the RwLock.
+	 *
+	 * \return zero if the caller successfully locked the RwLock, error code otherwise:
+	 * - EDEADLK - the current thread already owns the RwLock in exclusive mode;
+	 * - EINVAL - the RwLock was created with the protocol attribute having the value PriorityProtect and the calling
+	 * thread's priority is higher than the RwLock's current priority ceiling;
+	 */
+
+	int lock();
+
+	/**
+	 * \brief Locks the RwLock in shared mode.
+	 *
+	 * Similar to std::shared_timed_mutex::lock_shared() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/lock_shared
+	 * Similar to pthread_rwlock_rdlock() -
+	 * http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_rdlock.html
+	 *
+	 * If the RwLock is locked in exclusive mode (or - for Preference::Writers - some thread waits for exclusive lock),
+	 * the calling thread shall block until shared lock is granted.
+	 *
+	 * \warning With Preference::Writers, recursive shared locking may deadlock if another thread waits for exclusive
+	 * lock.
+	 *
+	 * \return zero if the caller successfully locked the RwLock, error code otherwise:
+	 * - EAGAIN - the RwLock could not be acquired because the maximum number of shared locks has been exceeded;
+	 * - EDEADLK - the current thread already owns the RwLock in exclusive mode;
+	 */
+
+	int lockShared();
+
+	/**
+	 * \brief Tries to lock the RwLock in exclusive mode.
+	 *
+	 * Similar to std::shared_timed_mutex::try_lock() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/try_lock
+	 * Similar to pthread_rwlock_trywrlock() -
+	 * http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_trywrlock.html
+	 *
+	 * This function shall be equivalent to lock(), except that if the RwLock is currently locked in any mode (by any
+	 * thread, including the current thread), the call shall return immediately.
+	 *
+	 * \return zero if the caller successfully locked the RwLock, error code otherwise:
+	 * - EBUSY - the RwLock could not be acquired because it was already locked;
+	 * - EINVAL - the RwLock was created with the protocol attribute having the value PriorityProtect and the calling
+	 * thread's priority is higher than the RwLock's current priority ceiling;
+	 */
+
+	int tryLock();
+
+	/**
+	 * \brief Tries to lock the RwLock in exclusive mode for given duration of time.
+	 *
+	 * Similar to std::shared_timed_mutex::try_lock_for() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/try_lock_for
+	 * Similar to pthread_rwlock_timedwrlock() -
+	 * http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_timedwrlock.html
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated without locking the RwLock
+	 *
+	 * \return zero if the caller successfully locked the RwLock, error code otherwise:
+	 * - EDEADLK - the current thread already owns the RwLock in exclusive mode;
+	 * - EINVAL - the RwLock was created with the protocol attribute having the value PriorityProtect and the calling
+	 * thread's priority is higher than the RwLock's current priority ceiling;
+	 * - ETIMEDOUT - the RwLock could not be locked before the specified timeout expired;
+	 */
+
+	int tryLockFor(TickClock::duration duration);
+
+	/**
+	 * \brief Tries to lock the RwLock in exclusive mode for given duration of time.
+	 *
+	 * Template variant of tryLockFor(TickClock::duration duration).
+	 *
+	 * \param Rep is type of tick counter
+	 * \param Period is std::ratio type representing the tick period of the clock, in seconds
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated without locking the RwLock
+	 *
+	 * \return zero if the caller successfully locked the RwLock, error code otherwise:
+	 * - EDEADLK - the current thread already owns the RwLock in exclusive mode;
+	 * - EINVAL - the RwLock was created with the protocol attribute having the value PriorityProtect and the calling
+	 * thread's priority is higher than the RwLock's current priority ceiling;
+	 * - ETIMEDOUT - the RwLock could not be locked before the specified timeout expired;
+	 */
+
+	template<typename Rep, typename Period>
+	int tryLockFor(const std::chrono::duration<Rep, Period> duration)
+	{
+		return tryLockFor(std::chrono::duration_cast<TickClock::duration>(duration));
+	}
+
+	/**
+	 * \brief Tries to lock the RwLock in shared mode.
+	 *
+	 * Similar to std::shared_timed_mutex::try_lock_shared() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/try_lock_shared
+	 * Similar to pthread_rwlock_tryrdlock() -
+	 * http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_tryrdlock.html
+	 *
+	 * This function shall be equivalent to lockShared(), except that if shared lock cannot be granted immediately, the
+	 * call shall return immediately.
+	 *
+	 * \return zero if the caller successfully locked the RwLock, error code otherwise:
+	 * - EAGAIN - the RwLock could not be acquired because the maximum number of shared locks has been exceeded;
+	 * - EBUSY - the RwLock could not be acquired because it was locked in exclusive mode (or - for
+	 * Preference::Writers - some thread waits for exclusive lock);
+	 */
+
+	int tryLockShared();
+
+	/**
+	 * \brief Tries to lock the RwLock in shared mode for given duration of time.
+	 *
+	 * Similar to std::shared_timed_mutex::try_lock_shared_for() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/try_lock_shared_for
+	 * Similar to pthread_rwlock_timedrdlock() -
+	 * http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_timedrdlock.html
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated without locking the RwLock
+	 *
+	 * \return zero if the caller successfully locked the RwLock, error code otherwise:
+	 * - EAGAIN - the RwLock could not be acquired because the maximum number of shared locks has been exceeded;
+	 * - EDEADLK - the current thread already owns the RwLock in exclusive mode;
+	 * - ETIMEDOUT - the RwLock could not be locked before the specified timeout expired;
+	 */
+
+	int tryLockSharedFor(TickClock::duration duration);
+
+	/**
+	 * \brief Tries to lock the RwLock in shared mode for given duration of time.
+	 *
+	 * Template variant of tryLockSharedFor(TickClock::duration duration).
+	 *
+	 * \param Rep is type of tick counter
+	 * \param Period is std::ratio type representing the tick period of the clock, in seconds
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated without locking the RwLock
+	 *
+	 * \return zero if the caller successfully locked the RwLock, error code otherwise:
+	 * - EAGAIN - the RwLock could not be acquired because the maximum number of shared locks has been exceeded;
+	 * - EDEADLK - the current thread already owns the RwLock in exclusive mode;
+	 * - ETIMEDOUT - the RwLock could not be locked before the specified timeout expired;
+	 */
+
+	template<typename Rep, typename Period>
+	int tryLockSharedFor(const std::chrono::duration<Rep, Period> duration)
+	{
+		return tryLockSharedFor(std::chrono::duration_cast<TickClock::duration>(duration));
+	}
+
+	/**
+	 * \brief Tries to lock the RwLock in shared mode until given time point.
+	 *
+	 * Similar to std::shared_timed_mutex::try_lock_shared_until() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/try_lock_shared_until
+	 * Similar to pthread_rwlock_timedrdlock() -
+	 * http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_timedrdlock.html
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated without locking the RwLock
+	 *
+	 * \return zero if the caller successfully locked the RwLock, error code otherwise:
+	 * - EAGAIN - the RwLock could not be acquired because the maximum number of shared locks has been exceeded;
+	 * - EDEADLK - the current thread already owns the RwLock in exclusive mode;
+	 * - ETIMEDOUT - the RwLock could not be locked before the specified timeout expired;
+	 */
+
+	int tryLockSharedUntil(TickClock::time_point timePoint);
+
+	/**
+	 * \brief Tries to lock the RwLock in shared mode until given time point.
+	 *
+	 * Template variant of tryLockSharedUntil(TickClock::time_point timePoint).
+	 *
+	 * \param Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated without locking the RwLock
+	 *
+	 * \return zero if the caller successfully locked the RwLock, error code otherwise:
+	 * - EAGAIN - the RwLock could not be acquired because the maximum number of shared locks has been exceeded;
+	 * - EDEADLK - the current thread already owns the RwLock in exclusive mode;
+	 * - ETIMEDOUT - the RwLock could not be locked before the specified timeout expired;
+	 */
+
+	template<typename Duration>
+	int tryLockSharedUntil(const std::chrono::time_point<TickClock, Duration> timePoint)
+	{
+		return tryLockSharedUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint));
+	}
+
+	/**
+	 * \brief Tries to lock the RwLock in exclusive mode until given time point.
+	 *
+	 * Similar to std::shared_timed_mutex::try_lock_until() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/try_lock_until
+	 * Similar to pthread_rwlock_timedwrlock() -
+	 * http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_timedwrlock.html
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated without locking the RwLock
+	 *
+	 * \return zero if the caller successfully locked the RwLock, error code otherwise:
+	 * - EDEADLK - the current thread already owns the RwLock in exclusive mode;
+	 * - EINVAL - the RwLock was created with the protocol attribute having the value PriorityProtect and the calling
+	 * thread's priority is higher than the RwLock's current priority ceiling;
+	 * - ETIMEDOUT - the RwLock could not be locked before the specified timeout expired;
+	 */
+
+	int tryLockUntil(TickClock::time_point timePoint);
+
+	/**
+	 * \brief Tries to lock the RwLock in exclusive mode until given time point.
+	 *
+	 * Template variant of tryLockUntil(TickClock::time_point timePoint).
+	 *
+	 * \param Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated without locking the RwLock
+	 *
+	 * \return zero if the caller successfully locked the RwLock, error code otherwise:
+	 * - EDEADLK - the current thread already owns the RwLock in exclusive mode;
+	 * - EINVAL - the RwLock was created with the protocol attribute having the value PriorityProtect and the calling
+	 * thread's priority is higher than the RwLock's current priority ceiling;
+	 * - ETIMEDOUT - the RwLock could not be locked before the specified timeout expired;
+	 */
+
+	template<typename Duration>
+	int tryLockUntil(const std::chrono::time_point<TickClock, Duration> timePoint)
+	{
+		return tryLockUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint));
+	}
+
+	/**
+	 * \brief Unlocks the RwLock locked in exclusive mode.
+	 *
+	 * Similar to std::shared_timed_mutex::unlock() - http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/unlock
+	 * Similar to pthread_rwlock_unlock() -
+	 * http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_unlock.html
+	 *
+	 * With Preference::Writers the exclusive lock is transferred to the highest priority waiting writer (if any),
+	 * otherwise all waiting readers are granted shared lock. With Preference::Readers all waiting readers are granted
+	 * shared lock first. Waiting readers are granted shared lock only up to getMaxReaders(), remaining ones stay blocked
+	 * until some other reader calls unlockShared().
+	 *
+	 * \return zero if the caller successfully unlocked the RwLock, error code otherwise:
+	 * - EPERM - the current thread does not own the RwLock in exclusive mode;
+	 */
+
+	int unlock();
+
+	/**
+	 * \brief Unlocks the RwLock locked in shared mode.
+	 *
+	 * Similar to std::shared_timed_mutex::unlock_shared() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/unlock_shared
+	 * Similar to pthread_rwlock_unlock() -
+	 * http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_unlock.html
+	 *
+	 * If this was the last shared lock and some writer waits for the readers to leave, the RwLock is transferred to this
+	 * writer. If some readers remain blocked because the maximum number of shared locks was reached, the highest
+	 * priority one of them is granted shared lock instead.
+	 *
+	 * The RwLock must be locked in shared mode by the current thread, otherwise, the behavior is undefined - owners of
+	 * shared locks are not tracked, so unlocking by a thread which doesn't hold the shared lock releases the shared lock
+	 * of some other reader and may grant exclusive lock to a writer while that reader is still inside.
+	 *
+	 * \return zero if the caller successfully unlocked the RwLock, error code otherwise:
+	 * - EPERM - the RwLock is not locked in shared mode;
+	 */
+
+	int unlockShared();
+
+private:
+
+	/**
+	 * \brief Releases exclusive ownership of \a writerControlBlock_ and grants shared lock to waiting readers if
+	 * allowed by selected preference.
+	 *
+	 * \attention This function must be called with interrupt masking enabled by the owner of \a writerControlBlock_.
+	 */
+
+	void releaseExclusive();
+
+	/**
+	 * \brief Internal version of tryLock().
+	 *
+	 * Internal version with no interrupt masking and additional code for detection of deadlock (which is not required
+	 * for tryLock()).
+	 *
+	 * \return zero if the caller successfully locked the RwLock, error code otherwise:
+	 * - EBUSY - the RwLock could not be acquired because it was already locked;
+	 * - EDEADLK - the current thread already owns the RwLock in exclusive mode;
+	 * - EINVAL - the RwLock was created with the protocol attribute having the value PriorityProtect and the calling
+	 * thread's priority is higher than the RwLock's current priority ceiling;
+	 */
+
+	int tryLockInternal();
+
+	/**
+	 * \brief Internal version of tryLockShared().
+	 *
+	 * Internal version with no interrupt masking and additional code for detection of deadlock (which is not required
+	 * for tryLockShared()).
+	 *
+	 * \return zero if the caller successfully locked the RwLock, error code otherwise:
+	 * - EAGAIN - the RwLock could not be acquired because the maximum number of shared locks has been exceeded;
+	 * - EBUSY - shared lock cannot be granted immediately;
+	 * - EDEADLK - the current thread already owns the RwLock in exclusive mode;
+	 */
+
+	int tryLockSharedInternal();
+
+	/// control block of exclusive lock - it is owned by the writer which holds the RwLock or waits for readers to leave
+	synchronization::MutexControlBlock writerControlBlock_;
+
+	/// ThreadControlBlock objects waiting for shared lock
+	scheduler::ThreadControlBlockList readersBlockedList_;
+
+	/// ThreadControlBlock object (owner of \a writerControlBlock_) waiting for current readers to leave
+	scheduler::ThreadControlBlockList writerBlockedList_;
+
+	/// number of granted shared locks
+	ReadersCount readersCount_;
+
+	/// preference of RwLock
+	Preference preference_;
+
+	/// true if RwLock is locked in exclusive mode, false otherwise
+	bool writerActive_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_RWLOCK_HPP_
@@ -0,0 +1,294 @@
+/**
+ * \file
+ * \brief ScheduleTable class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#ifndef INCLUDE_DISTORTOS_SCHEDULETABLE_HPP_
+#define INCLUDE_DISTORTOS_SCHEDULETABLE_HPP_
+
+#include "distortos/TickClock.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace distortos
+{
+
+class Semaphore;
+
+namespace scheduler
+{
+
+class Scheduler;
+
+}	// namespace scheduler
+
+/**
+ * \brief ScheduleTable class implements time-triggered (table-driven) scheduling.
+ *
+ * Schedule table is a constant array of entries, each with an offset in the major frame. When the table is started,
+ * the entries are processed in tick interrupt (before software timers and timeouts) at "start of frame + offset" time
+ * points, and the table is repeated infinitely with the period of major frame. Each entry either releases a thread
+ * (by posting a Semaphore on which that thread waits) or executes a function in interrupt context.
+ *
+ * Time-triggered threads should have the highest priorities in the system - event-driven threads with lower
+ * priorities run in the slack.
+ *
+ * Entries which missed their time point (because the table was started with a time point in the past) are not
+ * executed late - they are skipped and counted (see getOverrunCount()), so the time spent in tick interrupt is bounded
+ * by the number of entries in the table.
+ *
+ * Only one ScheduleTable may be active at a time.
+ */
+
+class ScheduleTable
+{
+	friend class scheduler::Scheduler;
+
+public:
+
+	/// single entry of schedule table
+	class Entry
+	{
+		friend class ScheduleTable;
+
+	public:
+
+		/// type of function executed by entry
+		using Function = void(*)();
+
+		/**
+		 * \brief Entry's constructor which releases a thread
+		 *
+		 * \param [in] offset is the offset of entry in the major frame
+		 * \param [in] semaphore is a reference to Semaphore which will be posted, it must outlive ScheduleTable
+		 */
+
+		constexpr Entry(const TickClock::duration offset, Semaphore& semaphore) :
+				offset_{offset},
+				semaphore_{&semaphore},
+				function_{}
+		{
+
+		}
+
+		/**
+		 * \brief Entry's constructor which executes a function
+		 *
+		 * \param [in] offset is the offset of entry in the major frame
+		 * \param [in] function is the function which will be executed from interrupt context
+		 */
+
+		constexpr Entry(const TickClock::duration offset, const Function function) :
+				offset_{offset},
+				semaphore_{},
+				function_{function}
+		{
+
+		}
+
+		/**
+		 * \return offset of entry in the major frame
+		 */
+
+		constexpr TickClock::duration getOffset() const
+		{
+			return offset_;
+		}
+
+	private:
+
+		/**
+		 * \brief Executes the entry - posts the semaphore or executes the function.
+		 */
+
+		void execute() const;
+
+		/// offset of entry in the major frame
+		TickClock::duration offset_;
+
+		/// pointer to Semaphore which is posted, nullptr if entry executes a function
+		Semaphore* semaphore_;
+
+		/// function which is executed, nullptr if entry posts a semaphore
+		Function function_;
+	};
+
+	/**
+	 * \brief ScheduleTable's constructor
+	 *
+	 * \param N is the number of entries in the table
+	 *
+	 * \param [in] entries is a reference to array with entries, sorted by offset in ascending order, each offset must
+	 * be less than \a majorFrame
+	 * \param [in] majorFrame is the duration of major frame - period of the whole table
+	 */
+
+	template<size_t N>
+	constexpr ScheduleTable(const Entry (&entries)[N], const TickClock::duration majorFrame) :
+			entries_{entries},
+			size_{N},
+			majorFrame_{majorFrame},
+			frameTimePoint_{},
+			index_{},
+			overrunCount_{}
+	{
+
+	}
+
+	/**
+	 * \brief Checks whether the table is valid.
+	 *
+	 * Table built from constexpr array of entries can be validated at compile time:
+	 * `static_assert(ScheduleTable::isValid(entries, majorFrame) == true, "...");`. The same check is done at run time
+	 * by start().
+	 *
+	 * \param N is the number of entries in the table
+	 *
+	 * \param [in] entries is a reference to array with entries
+	 * \param [in] majorFrame is the duration of major frame
+	 *
+	 * \return true if major frame is positive, entries are sorted by offset in ascending order and offset of each entry
+	 * is within major frame, false otherwise
+	 */
+
+	template<size_t N>
+	constexpr static bool isValid(const Entry (&entries)[N], const TickClock::duration majorFrame)
+	{
+		return isValid(entries, N, majorFrame);
+	}
+
+	/**
+	 * \brief ScheduleTable's destructor
+	 *
+	 * Stops the table if it is active.
+	 */
+
+	~ScheduleTable();
+
+	/**
+	 * \return duration of major frame
+	 */
+
+	TickClock::duration getMajorFrame() const
+	{
+		return majorFrame_;
+	}
+
+	/**
+	 * \return number of entries which were skipped because their time point was missed, reset to 0 when the table is
+	 * started
+	 */
+
+	uint32_t getOverrunCount() const
+	{
+		return overrunCount_;
+	}
+
+	/**
+	 * \return true if the table is active, false otherwise
+	 */
+
+	bool isActive() const;
+
+	/**
+	 * \brief Starts the table.
+	 *
+	 * \param [in] timePoint is the time point at which first major frame starts, if it is in the past, entries which
+	 * missed their time points are skipped and counted (see getOverrunCount())
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBUSY - some ScheduleTable is already active;
+	 * - EINVAL - major frame is not positive, table is empty, entries are not sorted or offset of some entry is not
+	 * within major frame;
+	 */
+
+	int start(TickClock::time_point timePoint);
+
+	/**
+	 * \brief Starts the table with first major frame starting in the next tick.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by start(TickClock::time_point);
+	 */
+
+	int start();
+
+	/**
+	 * \brief Stops the table.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - this table is not active;
+	 */
+
+	int stop();
+
+	ScheduleTable(const ScheduleTable&) = delete;
+	ScheduleTable(ScheduleTable&&) = delete;
+	const ScheduleTable& operator=(const ScheduleTable&) = delete;
+	ScheduleTable& operator=(ScheduleTable&&) = delete;
+
+private:
+
+	/**
+	 * \brief Checks whether the table is valid.
+	 *
+	 * \param [in] entries is a pointer to array with entries
+	 * \param [in] size is the number of elements in \a entries array
+	 * \param [in] majorFrame is the duration of major frame
+	 * \param [in] index is the index of first entry which will be checked, default - 0
+	 *
+	 * \return true if major frame is positive, table is not empty, entries starting from \a index are sorted by offset
+	 * in ascending order and offset of each of them is within major frame, false otherwise
+	 */
+
+	constexpr static bool isValid(const Entry* const entries, const size_t size, const TickClock::duration majorFrame,
+			const size_t index = {})
+	{
+		return majorFrame > TickClock::duration{} && size != 0 && (index == size ||
+				(entries[index].getOffset() >= TickClock::duration{} && entries[index].getOffset() < majorFrame &&
+				(index == 0 || entries[index - 1].getOffset() <= entries[index].getOffset()) &&
+				isValid(entries, size, majorFrame, index + 1) == true));
+	}
+
+	/**
+	 * \brief Handler of "tick" interrupt - executes all entries which reached their time point.
+	 *
+	 * Entries with time point earlier than \a timePoint are skipped and counted in \a overrunCount_ - whole missed major
+	 * frames are skipped at once, so at most one pass over the table is done.
+	 *
+	 * \param [in] timePoint is the current time point
+	 */
+
+	void tickInterruptHandler(TickClock::time_point timePoint);
+
+	/// pointer to array with entries
+	const Entry* entries_;
+
+	/// number of elements in \a entries_ array
+	size_t size_;
+
+	/// duration of major frame
+	TickClock::duration majorFrame_;
+
+	/// time point at which current major frame started
+	TickClock::time_point frameTimePoint_;
+
+	/// index of next entry which will be executed
+	size_t index_;
+
+	/// number of entries which were skipped because their time point was missed
+	uint32_t overrunCount_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_SCHEDULETABLE_HPP_
@@ -2,13 +2,13 @@
  * \file
  * \brief Semaphore class header
  *
- * \author Copyright (C) 2014 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-11-25
+ * \date 2015-06-04
  */
 
 #ifndef INCLUDE_DISTORTOS_SEMAPHORE_HPP_
@@ -16,17 +16,52 @@
 
 #include "distortos/scheduler/ThreadControlBlockList.hpp"
 
+#include "distortos/distortosConfiguration.h"
+
 namespace distortos
 {
 
+class WaitSet;
+
+namespace scheduler
+{
+
+class DeferredRequestQueue;
+
+}	// namespace scheduler
+
+namespace synchronization
+{
+
+class WaitSetObserver;
+
+}	// namespace synchronization
+
 /**
  * \brief Semaphore is the basic synchronization primitive
  *
  * Similar to POSIX semaphores - http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/V1_chap04.html#tag_04_16
+ *
+ * \note post() of semaphore with non-zero value and any successful tryWait() are done with lock-free fast path, without
+ * interrupt masking - the kernel is involved only when the value is zero (threads may be blocked on semaphore). If
+ * CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1, post() from interrupt context masks interrupts only when the queue of
+ * deferred requests is full - the value is incremented right away (so EOVERFLOW is detected and the new value is
+ * visible immediately) and only handing the value over to blocked threads is deferred - it is done by the scheduler
+ * before choosing next thread. The value may therefore briefly be non-zero while threads are still blocked, so posts
+ * from interrupts which are done before the scheduler processes the previous ones may return EOVERFLOW earlier than
+ * without deferral (when max value is small).
+ *
+ * \attention Even with CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1, post() may be called only from interrupts which can be
+ * masked by the kernel (priority equal to or lower than CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI). Interrupt with
+ * higher priority could increment the value after a thread checked it, but before that thread blocked - such post
+ * would be lost.
  */
 
 class Semaphore
 {
+	friend class scheduler::DeferredRequestQueue;
+	friend class WaitSet;
+
 public:
 
 	/// type used for semaphore's "value"
@@ -52,6 +87,10 @@ public:
 	 *
 	 * It is safe to destroy a semaphore upon which no threads are currently blocked. The effect of destroying a
 	 * semaphore upon which other threads are currently blocked is system error.
+	 *
+	 * \attention If CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1, the semaphore must not be destroyed while its post from
+	 * interrupt context is pending (the request is processed in the nearest context switch) - the queue of deferred
+	 * requests holds a pointer to the semaphore.
 	 */
 
 	~Semaphore();
@@ -66,7 +105,7 @@ public:
 
 	Value getValue() const
 	{
-		return value_;
+		return __atomic_load_n(&value_, __ATOMIC_RELAXED);
 	}
 
 	/**
@@ -87,6 +126,19 @@ public:
 
 	int post();
 
+	/**
+	 * \brief Unlocks the semaphore and hands the CPU directly to unblocked thread.
+	 *
+	 * Same as post(), but if a thread is unblocked and its priority is not lower than the priority of any other
+	 * runnable thread, it is selected to run immediately - before other threads with the same priority (including the
+	 * calling thread). This shortens latency of producer-consumer pipelines.
+	 *
+	 * \return zero if the calling process successfully "posted" the semaphore, error code otherwise:
+	 * - error codes returned by post();
+	 */
+
+	int postAndSwitch();
+
 	/**
 	 * \brief Tries to lock the semaphore.
 	 *
@@ -198,10 +250,62 @@ public:
 
 private:
 
+	/**
+	 * \brief Implementation of post() and postAndSwitch().
+	 *
+	 * \param [in] switchToUnblocked selects whether the CPU is handed directly to unblocked thread (true) or not (false)
+	 *
+	 * \return zero if the calling process successfully "posted" the semaphore, error code otherwise:
+	 * - EOVERFLOW - the maximum allowable value for a semaphore would be exceeded;
+	 */
+
+	int postImplementation(bool switchToUnblocked);
+
+	/**
+	 * \brief Internal version of post() and postAndSwitch() - the "slow path" which is done with interrupt masking
+	 * enabled.
+	 *
+	 * \param [in] switchToUnblocked selects whether the CPU is handed directly to unblocked thread (true) or not (false)
+	 *
+	 * \return zero if the calling process successfully "posted" the semaphore, error code otherwise:
+	 * - EOVERFLOW - the maximum allowable value for a semaphore would be exceeded;
+	 */
+
+	int postInternal(bool switchToUnblocked);
+
+#if CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+	/**
+	 * \brief Version of post() used in interrupt context.
+	 *
+	 * Lock-free version - value is incremented with atomic compare-and-swap and request to hand it over to blocked
+	 * threads (or WaitSet observers) is appended to scheduler::DeferredRequestQueue, but only if there are any. If the
+	 * queue is full, this is done right away, with interrupt masking enabled.
+	 *
+	 * \return zero if the calling process successfully "posted" the semaphore, error code otherwise:
+	 * - EOVERFLOW - the maximum allowable value for a semaphore would be exceeded;
+	 */
+
+	int postDeferred();
+
+	/**
+	 * \brief Hands the value of semaphore over to blocked threads and notifies WaitSet observers if the value is still
+	 * non-zero after that.
+	 *
+	 * \attention This function must be called with interrupt masking enabled.
+	 *
+	 * \param [in] inContextSwitch selects whether this function is called while processing deferred requests in
+	 * Scheduler::switchContext() (true - context switch is not requested) or not (false)
+	 */
+
+	void handOverValue(bool inContextSwitch);
+
+#endif	// CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
 	/**
 	 * \brief Internal version of tryWait().
 	 *
-	 * Internal version with no interrupt masking.
+	 * Lock-free version - value is decremented with atomic compare-and-swap, so interrupt masking is not required.
 	 *
 	 * \return zero if the calling process successfully performed the semaphore lock operation, error code otherwise:
 	 * - EAGAIN - semaphore was already locked, so it cannot be immediately locked by the tryWait() operation;
@@ -212,7 +316,11 @@ private:
 	/// ThreadControlBlock objects blocked on this semaphore
 	scheduler::ThreadControlBlockList blockedList_;
 
-	/// internal value of the semaphore
+	/// pointer to first element of intrusive list of WaitSet observers, nullptr if list is empty
+	synchronization::WaitSetObserver* observersList_;
+
+	/// internal value of the semaphore, modified atomically by lock-free fast paths and with interrupt masking enabled by
+	/// all other code
 	Value value_;
 
 	/// max value of the semaphore
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-04-16
+ * \date 2015-06-01
  */
 
 #ifndef INCLUDE_DISTORTOS_SIGNALSCATCHER_HPP_
@@ -38,6 +38,9 @@ public:
 	/// import Storage type alias from synchronization::SignalsCatcherControlBlock
 	using Storage = synchronization::SignalsCatcherControlBlock::Storage;
 
+	/// import IndexTable type alias from synchronization::SignalsCatcherControlBlock
+	using IndexTable = synchronization::SignalsCatcherControlBlock::IndexTable;
+
 	/**
 	 * \brief SignalsCatcher's constructor
 	 *
@@ -45,10 +48,12 @@ public:
 	 * synchronization::SignalsCatcherControlBlock::Association objects
 	 * \param [in] storageEnd is a pointer to "one past the last" element of storage for
 	 * synchronization::SignalsCatcherControlBlock::Association objects
+	 * \param [in] indexTable is a pointer to IndexTable used for constant time lookup of
+	 * synchronization::SignalsCatcherControlBlock::Association objects, nullptr to use linear search, default - nullptr
 	 */
 
-	constexpr SignalsCatcher(Storage* const storageBegin, Storage* const storageEnd) :
-			signalsCatcherControlBlock_{storageBegin, storageEnd}
+	constexpr SignalsCatcher(Storage* const storageBegin, Storage* const storageEnd, IndexTable* const indexTable = {}) :
+			signalsCatcherControlBlock_{storageBegin, storageEnd, indexTable}
 	{
 
 	}
@@ -59,11 +64,13 @@ public:
 	 * \param N is the number of elements in \a storage array
 	 *
 	 * \param [in] storage is a reference to array of Storage elements
+	 * \param [in] indexTable is a pointer to IndexTable used for constant time lookup of
+	 * synchronization::SignalsCatcherControlBlock::Association objects, nullptr to use linear search, default - nullptr
 	 */
 
 	template<size_t N>
-	constexpr explicit SignalsCatcher(Storage (& storage)[N]) :
-			SignalsCatcher{std::begin(storage), std::end(storage)}
+	constexpr explicit SignalsCatcher(Storage (& storage)[N], IndexTable* const indexTable = {}) :
+			SignalsCatcher{std::begin(storage), std::end(storage), indexTable}
 	{
 
 	}
@@ -74,11 +81,13 @@ public:
 	 * \param N is the number of elements in \a storage array
 	 *
 	 * \param [in] storage is a reference to std::array of Storage elements
+	 * \param [in] indexTable is a pointer to IndexTable used for constant time lookup of
+	 * synchronization::SignalsCatcherControlBlock::Association objects, nullptr to use linear search, default - nullptr
 	 */
 
 	template<size_t N>
-	constexpr explicit SignalsCatcher(std::array<Storage, N>& storage) :
-			SignalsCatcher{storage.begin(), storage.end()}
+	constexpr explicit SignalsCatcher(std::array<Storage, N>& storage, IndexTable* const indexTable = {}) :
+			SignalsCatcher{storage.begin(), storage.end(), indexTable}
 	{
 
 	}
@@ -2,13 +2,13 @@
  * \file
  * \brief SoftwareTimer class header
  *
- * \author Copyright (C) 2014 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-11-29
+ * \date 2015-05-18
  */
 
 #ifndef INCLUDE_DISTORTOS_SOFTWARETIMER_HPP_
@@ -47,6 +47,8 @@ public:
 
 	}
 
+	using SoftwareTimerControlBlock::getOverrunCount;
+	using SoftwareTimerControlBlock::getPeriod;
 	using SoftwareTimerControlBlock::isRunning;
 
 	using SoftwareTimerControlBlock::start;
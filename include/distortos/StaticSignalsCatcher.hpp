@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-04-16
+ * \date 2015-06-01
  */
 
 #ifndef INCLUDE_DISTORTOS_STATICSIGNALSCATCHER_HPP_
@@ -24,9 +24,12 @@ namespace distortos
  * associations.
  *
  * \param MaxAssociations is the maximum number of SignalAction associations
+ * \param DirectlyIndexed selects whether SignalAction associations are found with direct indexing in constant time
+ * (true) or with linear search (false) - direct indexing requires additional table with one byte for each signal
+ * number, default - true if \a MaxAssociations is 8 or more
  */
 
-template<size_t MaxAssociations>
+template<size_t MaxAssociations, bool DirectlyIndexed = (MaxAssociations >= 8)>
 class StaticSignalsCatcher : public SignalsCatcher
 {
 public:
@@ -47,6 +50,38 @@ private:
 	std::array<Storage, MaxAssociations> storage_;
 };
 
+/**
+ * \brief StaticSignalsCatcher class is a variant of SignalsCatcher that has automatic storage for SignalAction
+ * associations and for the table used for direct indexing of these associations.
+ *
+ * \param MaxAssociations is the maximum number of SignalAction associations
+ */
+
+template<size_t MaxAssociations>
+class StaticSignalsCatcher<MaxAssociations, true> : public SignalsCatcher
+{
+public:
+
+	/**
+	 * \brief StaticSignalsCatcher's constructor
+	 */
+
+	constexpr StaticSignalsCatcher() :
+			SignalsCatcher{storage_, &indexTable_},
+			indexTable_{}
+	{
+
+	}
+
+private:
+
+	/// storage for SignalAction associations
+	std::array<Storage, MaxAssociations> storage_;
+
+	/// table used for direct indexing of SignalAction associations
+	IndexTable indexTable_;
+};
+
 }	// namespace distortos
 
 #endif	// INCLUDE_DISTORTOS_STATICSIGNALSCATCHER_HPP_
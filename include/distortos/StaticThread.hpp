@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-04-16
+ * \date 2015-06-03
  */
 
 #ifndef INCLUDE_DISTORTOS_STATICTHREAD_HPP_
@@ -17,11 +17,14 @@
 #include "distortos/Thread.hpp"
 #include "distortos/StaticSignalsReceiver.hpp"
 
+#include <array>
+
 namespace distortos
 {
 
 /**
- * \brief StaticThread class is a templated interface for thread that has automatic storage for stack.
+ * \brief StaticThread class is a templated interface for thread that has automatic storage for stack and newlib's
+ * _reent structure.
  *
  * \param StackSize is the size of stack, bytes
  * \param CanReceiveSignals selects whether reception of signals is enabled (true) or disabled (false) for this thread
@@ -29,12 +32,14 @@ namespace distortos
  * 0 to disable queuing of signals for this thread
  * \param CaughtSignals is the max number of caught signals for this thread, relevant only if CanReceiveSignals == true,
  * 0 to disable catching of signals for this thread
+ * \param HasOwnReent selects whether the thread has its own newlib's _reent structure (true) or uses the global one,
+ * shared with other threads (false) - the latter saves RAM, but errno and stdio state are not thread-specific then
  * \param Function is the function that will be executed in separate thread
  * \param Args are the arguments for Function
  */
 
-template<size_t StackSize, bool CanReceiveSignals, size_t QueuedSignals, size_t CaughtSignals, typename Function,
-		typename... Args>
+template<size_t StackSize, bool CanReceiveSignals, size_t QueuedSignals, size_t CaughtSignals, bool HasOwnReent,
+		typename Function, typename... Args>
 class StaticThread : public Thread<Function, Args...>
 {
 public:
@@ -52,7 +57,8 @@ public:
 	 */
 
 	StaticThread(const uint8_t priority, const SchedulingPolicy schedulingPolicy, Function&& function, Args&&... args) :
-			Base{&stack_, sizeof(stack_), priority, schedulingPolicy, std::forward<Function>(function),
+			Base{&stack_, sizeof(stack_), priority, schedulingPolicy, nullptr,
+					HasOwnReent == true ? reent_.data() : nullptr, std::forward<Function>(function),
 					std::forward<Args>(args)...}
 	{
 
@@ -82,11 +88,14 @@ private:
 
 	/// stack buffer
 	typename std::aligned_storage<StackSize>::type stack_;
+
+	/// storage for newlib's _reent structure, used only if HasOwnReent == true, initialized by ThreadControlBlock
+	std::array<_reent, HasOwnReent == true ? 1 : 0> reent_;
 };
 
 /**
- * \brief StaticThread class is a templated interface for thread that has automatic storage for stack and internal
- * StaticSignalsReceiver object.
+ * \brief StaticThread class is a templated interface for thread that has automatic storage for stack, newlib's _reent
+ * structure and internal StaticSignalsReceiver object.
  *
  * Specialization for threads with enabled reception of signals (CanReceiveSignals == true)
  *
@@ -95,12 +104,16 @@ private:
  * thread
  * \param CaughtSignals is the max number of caught signals for this thread, 0 to disable catching of signals for this
  * thread
+ * \param HasOwnReent selects whether the thread has its own newlib's _reent structure (true) or uses the global one,
+ * shared with other threads (false) - the latter saves RAM, but errno and stdio state are not thread-specific then
  * \param Function is the function that will be executed in separate thread
  * \param Args are the arguments for Function
  */
 
-template<size_t StackSize, size_t QueuedSignals, size_t CaughtSignals, typename Function, typename... Args>
-class StaticThread<StackSize, true, QueuedSignals, CaughtSignals, Function, Args...> : public Thread<Function, Args...>
+template<size_t StackSize, size_t QueuedSignals, size_t CaughtSignals, bool HasOwnReent, typename Function,
+		typename... Args>
+class StaticThread<StackSize, true, QueuedSignals, CaughtSignals, HasOwnReent, Function, Args...> :
+		public Thread<Function, Args...>
 {
 public:
 
@@ -118,7 +131,8 @@ public:
 
 	StaticThread(const uint8_t priority, const SchedulingPolicy schedulingPolicy, Function&& function, Args&&... args) :
 			Base{&stack_, sizeof(stack_), priority, schedulingPolicy, &staticSignalsReceiver_,
-					std::forward<Function>(function), std::forward<Args>(args)...},
+					HasOwnReent == true ? reent_.data() : nullptr, std::forward<Function>(function),
+					std::forward<Args>(args)...},
 			staticSignalsReceiver_{}
 	{
 
@@ -149,6 +163,9 @@ private:
 	/// stack buffer
 	typename std::aligned_storage<StackSize>::type stack_;
 
+	/// storage for newlib's _reent structure, used only if HasOwnReent == true, initialized by ThreadControlBlock
+	std::array<_reent, HasOwnReent == true ? 1 : 0> reent_;
+
 	/// internal StaticSignalsReceiver object
 	StaticSignalsReceiver<QueuedSignals, CaughtSignals> staticSignalsReceiver_;
 };
@@ -162,6 +179,8 @@ private:
  * 0 to disable queuing of signals for this thread
  * \param CaughtSignals is the max number of caught signals for this thread, relevant only if CanReceiveSignals == true,
  * 0 to disable catching of signals for this thread
+ * \param HasOwnReent selects whether the thread has its own newlib's _reent structure (true) or uses the global one,
+ * shared with other threads (false) - the latter saves RAM, but errno and stdio state are not thread-specific then
  * \param Function is the function that will be executed
  * \param Args are the arguments for Function
  *
@@ -174,8 +193,8 @@ private:
  */
 
 template<size_t StackSize, bool CanReceiveSignals = {}, size_t QueuedSignals = {}, size_t CaughtSignals = {},
-		typename Function, typename... Args>
-StaticThread<StackSize, CanReceiveSignals, QueuedSignals, CaughtSignals, Function, Args...>
+		bool HasOwnReent = true, typename Function, typename... Args>
+StaticThread<StackSize, CanReceiveSignals, QueuedSignals, CaughtSignals, HasOwnReent, Function, Args...>
 makeStaticThread(const uint8_t priority, const SchedulingPolicy schedulingPolicy, Function&& function, Args&&... args)
 {
 	return {priority, schedulingPolicy, std::forward<Function>(function), std::forward<Args>(args)...};
@@ -190,6 +209,8 @@ makeStaticThread(const uint8_t priority, const SchedulingPolicy schedulingPolicy
  * 0 to disable queuing of signals for this thread
  * \param CaughtSignals is the max number of caught signals for this thread, relevant only if CanReceiveSignals == true,
  * 0 to disable catching of signals for this thread
+ * \param HasOwnReent selects whether the thread has its own newlib's _reent structure (true) or uses the global one,
+ * shared with other threads (false) - the latter saves RAM, but errno and stdio state are not thread-specific then
  * \param Function is the function that will be executed
  * \param Args are the arguments for Function
  *
@@ -201,8 +222,8 @@ makeStaticThread(const uint8_t priority, const SchedulingPolicy schedulingPolicy
  */
 
 template<size_t StackSize, bool CanReceiveSignals = {}, size_t QueuedSignals = {}, size_t CaughtSignals = {},
-		typename Function, typename... Args>
-StaticThread<StackSize, CanReceiveSignals, QueuedSignals, CaughtSignals, Function, Args...>
+		bool HasOwnReent = true, typename Function, typename... Args>
+StaticThread<StackSize, CanReceiveSignals, QueuedSignals, CaughtSignals, HasOwnReent, Function, Args...>
 makeStaticThread(const uint8_t priority, Function&& function, Args&&... args)
 {
 	return {priority, std::forward<Function>(function), std::forward<Args>(args)...};
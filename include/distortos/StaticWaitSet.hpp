@@ -0,0 +1,51 @@
+/**
+ * \file
+ * \brief StaticWaitSet class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-16
+ */
+
+#ifndef INCLUDE_DISTORTOS_STATICWAITSET_HPP_
+#define INCLUDE_DISTORTOS_STATICWAITSET_HPP_
+
+#include "WaitSet.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief StaticWaitSet class is a variant of WaitSet that has automatic storage for objects in the set.
+ *
+ * \param MaxObjects is the maximum number of objects in the set
+ */
+
+template<size_t MaxObjects>
+class StaticWaitSet : public WaitSet
+{
+public:
+
+	/**
+	 * \brief StaticWaitSet's constructor
+	 */
+
+	explicit StaticWaitSet() :
+			WaitSet{storage_}
+	{
+
+	}
+
+private:
+
+	/// storage for objects in the set
+	std::array<Storage, MaxObjects> storage_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_STATICWAITSET_HPP_
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-02-16
+ * \date 2015-05-26
  */
 
 #ifndef INCLUDE_DISTORTOS_THISTHREAD_HPP_
@@ -16,9 +16,12 @@
 
 #include "distortos/TickClock.hpp"
 
+#include <utility>
+
 namespace distortos
 {
 
+class PeriodicActivation;
 class ThreadBase;
 
 /// ThisThread namespace groups functions used to control current thread
@@ -54,6 +57,45 @@ uint8_t getPriority();
 
 void setPriority(uint8_t priority, bool alwaysBehind = {});
 
+/**
+ * \brief Makes the calling (current) thread periodic.
+ *
+ * \a periodicActivation is attached to the calling thread and prepared for first release, which will occur at
+ * \a firstRelease. Each call to waitForNextPeriod() ends current activation and waits for the next release.
+ *
+ * \param [in] periodicActivation is a reference to PeriodicActivation object which will track releases of the calling
+ * thread, it must stay valid until stopPeriodic() is called
+ * \param [in] firstRelease is the time point of first release
+ *
+ * \return 0 on success, error code otherwise:
+ * - EBUSY - calling thread is already periodic;
+ */
+
+int startPeriodic(PeriodicActivation& periodicActivation, TickClock::time_point firstRelease);
+
+/**
+ * \brief Makes the calling (current) thread periodic, with first release at current time point.
+ *
+ * \param [in] periodicActivation is a reference to PeriodicActivation object which will track releases of the calling
+ * thread, it must stay valid until stopPeriodic() is called
+ *
+ * \return 0 on success, error code otherwise:
+ * - error codes returned by startPeriodic(PeriodicActivation&, TickClock::time_point);
+ */
+
+int startPeriodic(PeriodicActivation& periodicActivation);
+
+/**
+ * \brief Makes the calling (current) thread non-periodic.
+ *
+ * PeriodicActivation object is detached from the calling thread, its statistics remain valid.
+ *
+ * \return 0 on success, error code otherwise:
+ * - EINVAL - calling thread is not periodic;
+ */
+
+int stopPeriodic();
+
 /**
  * \brief Makes the calling (current) thread sleep for at least given duration.
  *
@@ -111,12 +153,125 @@ void sleepUntil(const std::chrono::time_point<TickClock, Duration> timePoint)
 	sleepUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint));
 }
 
+/**
+ * \brief Accepts pending notification of the calling (current) thread.
+ *
+ * If notification is pending (see ThreadBase::notify()), its value is returned and cleared, "pending" flag is cleared.
+ *
+ * \return pair with return code (0 on success, error code otherwise) and value of accepted notification; error codes:
+ * - EAGAIN - no notification was pending;
+ */
+
+std::pair<int, uint32_t> tryWaitNotification();
+
+/**
+ * \brief Waits for notification of the calling (current) thread for given duration of time.
+ *
+ * \param [in] duration is the duration after which the wait will be terminated without accepting notification
+ *
+ * \return pair with return code (0 on success, error code otherwise) and value of accepted notification; error codes:
+ * - ETIMEDOUT - no notification was sent before the specified timeout expired;
+ */
+
+std::pair<int, uint32_t> tryWaitNotificationFor(TickClock::duration duration);
+
+/**
+ * \brief Waits for notification of the calling (current) thread for given duration of time.
+ *
+ * Template variant of tryWaitNotificationFor(TickClock::duration duration).
+ *
+ * \param Rep is type of tick counter
+ * \param Period is std::ratio type representing the tick period of the clock, in seconds
+ *
+ * \param [in] duration is the duration after which the wait will be terminated without accepting notification
+ *
+ * \return pair with return code (0 on success, error code otherwise) and value of accepted notification; error codes:
+ * - ETIMEDOUT - no notification was sent before the specified timeout expired;
+ */
+
+template<typename Rep, typename Period>
+std::pair<int, uint32_t> tryWaitNotificationFor(const std::chrono::duration<Rep, Period> duration)
+{
+	return tryWaitNotificationFor(std::chrono::duration_cast<TickClock::duration>(duration));
+}
+
+/**
+ * \brief Waits for notification of the calling (current) thread until given time point.
+ *
+ * \param [in] timePoint is the time point at which the wait will be terminated without accepting notification
+ *
+ * \return pair with return code (0 on success, error code otherwise) and value of accepted notification; error codes:
+ * - ETIMEDOUT - no notification was sent before specified \a timePoint;
+ */
+
+std::pair<int, uint32_t> tryWaitNotificationUntil(TickClock::time_point timePoint);
+
+/**
+ * \brief Waits for notification of the calling (current) thread until given time point.
+ *
+ * Template variant of tryWaitNotificationUntil(TickClock::time_point timePoint).
+ *
+ * \param Duration is a std::chrono::duration type used to measure duration
+ *
+ * \param [in] timePoint is the time point at which the wait will be terminated without accepting notification
+ *
+ * \return pair with return code (0 on success, error code otherwise) and value of accepted notification; error codes:
+ * - ETIMEDOUT - no notification was sent before specified \a timePoint;
+ */
+
+template<typename Duration>
+std::pair<int, uint32_t> tryWaitNotificationUntil(const std::chrono::time_point<TickClock, Duration> timePoint)
+{
+	return tryWaitNotificationUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint));
+}
+
+/**
+ * \brief Waits for notification of the calling (current) thread.
+ *
+ * If no notification is pending (see ThreadBase::notify()), current thread's state is changed to "waiting for
+ * notification" until notification is sent. Value of accepted notification is returned and cleared, "pending" flag is
+ * cleared.
+ *
+ * \return pair with return code (0 on success, error code otherwise) and value of accepted notification
+ */
+
+std::pair<int, uint32_t> waitNotification();
+
+/**
+ * \brief Ends current activation of the calling (current) periodic thread and waits for its next release.
+ *
+ * Current thread's state is changed to "sleeping" until next release. Missed deadlines, overruns and release latency
+ * are tracked by PeriodicActivation object attached to the calling thread.
+ *
+ * \return 0 on success, error code otherwise:
+ * - EINVAL - calling thread is not periodic;
+ */
+
+int waitForNextPeriod();
+
 /**
  * \brief Yields time slot of the scheduler to next thread.
  */
 
 void yield();
 
+/**
+ * \brief Yields time slot of the scheduler directly to provided thread.
+ *
+ * Provided thread is selected to run next, before other threads with the same priority (including the calling thread,
+ * which runs again when provided thread blocks or yields). This is possible only if provided thread is runnable and
+ * its priority is not lower than the priority of any other runnable thread - usually when both threads have the same
+ * priority.
+ *
+ * \param [in] thread is a reference to ThreadBase object of thread which will receive the time slot
+ *
+ * \return 0 on success, error code otherwise:
+ * - EINVAL - \a thread is the calling thread or it is not runnable;
+ * - EPERM - priority of \a thread is lower than priority of some other runnable thread;
+ */
+
+int yieldTo(ThreadBase& thread);
+
 }	// namespace ThisThread
 
 }	// namespace distortos
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-03-14
+ * \date 2015-06-04
  */
 
 #ifndef INCLUDE_DISTORTOS_THREAD_HPP_
@@ -22,6 +22,10 @@ namespace distortos
 /**
  * \brief Thread class is a templated interface for thread
  *
+ * \note Storage for newlib's _reent structure of the thread must be passed explicitly to each constructor. If nullptr
+ * is passed instead, the thread uses the global _reent structure shared with other threads - errno and stdio state are
+ * not thread-specific then. StaticThread provides this storage by default.
+ *
  * \param Function is the function that will be executed in separate thread
  * \param Args are the arguments for Function
  */
@@ -43,13 +47,15 @@ public:
 	 * \param [in] schedulingPolicy is the scheduling policy of the thread
 	 * \param [in] signalsReceiver is a pointer to SignalsReceiver object for this thread, nullptr to disable reception
 	 * of signals for this thread
+	 * \param [in] reent is a pointer to storage for newlib's _reent structure of this thread, nullptr to use the global
+	 * _reent structure shared with other threads
 	 * \param [in] function is a function that will be executed in separate thread
 	 * \param [in] args are arguments for function
 	 */
 
 	Thread(void* const buffer, const size_t size, const uint8_t priority, const SchedulingPolicy schedulingPolicy,
-			SignalsReceiver* const signalsReceiver, Function&& function, Args&&... args) :
-			ThreadBase{buffer, size, priority, schedulingPolicy, nullptr, signalsReceiver},
+			SignalsReceiver* const signalsReceiver, _reent* const reent, Function&& function, Args&&... args) :
+			ThreadBase{buffer, size, priority, schedulingPolicy, nullptr, signalsReceiver, reent},
 			boundFunction_{std::bind(std::forward<Function>(function), std::forward<Args>(args)...)}
 	{
 
@@ -62,13 +68,15 @@ public:
 	 * \param [in] size is the size of stack's buffer, bytes
 	 * \param [in] priority is the thread's priority, 0 - lowest, UINT8_MAX - highest
 	 * \param [in] schedulingPolicy is the scheduling policy of the thread
+	 * \param [in] reent is a pointer to storage for newlib's _reent structure of this thread, nullptr to use the global
+	 * _reent structure shared with other threads
 	 * \param [in] function is a function that will be executed in separate thread
 	 * \param [in] args are arguments for function
 	 */
 
 	Thread(void* const buffer, const size_t size, const uint8_t priority, const SchedulingPolicy schedulingPolicy,
-			Function&& function, Args&&... args) :
-			Thread{buffer, size, priority, schedulingPolicy, nullptr, std::forward<Function>(function),
+			_reent* const reent, Function&& function, Args&&... args) :
+			Thread{buffer, size, priority, schedulingPolicy, nullptr, reent, std::forward<Function>(function),
 					std::forward<Args>(args)...}
 	{
 
@@ -82,13 +90,15 @@ public:
 	 * \param [in] priority is the thread's priority, 0 - lowest, UINT8_MAX - highest
 	 * \param [in] signalsReceiver is a pointer to SignalsReceiver object for this thread, nullptr to disable reception
 	 * of signals for this thread
+	 * \param [in] reent is a pointer to storage for newlib's _reent structure of this thread, nullptr to use the global
+	 * _reent structure shared with other threads
 	 * \param [in] function is a function that will be executed in separate thread
 	 * \param [in] args are arguments for function
 	 */
 
 	Thread(void* const buffer, const size_t size, const uint8_t priority, SignalsReceiver* const signalsReceiver,
-			Function&& function, Args&&... args) :
-			Thread{buffer, size, priority, SchedulingPolicy::RoundRobin, signalsReceiver,
+			_reent* const reent, Function&& function, Args&&... args) :
+			Thread{buffer, size, priority, SchedulingPolicy::RoundRobin, signalsReceiver, reent,
 					std::forward<Function>(function), std::forward<Args>(args)...}
 	{
 
@@ -100,13 +110,16 @@ public:
 	 * \param [in] buffer is a pointer to stack's buffer
 	 * \param [in] size is the size of stack's buffer, bytes
 	 * \param [in] priority is the thread's priority, 0 - lowest, UINT8_MAX - highest
+	 * \param [in] reent is a pointer to storage for newlib's _reent structure of this thread, nullptr to use the global
+	 * _reent structure shared with other threads
 	 * \param [in] function is a function that will be executed in separate thread
 	 * \param [in] args are arguments for function
 	 */
 
-	Thread(void* const buffer, const size_t size, const uint8_t priority, Function&& function, Args&&... args) :
-			Thread{buffer, size, priority, SchedulingPolicy::RoundRobin, nullptr, std::forward<Function>(function),
-					std::forward<Args>(args)...}
+	Thread(void* const buffer, const size_t size, const uint8_t priority, _reent* const reent, Function&& function,
+			Args&&... args) :
+			Thread{buffer, size, priority, SchedulingPolicy::RoundRobin, nullptr, reent,
+					std::forward<Function>(function), std::forward<Args>(args)...}
 	{
 
 	}
@@ -142,6 +155,8 @@ private:
  * \param [in] schedulingPolicy is the scheduling policy of the thread
  * \param [in] signalsReceiver is a pointer to SignalsReceiver object for this thread, nullptr to disable reception of
  * signals for this thread
+ * \param [in] reent is a pointer to storage for newlib's _reent structure of this thread, nullptr to use the global
+ * _reent structure shared with other threads
  * \param [in] function is a function that will be executed in separate thread
  * \param [in] args are arguments for function
  *
@@ -150,10 +165,10 @@ private:
 
 template<typename Function, typename... Args>
 Thread<Function, Args...> makeThread(void* const buffer, const size_t size, const uint8_t priority,
-		const SchedulingPolicy schedulingPolicy, SignalsReceiver* const signalsReceiver, Function&& function,
-		Args&&... args)
+		const SchedulingPolicy schedulingPolicy, SignalsReceiver* const signalsReceiver, _reent* const reent,
+		Function&& function, Args&&... args)
 {
-	return {buffer, size, priority, schedulingPolicy, signalsReceiver, std::forward<Function>(function),
+	return {buffer, size, priority, schedulingPolicy, signalsReceiver, reent, std::forward<Function>(function),
 			std::forward<Args>(args)...};
 }
 
@@ -167,6 +182,8 @@ Thread<Function, Args...> makeThread(void* const buffer, const size_t size, cons
  * \param [in] size is the size of stack's buffer, bytes
  * \param [in] priority is the thread's priority, 0 - lowest, UINT8_MAX - highest
  * \param [in] schedulingPolicy is the scheduling policy of the thread
+ * \param [in] reent is a pointer to storage for newlib's _reent structure of this thread, nullptr to use the global
+ * _reent structure shared with other threads
  * \param [in] function is a function that will be executed in separate thread
  * \param [in] args are arguments for function
  *
@@ -175,9 +192,10 @@ Thread<Function, Args...> makeThread(void* const buffer, const size_t size, cons
 
 template<typename Function, typename... Args>
 Thread<Function, Args...> makeThread(void* const buffer, const size_t size, const uint8_t priority,
-		const SchedulingPolicy schedulingPolicy, Function&& function, Args&&... args)
+		const SchedulingPolicy schedulingPolicy, _reent* const reent, Function&& function, Args&&... args)
 {
-	return {buffer, size, priority, schedulingPolicy, std::forward<Function>(function), std::forward<Args>(args)...};
+	return {buffer, size, priority, schedulingPolicy, reent, std::forward<Function>(function),
+			std::forward<Args>(args)...};
 }
 
 /**
@@ -191,6 +209,8 @@ Thread<Function, Args...> makeThread(void* const buffer, const size_t size, cons
  * \param [in] priority is the thread's priority, 0 - lowest, UINT8_MAX - highest
  * \param [in] signalsReceiver is a pointer to SignalsReceiver object for this thread, nullptr to disable reception of
  * signals for this thread
+ * \param [in] reent is a pointer to storage for newlib's _reent structure of this thread, nullptr to use the global
+ * _reent structure shared with other threads
  * \param [in] function is a function that will be executed in separate thread
  * \param [in] args are arguments for function
  *
@@ -199,9 +219,10 @@ Thread<Function, Args...> makeThread(void* const buffer, const size_t size, cons
 
 template<typename Function, typename... Args>
 Thread<Function, Args...> makeThread(void* const buffer, const size_t size, const uint8_t priority,
-		SignalsReceiver* const signalsReceiver, Function&& function, Args&&... args)
+		SignalsReceiver* const signalsReceiver, _reent* const reent, Function&& function, Args&&... args)
 {
-	return {buffer, size, priority, signalsReceiver, std::forward<Function>(function), std::forward<Args>(args)...};
+	return {buffer, size, priority, signalsReceiver, reent, std::forward<Function>(function),
+			std::forward<Args>(args)...};
 }
 
 /**
@@ -213,6 +234,8 @@ Thread<Function, Args...> makeThread(void* const buffer, const size_t size, cons
  * \param [in] buffer is a pointer to stack's buffer
  * \param [in] size is the size of stack's buffer, bytes
  * \param [in] priority is the thread's priority, 0 - lowest, UINT8_MAX - highest
+ * \param [in] reent is a pointer to storage for newlib's _reent structure of this thread, nullptr to use the global
+ * _reent structure shared with other threads
  * \param [in] function is a function that will be executed in separate thread
  * \param [in] args are arguments for function
  *
@@ -220,10 +243,10 @@ Thread<Function, Args...> makeThread(void* const buffer, const size_t size, cons
  */
 
 template<typename Function, typename... Args>
-Thread<Function, Args...> makeThread(void* const buffer, const size_t size, const uint8_t priority, Function&& function,
-		Args&&... args)
+Thread<Function, Args...> makeThread(void* const buffer, const size_t size, const uint8_t priority, _reent* const reent,
+		Function&& function, Args&&... args)
 {
-	return {buffer, size, priority, std::forward<Function>(function), std::forward<Args>(args)...};
+	return {buffer, size, priority, reent, std::forward<Function>(function), std::forward<Args>(args)...};
 }
 
 }	// namespace distortos
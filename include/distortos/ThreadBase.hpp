@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-03-31
+ * \date 2015-06-03
  */
 
 #ifndef INCLUDE_DISTORTOS_THREADBASE_HPP_
@@ -19,6 +19,7 @@
 #include "distortos/synchronization/SignalsReceiverControlBlock.hpp"
 
 #include "distortos/Semaphore.hpp"
+#include "distortos/ThisThread.hpp"
 
 #include <cerrno>
 
@@ -28,8 +29,13 @@ namespace distortos
 /// ThreadBase class is a base for threads
 class ThreadBase
 {
+	friend int ThisThread::yieldTo(ThreadBase&);
+
 public:
 
+	/// action performed on thread's notification value by notify()
+	using NotificationAction = scheduler::ThreadControlBlock::NotificationAction;
+
 	/**
 	 * \brief ThreadBase's constructor.
 	 *
@@ -41,10 +47,13 @@ public:
 	 * be added, nullptr to inherit thread group from currently running thread
 	 * \param [in] signalsReceiver is a pointer to SignalsReceiver object for this thread, nullptr to disable reception
 	 * of signals for this thread
+	 * \param [in] reent is a pointer to storage for newlib's _reent structure of this thread, nullptr to use the global
+	 * _reent structure shared with other threads
 	 */
 
 	ThreadBase(void* buffer, size_t size, uint8_t priority, SchedulingPolicy schedulingPolicy,
-			scheduler::ThreadGroupControlBlock* threadGroupControlBlock, SignalsReceiver* signalsReceiver);
+			scheduler::ThreadGroupControlBlock* threadGroupControlBlock, SignalsReceiver* signalsReceiver,
+			_reent* reent);
 
 	/**
 	 * \brief ThreadBase's constructor.
@@ -56,10 +65,13 @@ public:
 	 * be added, nullptr to inherit thread group from currently running thread
 	 * \param [in] signalsReceiver is a pointer to SignalsReceiver object for this thread, nullptr to disable reception
 	 * of signals for this thread
+	 * \param [in] reent is a pointer to storage for newlib's _reent structure of this thread, nullptr to use the global
+	 * _reent structure shared with other threads
 	 */
 
 	ThreadBase(architecture::Stack&& stack, uint8_t priority, SchedulingPolicy schedulingPolicy,
-			scheduler::ThreadGroupControlBlock* threadGroupControlBlock, SignalsReceiver* signalsReceiver);
+			scheduler::ThreadGroupControlBlock* threadGroupControlBlock, SignalsReceiver* signalsReceiver,
+			_reent* reent);
 
 	/**
 	 * \brief Generates signal for thread.
@@ -143,6 +155,28 @@ public:
 
 	int join();
 
+	/**
+	 * \brief Sends notification to thread.
+	 *
+	 * Lightweight alternative to Semaphore or EventGroup-like object for the case when exactly one known thread is
+	 * woken - notification value and "pending" flag are stored directly in thread's ThreadControlBlock. Notification
+	 * value is modified with selected action and marked as pending. If this thread is currently waiting for
+	 * notification (ThisThread::waitNotification() and similar), it will be unblocked.
+	 *
+	 * \note This function may be called from thread or interrupt context.
+	 *
+	 * \param [in] action is the action performed on notification value
+	 * \param [in] value is the value used by selected action, ignored for NotificationAction::Increment, default - 0
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a action is invalid;
+	 */
+
+	int notify(const NotificationAction action, const uint32_t value = {})
+	{
+		return threadControlBlock_.notify(action, value);
+	}
+
 	/**
 	 * \brief Queues signal for thread.
 	 *
@@ -2,13 +2,13 @@
  * \file
  * \brief TickClock class header
  *
- * \author Copyright (C) 2014 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-10-27
+ * \date 2015-05-20
  */
 
 #ifndef INCLUDE_DISTORTOS_TICKCLOCK_HPP_
@@ -38,7 +38,12 @@ public:
 	/// basic time_point type of clock
 	using time_point = std::chrono::time_point<TickClock>;
 
-	/// \return time_point representing the current value of the clock
+	/**
+	 * \note This function is lock-free - it never masks interrupts.
+	 *
+	 * \return time_point representing the current value of the clock
+	 */
+
 	static time_point now();
 
 	/// this is a steady clock - it cannot be adjusted
@@ -0,0 +1,352 @@
+/**
+ * \file
+ * \brief WaitSet class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-16
+ */
+
+#ifndef INCLUDE_DISTORTOS_WAITSET_HPP_
+#define INCLUDE_DISTORTOS_WAITSET_HPP_
+
+#include "distortos/SignalSet.hpp"
+#include "distortos/TickClock.hpp"
+
+#include "distortos/synchronization/WaitSetObserver.hpp"
+
+#include <array>
+#include <utility>
+
+namespace distortos
+{
+
+template<typename T>
+class FifoQueue;
+
+template<typename T>
+class MessageQueue;
+
+class RawFifoQueue;
+class RawMessageQueue;
+class Semaphore;
+
+/**
+ * \brief WaitSet is a set of synchronization objects which can be waited for at the same time.
+ *
+ * Similar to select() - http://pubs.opengroup.org/onlinepubs/9699919799/functions/select.html
+ *
+ * Objects are added to the set once and each of them gets an index. wait() and its variants block the calling thread
+ * until at least one of the objects is "ready" and return the lowest index of ready object. Readiness means that
+ * corresponding "non-blocking" operation would succeed at the moment of the check:
+ * - Semaphore - its value is not zero (Semaphore::tryWait());
+ * - FifoQueue, MessageQueue, RawFifoQueue, RawMessageQueue - queue is not empty (tryPop());
+ * - signals - at least one of selected signals is pending (ThisThread::Signals::tryWait());
+ * - notification - notification of calling thread is pending (ThisThread::tryWaitNotification());
+ *
+ * The object is not "consumed" by WaitSet - it's up to the caller to do that with the non-blocking operation. As the
+ * object may be "consumed" by some other thread or interrupt in the meantime, this operation may still fail.
+ *
+ * \note WaitSet may be used only by one thread at a time. Signals and notification always refer to the thread that
+ * calls wait().
+ */
+
+class WaitSet
+{
+public:
+
+	/// type of index of object in the set
+	using Index = size_t;
+
+	/// type of storage for single object in the set
+	using Storage = synchronization::WaitSetObserver;
+
+	/**
+	 * \brief WaitSet's constructor
+	 *
+	 * \param [in] storage is an array of Storage elements
+	 * \param [in] maxObjects is the number of elements in \a storage array
+	 */
+
+	WaitSet(Storage* storage, size_t maxObjects);
+
+	/**
+	 * \brief WaitSet's constructor
+	 *
+	 * \param N is the number of elements in \a storage array
+	 *
+	 * \param [in] storage is a reference to array of Storage elements
+	 */
+
+	template<size_t N>
+	explicit WaitSet(Storage (& storage)[N]) :
+			WaitSet{storage, sizeof(storage) / sizeof(*storage)}
+	{
+
+	}
+
+	/**
+	 * \brief WaitSet's constructor
+	 *
+	 * \param N is the number of elements in \a storage array
+	 *
+	 * \param [in] storage is a reference to std::array of Storage elements
+	 */
+
+	template<size_t N>
+	explicit WaitSet(std::array<Storage, N>& storage) :
+			WaitSet{storage.data(), storage.size()}
+	{
+
+	}
+
+	/**
+	 * \brief Adds FifoQueue to the set - it's "ready" when it is not empty.
+	 *
+	 * \param T is the type of data in queue
+	 *
+	 * \param [in] fifoQueue is a reference to FifoQueue that will be added
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and index of \a fifoQueue in the set; error
+	 * codes:
+	 * - error codes returned by add(Semaphore&);
+	 */
+
+	template<typename T>
+	std::pair<int, Index> add(FifoQueue<T>& fifoQueue)
+	{
+		return add(fifoQueue.fifoQueueBase_.getPopSemaphore());
+	}
+
+	/**
+	 * \brief Adds MessageQueue to the set - it's "ready" when it is not empty.
+	 *
+	 * \param T is the type of data in queue
+	 *
+	 * \param [in] messageQueue is a reference to MessageQueue that will be added
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and index of \a messageQueue in the set;
+	 * error codes:
+	 * - error codes returned by add(Semaphore&);
+	 */
+
+	template<typename T>
+	std::pair<int, Index> add(MessageQueue<T>& messageQueue)
+	{
+		return add(messageQueue.messageQueueBase_.getPopSemaphore());
+	}
+
+	/**
+	 * \brief Adds RawFifoQueue to the set - it's "ready" when it is not empty.
+	 *
+	 * \param [in] rawFifoQueue is a reference to RawFifoQueue that will be added
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and index of \a rawFifoQueue in the set;
+	 * error codes:
+	 * - error codes returned by add(Semaphore&);
+	 */
+
+	std::pair<int, Index> add(RawFifoQueue& rawFifoQueue);
+
+	/**
+	 * \brief Adds RawMessageQueue to the set - it's "ready" when it is not empty.
+	 *
+	 * \param [in] rawMessageQueue is a reference to RawMessageQueue that will be added
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and index of \a rawMessageQueue in the set;
+	 * error codes:
+	 * - error codes returned by add(Semaphore&);
+	 */
+
+	std::pair<int, Index> add(RawMessageQueue& rawMessageQueue);
+
+	/**
+	 * \brief Adds Semaphore to the set - it's "ready" when its value is not zero.
+	 *
+	 * \param [in] semaphore is a reference to Semaphore that will be added
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and index of \a semaphore in the set; error
+	 * codes:
+	 * - ENOSPC - the set is full;
+	 */
+
+	std::pair<int, Index> add(Semaphore& semaphore);
+
+	/**
+	 * \brief Adds notification of calling thread to the set - it's "ready" when notification is pending.
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and index of notification in the set; error
+	 * codes:
+	 * - EEXIST - notification was already added to the set;
+	 * - ENOSPC - the set is full;
+	 */
+
+	std::pair<int, Index> addNotification();
+
+	/**
+	 * \brief Adds signals to the set - they are "ready" when at least one of them is pending for calling thread.
+	 *
+	 * If signals were already added to the set, \a signalSet is merged with previously added set of signals and the
+	 * index remains the same.
+	 *
+	 * \param [in] signalSet is a reference to set of signals that will be added
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and index of signals in the set; error codes:
+	 * - ENOSPC - the set is full;
+	 * - ENOTSUP - reception of signals is disabled for current thread;
+	 */
+
+	std::pair<int, Index> addSignals(const SignalSet& signalSet);
+
+	/**
+	 * \brief Checks whether any object from the set is "ready", without blocking.
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and index of the first "ready" object; error
+	 * codes:
+	 * - EAGAIN - no object from the set is "ready";
+	 */
+
+	std::pair<int, Index> tryWait();
+
+	/**
+	 * \brief Waits until any object from the set is "ready" for given duration of time.
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and index of the first "ready" object; error
+	 * codes:
+	 * - ETIMEDOUT - no object from the set became "ready" before the specified timeout expired;
+	 */
+
+	std::pair<int, Index> tryWaitFor(TickClock::duration duration);
+
+	/**
+	 * \brief Waits until any object from the set is "ready" for given duration of time.
+	 *
+	 * Template variant of tryWaitFor(TickClock::duration duration).
+	 *
+	 * \param Rep is type of tick counter
+	 * \param Period is std::ratio type representing the tick period of the clock, in seconds
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and index of the first "ready" object; error
+	 * codes:
+	 * - ETIMEDOUT - no object from the set became "ready" before the specified timeout expired;
+	 */
+
+	template<typename Rep, typename Period>
+	std::pair<int, Index> tryWaitFor(const std::chrono::duration<Rep, Period> duration)
+	{
+		return tryWaitFor(std::chrono::duration_cast<TickClock::duration>(duration));
+	}
+
+	/**
+	 * \brief Waits until any object from the set is "ready" until given time point.
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and index of the first "ready" object; error
+	 * codes:
+	 * - ETIMEDOUT - no object from the set became "ready" before the specified timeout expired;
+	 */
+
+	std::pair<int, Index> tryWaitUntil(TickClock::time_point timePoint);
+
+	/**
+	 * \brief Waits until any object from the set is "ready" until given time point.
+	 *
+	 * Template variant of tryWaitUntil(TickClock::time_point timePoint).
+	 *
+	 * \param Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and index of the first "ready" object; error
+	 * codes:
+	 * - ETIMEDOUT - no object from the set became "ready" before the specified timeout expired;
+	 */
+
+	template<typename Duration>
+	std::pair<int, Index> tryWaitUntil(const std::chrono::time_point<TickClock, Duration> timePoint)
+	{
+		return tryWaitUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint));
+	}
+
+	/**
+	 * \brief Waits until any object from the set is "ready".
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and index of the first "ready" object
+	 */
+
+	std::pair<int, Index> wait();
+
+	WaitSet(const WaitSet&) = delete;
+	WaitSet(WaitSet&&) = default;
+	const WaitSet& operator=(const WaitSet&) = delete;
+	WaitSet& operator=(WaitSet&&) = delete;
+
+private:
+
+	/**
+	 * \brief Finds the first "ready" object in the set.
+	 *
+	 * \attention This function must be called with interrupt masking enabled.
+	 *
+	 * \return pair with "ready" flag (true if any object is "ready", false otherwise) and index of the first "ready"
+	 * object
+	 */
+
+	std::pair<bool, Index> findReady() const;
+
+	/**
+	 * \brief Reserves next free slot in the set.
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and index of reserved slot; error codes:
+	 * - ENOSPC - the set is full;
+	 */
+
+	std::pair<int, Index> reserve();
+
+	/**
+	 * \brief Implementation of wait(), tryWait() and tryWaitUntil().
+	 *
+	 * \param [in] nonBlocking selects whether this function operates in blocking mode (false) or non-blocking mode
+	 * (true)
+	 * \param [in] timePoint is a pointer to time point at which the wait will be terminated, used only if blocking mode
+	 * is selected, nullptr to block without timeout
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and index of the first "ready" object; error
+	 * codes:
+	 * - EAGAIN - no object from the set is "ready" and non-blocking mode was selected;
+	 * - ETIMEDOUT - no object from the set became "ready" before the specified timeout expired;
+	 */
+
+	std::pair<int, Index> waitImplementation(bool nonBlocking, const TickClock::time_point* timePoint);
+
+	/// set of signals which are "waited for"
+	SignalSet signalSet_;
+
+	/// pointer to storage for objects in the set
+	Storage* storage_;
+
+	/// number of elements in \a storage_
+	size_t maxObjects_;
+
+	/// number of objects in the set
+	size_t objects_;
+
+	/// index of notification in the set, equal to \a maxObjects_ if notification was not added
+	Index notificationIndex_;
+
+	/// index of signals in the set, equal to \a maxObjects_ if signals were not added
+	Index signalsIndex_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_WAITSET_HPP_
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-04-28
+ * \date 2015-06-04
  */
 
 #ifndef INCLUDE_DISTORTOS_ARCHITECTURE_STACK_HPP_
@@ -62,6 +62,14 @@ public:
 
 	Stack(void* buffer, size_t size);
 
+	/**
+	 * \brief Gets adjusted address of stack's buffer.
+	 *
+	 * \return adjusted address of stack's buffer - the lowest address which may be used by the stack
+	 */
+
+	void* getAdjustedBuffer() const { return adjustedBuffer_; }
+
 	/**
 	 * \brief Gets current value of stack pointer.
 	 *
@@ -0,0 +1,48 @@
+/**
+ * \file
+ * \brief getTickTimerCounter() declaration
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#ifndef INCLUDE_DISTORTOS_ARCHITECTURE_GETTICKTIMERCOUNTER_HPP_
+#define INCLUDE_DISTORTOS_ARCHITECTURE_GETTICKTIMERCOUNTER_HPP_
+
+#include <cstdint>
+
+namespace distortos
+{
+
+namespace architecture
+{
+
+/**
+ * \brief Gets number of tick timer's clock cycles (CONFIG_TICK_CLOCK) elapsed since last "tick".
+ *
+ * If the timer already reached the end of current "tick", but "tick" interrupt was not handled yet (because interrupts
+ * are masked), the result is increased by the number of cycles in one "tick", so it is always consistent with tick
+ * count which is incremented by this interrupt.
+ *
+ * \warning Tick count is not consistent with the result when this function is called from an interrupt which preempted
+ * the "tick" interrupt after the pending "tick" was cleared (on exception entry), but before tick count was incremented
+ * - the timer is already reloaded, so the result is lower by the number of cycles in one "tick". The caller must handle
+ * that window (see HighResolutionClock::now()).
+ *
+ * \attention This function must be called with interrupt masking enabled.
+ *
+ * \return number of tick timer's clock cycles elapsed since last handled "tick"
+ */
+
+uint32_t getTickTimerCounter();
+
+}	// namespace architecture
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_ARCHITECTURE_GETTICKTIMERCOUNTER_HPP_
@@ -0,0 +1,35 @@
+/**
+ * \file
+ * \brief isInInterruptContext() declaration
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-29
+ */
+
+#ifndef INCLUDE_DISTORTOS_ARCHITECTURE_ISININTERRUPTCONTEXT_HPP_
+#define INCLUDE_DISTORTOS_ARCHITECTURE_ISININTERRUPTCONTEXT_HPP_
+
+namespace distortos
+{
+
+namespace architecture
+{
+
+/**
+ * \brief Architecture-specific check of execution context.
+ *
+ * \return true if called from interrupt context, false if called from thread context
+ */
+
+bool isInInterruptContext();
+
+}	// namespace architecture
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_ARCHITECTURE_ISININTERRUPTCONTEXT_HPP_
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-04-28
+ * \date 2015-06-04
  */
 
 #ifndef INCLUDE_DISTORTOS_ARCHITECTURE_REQUESTFUNCTIONEXECUTION_HPP_
@@ -40,13 +40,22 @@ namespace architecture
  * - interrupt is sending the request to current thread;
  * - interrupt is sending the request to non-current thread;
  *
+ * \note The request doesn't unblock the thread - if the thread is blocked, the function is executed when the thread is
+ * unblocked for any other reason (e.g. when the wait times out), before the interrupted wait returns. The result of
+ * that wait is not affected.
+ *
  * \param [in] threadControlBlock is a reference to scheduler::ThreadControlBlock of thread in which \a function should
  * be executed
  * \param [in] function is a reference to function that should be executed in thread associated with
  * \a threadControlBlock
+ *
+ * \return 0 on success, error code otherwise:
+ * - EBUSY - interrupt is sending the request to current thread, but another request (with different function) from
+ * interrupt to current thread is still pending;
+ * - ENOSPC - there is not enough free space in the stack of target thread to inject the call of function;
  */
 
-void requestFunctionExecution(const scheduler::ThreadControlBlock& threadControlBlock, void (& function)());
+int requestFunctionExecution(const scheduler::ThreadControlBlock& threadControlBlock, void (& function)());
 
 }	// namespace architecture
 
@@ -0,0 +1,38 @@
+/**
+ * \file
+ * \brief sleep() declaration
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-21
+ */
+
+#ifndef INCLUDE_DISTORTOS_ARCHITECTURE_SLEEP_HPP_
+#define INCLUDE_DISTORTOS_ARCHITECTURE_SLEEP_HPP_
+
+namespace distortos
+{
+
+namespace architecture
+{
+
+/**
+ * \brief Architecture-specific low-power wait.
+ *
+ * Puts the core to sleep until next interrupt (or other architecture-specific wake-up event). The function may return
+ * without sleeping, so it must be called in a loop.
+ *
+ * \attention This function must be called only from idle thread, with interrupt masking disabled.
+ */
+
+void sleep();
+
+}	// namespace architecture
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_ARCHITECTURE_SLEEP_HPP_
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-04-29
+ * \date 2015-06-04
  */
 
 #ifndef INCLUDE_DISTORTOS_DISTORTOSCONFIGURATION_H_
@@ -30,6 +30,20 @@
 
 #define CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI 8
 
+/**
+ * \brief selects which instruction is used by idle thread to put the core to sleep: WFE (1) or WFI (0), relevant only
+ * if CONFIG_IDLE_SLEEP == 1
+ */
+
+#define CONFIG_ARCHITECTURE_ARMV7_M_IDLE_WAIT_FOR_EVENT	0
+
+/**
+ * \brief selects whether the core goes back to sleep right after returning from interrupt to idle thread (1) or
+ * whether the loop of idle thread is resumed (0), relevant only if CONFIG_IDLE_SLEEP == 1
+ */
+
+#define CONFIG_ARCHITECTURE_ARMV7_M_IDLE_SLEEP_ON_EXIT	0
+
 /**
  * \brief frequency of timer used for system ticks, Hz
  */
@@ -48,6 +62,69 @@
 
 #define CONFIG_ROUND_ROBIN_RATE_HZ	10
 
+/**
+ * \brief selects whether idle thread puts the core to sleep until next interrupt (1) or whether it busy-waits (0)
+ *
+ * \note Disabled by default, as sleeping core may stop clocks of some peripherals or disconnect debugger. Can be
+ * overridden from compiler's command line - the test application enables it with CONFIGFLAGS in Makefile and
+ * Tuprules.lua.
+ */
+
+#ifndef CONFIG_IDLE_SLEEP
+#define CONFIG_IDLE_SLEEP	0
+#endif	/* ndef CONFIG_IDLE_SLEEP */
+
+/**
+ * \brief selects whether sampling profiler is enabled (1) or disabled (0) - when enabled, tick interrupt records
+ * interrupted program counter and current thread
+ */
+
+#define CONFIG_SAMPLING_PROFILER	0
+
+/**
+ * \brief max number of samples stored by sampling profiler, relevant only if CONFIG_SAMPLING_PROFILER == 1
+ */
+
+#define CONFIG_SAMPLING_PROFILER_SAMPLES	256
+
+/**
+ * \brief number of buckets in hashed table of wait queues used by waitOnAddress() and wakeAddress()
+ */
+
+#define CONFIG_WAIT_ON_ADDRESS_BUCKETS	8
+
+/**
+ * \brief selects whether handing the value of Semaphore posted from interrupt context over to blocked threads is
+ * deferred to PendSV (1) or executed directly in the interrupt (0) - when enabled, Semaphore::post() done in interrupt
+ * only increments the value and appends a request to lock-free queue, which is applied by the scheduler before choosing
+ * next thread
+ *
+ * \note Only the operations on lists of threads done by Semaphore::post() are deferred. Everything else that kernel
+ * functions called from interrupt context do is still executed directly in the interrupt, with interrupt masking
+ * enabled - this includes copying of the element and other operations on semaphores in FifoQueue::tryPush() (and other
+ * queues), generating and queuing of signals, ConditionVariable::notify*(), wakeAddress() and SoftwareTimer::start() /
+ * SoftwareTimer::stop().
+ *
+ * \note Like all other kernel functions, deferred Semaphore::post() may be called only from interrupts which can be
+ * masked by the kernel (priority equal to or lower than CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI) - deferral relies
+ * on the fact that threads check the value and block with interrupt masking enabled.
+ *
+ * \note Disabled by default, as it requires that no Semaphore is destroyed while a post() from interrupt is pending.
+ * Can be overridden from compiler's command line - the test application enables it with CONFIGFLAGS in Makefile and
+ * Tuprules.lua.
+ */
+
+#ifndef CONFIG_DEFERRED_INTERRUPT_REQUESTS
+#define CONFIG_DEFERRED_INTERRUPT_REQUESTS	0
+#endif	/* ndef CONFIG_DEFERRED_INTERRUPT_REQUESTS */
+
+/**
+ * \brief max number of pending deferred requests (must be a power of 2), relevant only if
+ * CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+ */
+
+#define CONFIG_DEFERRED_INTERRUPT_REQUESTS_QUEUE_SIZE	16
+
 /**
  * \brief selects whether reception of signals is enabled (1) or disabled (0) for main thread
  */
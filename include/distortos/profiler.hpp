@@ -0,0 +1,85 @@
+/**
+ * \file
+ * \brief profiler namespace header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-23
+ */
+
+#ifndef INCLUDE_DISTORTOS_PROFILER_HPP_
+#define INCLUDE_DISTORTOS_PROFILER_HPP_
+
+#include "distortos/distortosConfiguration.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#if CONFIG_SAMPLING_PROFILER == 1
+
+namespace distortos
+{
+
+class ThreadBase;
+
+/**
+ * \brief profiler namespace groups functions of sampling profiler
+ *
+ * In each tick interrupt the program counter of interrupted code and the thread which was running are recorded in a
+ * ring buffer with CONFIG_SAMPLING_PROFILER_SAMPLES elements. When the buffer is full, new samples are lost (and
+ * counted) until some samples are read with readSamples(). Read samples can be transferred to host (with any available
+ * channel or with debugger) and converted to per-thread flat profile with scripts/profilerReport.py.
+ */
+
+namespace profiler
+{
+
+/// single sample of sampling profiler
+struct Sample
+{
+	/// program counter of interrupted code
+	uintptr_t programCounter;
+
+	/// pointer to ThreadBase object of interrupted thread, nullptr if interrupt handler was interrupted
+	const ThreadBase* thread;
+};
+
+/**
+ * \return number of samples lost because the buffer was full
+ */
+
+uint64_t getLostSampleCount();
+
+/**
+ * \brief Reads (and removes) samples from profiler's buffer.
+ *
+ * \param [out] buffer is a pointer to array to which samples will be copied
+ * \param [in] size is the number of elements in \a buffer
+ *
+ * \return number of samples copied to \a buffer
+ */
+
+size_t readSamples(Sample* buffer, size_t size);
+
+/**
+ * \brief Records one sample.
+ *
+ * \note this must not be called by user code - it is called by architecture-specific tick interrupt handler
+ *
+ * \param [in] programCounter is the program counter of interrupted code
+ * \param [in] threadContext selects whether thread (true) or interrupt handler (false) was interrupted
+ */
+
+void sample(uintptr_t programCounter, bool threadContext);
+
+}	// namespace profiler
+
+}	// namespace distortos
+
+#endif	// CONFIG_SAMPLING_PROFILER == 1
+
+#endif	// INCLUDE_DISTORTOS_PROFILER_HPP_
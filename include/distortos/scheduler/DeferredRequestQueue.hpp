@@ -0,0 +1,117 @@
+/**
+ * \file
+ * \brief DeferredRequestQueue class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#ifndef INCLUDE_DISTORTOS_SCHEDULER_DEFERREDREQUESTQUEUE_HPP_
+#define INCLUDE_DISTORTOS_SCHEDULER_DEFERREDREQUESTQUEUE_HPP_
+
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+#include <cstddef>
+
+namespace distortos
+{
+
+class Semaphore;
+
+namespace scheduler
+{
+
+/**
+ * \brief DeferredRequestQueue class is a lock-free queue of kernel requests made from interrupt context.
+ *
+ * Interrupts only append compact requests (pointer to Semaphore whose value should be handed over to blocked threads)
+ * to the queue - they never mask interrupts and they don't touch any lists of threads. The queue is processed from
+ * PendSV (by Scheduler::switchContext()) before the next thread is chosen, without requesting another context switch.
+ * Only Semaphore::post() uses the queue - all other kernel functions called from interrupt context still modify lists
+ * of threads directly, with interrupt masking enabled.
+ *
+ * \attention Objects referenced by pending requests must not be destroyed before the requests are processed.
+ *
+ * \attention Requests may be appended only from interrupts which can be masked by the kernel (priority equal to or
+ * lower than CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI).
+ *
+ * The queue has multiple producers (interrupts, which may preempt each other) and a single consumer (PendSV, which has
+ * the lowest priority). Producer reserves a slot by incrementing write index with compare-and-swap and then publishes
+ * the request by storing non-null pointer in the slot. Consumer stops at first slot which was reserved but not yet
+ * published - producer requests context switch after publishing, so such request will be processed by next pass of
+ * PendSV.
+ */
+
+class DeferredRequestQueue
+{
+public:
+
+	/**
+	 * \brief DeferredRequestQueue's constructor
+	 */
+
+	constexpr DeferredRequestQueue() :
+			slots_{},
+			readIndex_{},
+			writeIndex_{}
+	{
+
+	}
+
+	/**
+	 * \brief Processes all published requests.
+	 *
+	 * \attention This function must be called only from PendSV (the single consumer of the queue).
+	 */
+
+	void process();
+
+	/**
+	 * \brief Appends request to hand the value of Semaphore over to blocked threads and requests context switch.
+	 *
+	 * \note This function is lock-free - it never masks interrupts.
+	 *
+	 * \param [in] semaphore is a reference to Semaphore whose value was already incremented
+	 *
+	 * \return true if request was appended, false if the queue is full
+	 */
+
+	bool push(Semaphore& semaphore);
+
+	DeferredRequestQueue(const DeferredRequestQueue&) = delete;
+	DeferredRequestQueue(DeferredRequestQueue&&) = delete;
+	const DeferredRequestQueue& operator=(const DeferredRequestQueue&) = delete;
+	DeferredRequestQueue& operator=(DeferredRequestQueue&&) = delete;
+
+private:
+
+	/// max number of pending requests
+	constexpr static size_t maxRequests_ {CONFIG_DEFERRED_INTERRUPT_REQUESTS_QUEUE_SIZE};
+
+	static_assert(maxRequests_ > 0 && (maxRequests_ & (maxRequests_ - 1)) == 0,
+			"CONFIG_DEFERRED_INTERRUPT_REQUESTS_QUEUE_SIZE must be a power of 2!");
+
+	/// slots with requests, nullptr if the slot is free or it was reserved but not yet published
+	Semaphore* slots_[maxRequests_];
+
+	/// free-running index of next slot which will be processed, modified only by consumer
+	size_t readIndex_;
+
+	/// free-running index of next slot which will be reserved by producer
+	size_t writeIndex_;
+};
+
+}	// namespace scheduler
+
+}	// namespace distortos
+
+#endif	// CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+#endif	// INCLUDE_DISTORTOS_SCHEDULER_DEFERREDREQUESTQUEUE_HPP_
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-01-12
+ * \date 2015-06-04
  */
 
 #ifndef INCLUDE_DISTORTOS_SCHEDULER_MUTEXCONTROLBLOCKLIST_HPP_
@@ -39,7 +39,8 @@ using MutexControlBlockListValueType = std::reference_wrapper<synchronization::M
 using MutexControlBlockListAllocator = allocators::PoolAllocator<MutexControlBlockListValueType,
 		allocators::SimpleFeedablePool>;
 
-/// list of references to mutex control blocks
+/// list of references to mutex control blocks, unsorted - boosted priority of the thread that owns these mutexes is
+/// cached in its ThreadControlBlock, so that adding a mutex to this list is O(1)
 using MutexControlBlockList = std::list<MutexControlBlockListValueType, MutexControlBlockListAllocator>;
 
 }	// namespace scheduler
@@ -8,18 +8,24 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-03-04
+ * \date 2015-06-04
  */
 
 #ifndef INCLUDE_DISTORTOS_SCHEDULER_SCHEDULER_HPP_
 #define INCLUDE_DISTORTOS_SCHEDULER_SCHEDULER_HPP_
 
+#include "distortos/scheduler/DeferredRequestQueue.hpp"
 #include "distortos/scheduler/ThreadControlBlockList.hpp"
+#include "distortos/scheduler/ThreadControlBlockTimeoutList.hpp"
 #include "distortos/scheduler/SoftwareTimerControlBlockSupervisor.hpp"
 
+#include "distortos/statistics.hpp"
+
 namespace distortos
 {
 
+class ScheduleTable;
+
 /// scheduler namespace has symbols related to scheduling
 namespace scheduler
 {
@@ -85,6 +91,9 @@ public:
 	/**
 	 * \brief Blocks current thread with timeout, transferring it to provided container.
 	 *
+	 * Timeout is armed by inserting current thread to internal timeout list - storage for the element is embedded in
+	 * ThreadControlBlock, so no additional objects are needed. The list is serviced by tickInterruptHandler().
+	 *
 	 * \param [in] container is a reference to destination container to which the thread will be transferred
 	 * \param [in] timePoint is the time point at which the thread will be unblocked (if not already unblocked)
 	 * \param [in] unblockFunctor is a pointer to ThreadControlBlock::UnblockFunctor which will be executed in
@@ -98,6 +107,8 @@ public:
 			const ThreadControlBlock::UnblockFunctor* unblockFunctor = {});
 
 	/**
+	 * \note This function is lock-free - it never masks interrupts.
+	 *
 	 * \return number of context switches
 	 */
 
@@ -112,6 +123,49 @@ public:
 		return *currentThreadControlBlock_;
 	}
 
+#if CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+	/**
+	 * \return reference to internal DeferredRequestQueue object
+	 */
+
+	DeferredRequestQueue& getDeferredRequestQueue()
+	{
+		return deferredRequestQueue_;
+	}
+
+#endif	// CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+	/**
+	 * \brief Gets total time spent in idle thread.
+	 *
+	 * Idle time is computed from time points of context switches (switching to and from idle thread), so it is
+	 * accurate regardless of what idle thread does - it may busy-wait or put the core to sleep. The clock is read only
+	 * by context switches to and from idle thread, switches between other threads don't read it.
+	 *
+	 * \return total time spent in idle thread, including current run of idle thread (if it is the current thread)
+	 */
+
+	HighResolutionClock::duration getIdleTime() const;
+
+	/**
+	 * \return reference to kernel event counters
+	 */
+
+	statistics::KernelCounters& getKernelCounters()
+	{
+		return kernelCounters_;
+	}
+
+	/**
+	 * \return reference to kernel event counters
+	 */
+
+	const statistics::KernelCounters& getKernelCounters() const
+	{
+		return kernelCounters_;
+	}
+
 	/**
 	 * \return reference to internal MutexControlBlockListAllocator::Pool object
 	 */
@@ -130,6 +184,15 @@ public:
 		return mutexControlBlockListAllocatorPool_;
 	}
 
+	/**
+	 * \return pointer to active ScheduleTable, nullptr if no table is active
+	 */
+
+	const ScheduleTable* getScheduleTable() const
+	{
+		return scheduleTable_;
+	}
+
 	/**
 	 * \return reference to internal SoftwareTimerControlBlockSupervisor object
 	 */
@@ -158,6 +221,8 @@ public:
 	}
 
 	/**
+	 * \note This function is lock-free - it never masks interrupts.
+	 *
 	 * \return current value of tick count
 	 */
 
@@ -170,12 +235,14 @@ public:
 	 * be higher than priority of idle thread
 	 *
 	 * \param [in] mainThread is a reference to main thread
+	 * \param [in] idleThreadControlBlock is a reference to ThreadControlBlock of idle thread, time spent in this
+	 * thread is accounted as idle time
 	 *
 	 * \return 0 on success, error code otherwise:
 	 * - error codes returned by Scheduler::addInternal();
 	 */
 
-	int initialize(MainThread& mainThread);
+	int initialize(MainThread& mainThread, ThreadControlBlock& idleThreadControlBlock);
 
 	/**
 	 * \brief Requests context switch if it is needed.
@@ -183,7 +250,7 @@ public:
 	 * \attention This function must be called with interrupt masking enabled.
 	 */
 
-	void maybeRequestContextSwitch() const;
+	void maybeRequestContextSwitch();
 
 	/**
 	 * \brief Removes current thread from Scheduler's control.
@@ -214,6 +281,20 @@ public:
 
 	int resume(ThreadControlBlockListIterator iterator);
 
+	/**
+	 * \brief Sets active ScheduleTable.
+	 *
+	 * \warning This function must be called with interrupts masked.
+	 *
+	 * \param [in] scheduleTable is a pointer to ScheduleTable which will be handled in tickInterruptHandler(), nullptr
+	 * to disable
+	 */
+
+	void setScheduleTable(ScheduleTable* const scheduleTable)
+	{
+		scheduleTable_ = scheduleTable;
+	}
+
 	/**
 	 * \brief Suspends current thread.
 	 *
@@ -267,12 +348,53 @@ public:
 
 	void unblock(ThreadControlBlockListIterator iterator);
 
+	/**
+	 * \brief Unblocks provided thread and hands the CPU directly to it if priorities permit.
+	 *
+	 * Same as unblock(), but the unblocked thread is additionally passed to yieldTo(), so it runs before other threads
+	 * with the same priority. Failure of yieldTo() is not an error - the thread is left where unblock() placed it.
+	 *
+	 * \param [in] iterator is the iterator which points to unblocked thread
+	 */
+
+	void unblockAndSwitch(ThreadControlBlockListIterator iterator);
+
+	/**
+	 * \brief Unblocks provided thread without requesting context switch.
+	 *
+	 * Same as unblock(), but context switch is not requested - used only while processing deferred requests in
+	 * switchContext(), which chooses the next thread right afterwards, so another pass of PendSV is not needed.
+	 *
+	 * \attention This function must be called with interrupt masking enabled.
+	 *
+	 * \param [in] iterator is the iterator which points to unblocked thread
+	 */
+
+	void unblockInContextSwitch(const ThreadControlBlockListIterator iterator)
+	{
+		unblockInternal(iterator);
+	}
+
 	/**
 	 * \brief Yields time slot of the scheduler to next thread.
 	 */
 
 	void yield();
 
+	/**
+	 * \brief Yields time slot of the scheduler directly to provided thread.
+	 *
+	 * Provided thread is moved to the front of "runnable" list, so it is selected by the next context switch, without
+	 * rotating through other threads with the same priority.
+	 *
+	 * \param [in] threadControlBlock is a reference to ThreadControlBlock of thread which will receive the time slot
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by yieldToInternal();
+	 */
+
+	int yieldTo(ThreadControlBlock& threadControlBlock);
+
 private:
 
 	/**
@@ -321,8 +443,8 @@ private:
 	/**
 	 * \brief Unblocks provided thread, transferring it from it's current container to "runnable" container.
 	 *
-	 * Current container of the thread is obtained with ThreadControlBlock::getList(). Round-robin quantum of thread is
-	 * reset.
+	 * Current container of the thread is obtained with ThreadControlBlock::getList(). If timeout of the thread is armed,
+	 * the thread is removed from timeout list. Round-robin quantum of thread is reset.
 	 *
 	 * \note Internal version - without interrupt masking and yield()
 	 *
@@ -334,6 +456,21 @@ private:
 	void unblockInternal(ThreadControlBlockListIterator iterator,
 			ThreadControlBlock::UnblockReason unblockReason = ThreadControlBlock::UnblockReason::UnblockRequest);
 
+	/**
+	 * \brief Moves provided thread to the front of "runnable" list.
+	 *
+	 * \note Internal version - without interrupt masking and call to maybeRequestContextSwitch()
+	 *
+	 * \param [in] threadControlBlock is a reference to ThreadControlBlock of thread which will receive the time slot
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - provided thread is the current thread or it is not runnable;
+	 * - EPERM - effective priority of provided thread is lower than effective priority of the highest priority runnable
+	 * thread;
+	 */
+
+	int yieldToInternal(ThreadControlBlock& threadControlBlock);
+
 	/// iterator to the currently active ThreadControlBlock
 	ThreadControlBlockListIterator currentThreadControlBlock_;
 
@@ -355,11 +492,42 @@ private:
 	/// internal SoftwareTimerControlBlockSupervisor object
 	SoftwareTimerControlBlockSupervisor softwareTimerControlBlockSupervisor_;
 
-	/// number of context switches
+	/// pool instance used by timeoutListAllocator_
+	ThreadControlBlockListAllocator::Pool timeoutListAllocatorPool_;
+
+	/// PoolAllocator<> of ThreadControlBlockTimeoutList
+	ThreadControlBlockListAllocator timeoutListAllocator_;
+
+	/// list of ThreadControlBlock elements with armed timeout, sorted by timeout time point in ascending order
+	ThreadControlBlockTimeoutList timeoutList_;
+
+	/// number of context switches, modified only from interrupt context (see getContextSwitchCount())
 	uint64_t contextSwitchCount_;
 
-	/// tick count
+	/// tick count, modified only from interrupt context (see getTickCount())
 	uint64_t tickCount_;
+
+	/// pointer to ThreadControlBlock of idle thread
+	ThreadControlBlock* idleThreadControlBlock_;
+
+	/// time point of last context switch to idle thread
+	HighResolutionClock::time_point idleSwitchTimePoint_;
+
+	/// total time spent in idle thread, excluding current run of idle thread
+	HighResolutionClock::duration idleTime_;
+
+	/// kernel event counters
+	statistics::KernelCounters kernelCounters_;
+
+	/// pointer to active ScheduleTable, nullptr if no table is active
+	ScheduleTable* scheduleTable_;
+
+#if CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+	/// queue of kernel requests made from interrupt context, processed in switchContext()
+	DeferredRequestQueue deferredRequestQueue_;
+
+#endif	// CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
 };
 
 }	// namespace scheduler
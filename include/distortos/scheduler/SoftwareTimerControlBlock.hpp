@@ -2,13 +2,13 @@
  * \file
  * \brief SoftwareTimerControlBlock class header
  *
- * \author Copyright (C) 2014 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-11-29
+ * \date 2015-06-04
  */
 
 #ifndef INCLUDE_DISTORTOS_SCHEDULER_SOFTWARETIMERCONTROLBLOCK_HPP_
@@ -70,6 +70,25 @@ public:
 
 	const TickClock::time_point& getTimePoint() const { return timePoint_; }
 
+	/**
+	 * \return number of periods which were skipped because the timer was executed too late, reset when the timer is
+	 * started
+	 */
+
+	uint32_t getOverrunCount() const
+	{
+		return overrunCount_;
+	}
+
+	/**
+	 * \return period of the timer, zero for one-shot timer
+	 */
+
+	TickClock::duration getPeriod() const
+	{
+		return period_;
+	}
+
 	/**
 	 * \return true if the timer is running, false otherwise
 	 */
@@ -139,12 +158,104 @@ public:
 		start(std::chrono::time_point_cast<TickClock::duration>(timePoint));
 	}
 
+	/**
+	 * \brief Starts the timer in periodic mode.
+	 *
+	 * \note The duration will never be shorter, so one additional tick is always added to the duration.
+	 *
+	 * \param [in] duration is the duration after which the function will be executed for the first time
+	 * \param [in] period is the period of the timer, must be greater than zero
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a period is not greater than zero;
+	 */
+
+	int start(TickClock::duration duration, TickClock::duration period);
+
+	/**
+	 * \brief Starts the timer in periodic mode.
+	 *
+	 * \note The duration must not be shorter, so one additional tick is always added to the duration.
+	 *
+	 * \param Rep1 is type of tick counter of \a duration
+	 * \param Period1 is std::ratio type representing the tick period of \a duration, in seconds
+	 * \param Rep2 is type of tick counter of \a period
+	 * \param Period2 is std::ratio type representing the tick period of \a period, in seconds
+	 *
+	 * \param [in] duration is the duration after which the function will be executed for the first time
+	 * \param [in] period is the period of the timer, must be greater than zero (after conversion to
+	 * TickClock::duration)
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by start(TickClock::duration, TickClock::duration);
+	 */
+
+	template<typename Rep1, typename Period1, typename Rep2, typename Period2>
+	int start(const std::chrono::duration<Rep1, Period1> duration, const std::chrono::duration<Rep2, Period2> period)
+	{
+		return start(std::chrono::duration_cast<TickClock::duration>(duration),
+				std::chrono::duration_cast<TickClock::duration>(period));
+	}
+
+	/**
+	 * \brief Starts the timer in periodic mode.
+	 *
+	 * Each next expiration time point is the previous one increased by \a period, so there is no drift. If the timer
+	 * is executed too late (more than one period after its expiration time point), missed periods are skipped and
+	 * counted as overruns.
+	 *
+	 * \param [in] timePoint is the time point at which the function will be executed for the first time
+	 * \param [in] period is the period of the timer, must be greater than zero - zero or negative period would make
+	 * the timer expire again in the same tick forever
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a period is not greater than zero;
+	 */
+
+	int start(TickClock::time_point timePoint, TickClock::duration period);
+
+	/**
+	 * \brief Starts the timer in periodic mode.
+	 *
+	 * \param Duration is a std::chrono::duration type used to measure duration
+	 * \param Rep is type of tick counter of \a period
+	 * \param Period is std::ratio type representing the tick period of \a period, in seconds
+	 *
+	 * \param [in] timePoint is the time point at which the function will be executed for the first time
+	 * \param [in] period is the period of the timer, must be greater than zero (after conversion to
+	 * TickClock::duration)
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by start(TickClock::time_point, TickClock::duration);
+	 */
+
+	template<typename Duration, typename Rep, typename Period>
+	int start(const std::chrono::time_point<TickClock, Duration> timePoint,
+			const std::chrono::duration<Rep, Period> period)
+	{
+		return start(std::chrono::time_point_cast<TickClock::duration>(timePoint),
+				std::chrono::duration_cast<TickClock::duration>(period));
+	}
+
 	/**
 	 * \brief Stops the timer.
 	 */
 
 	void stop();
 
+	/**
+	 * \brief Updates expiration time point of periodic timer.
+	 *
+	 * Expiration time point is increased by period. If it is still not in the future, missed periods are skipped and
+	 * added to overrun count.
+	 *
+	 * \note this should only be called by SoftwareTimerSupervisor::tickInterruptHandler()
+	 *
+	 * \param [in] timePoint is the current time point
+	 */
+
+	void updateTimePoint(TickClock::time_point timePoint);
+
 protected:
 
 	/**
@@ -157,6 +268,15 @@ protected:
 
 private:
 
+	/**
+	 * \brief Internal version of start() - starts the timer in one-shot or periodic mode.
+	 *
+	 * \param [in] timePoint is the time point at which the function will be executed for the first time
+	 * \param [in] period is the period of the timer, zero for one-shot timer
+	 */
+
+	void startInternal(TickClock::time_point timePoint, TickClock::duration period);
+
 	/**
 	 * \brief Software timer's internal function.
 	 *
@@ -168,6 +288,9 @@ private:
 	///time point of expiration
 	TickClock::time_point timePoint_;
 
+	/// period of the timer, zero for one-shot timer
+	TickClock::duration period_;
+
 	/// storage for list link
 	Link link_;
 
@@ -176,6 +299,9 @@ private:
 
 	/// iterator of this object on the list, valid after it has been added to some list
 	SoftwareTimerControlBlockListIterator iterator_;
+
+	/// number of periods which were skipped because the timer was executed too late
+	uint32_t overrunCount_;
 };
 
 }	// namespace scheduler
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-05-09
+ * \date 2015-06-04
  */
 
 #ifndef INCLUDE_DISTORTOS_SCHEDULER_THREADCONTROLBLOCK_HPP_
@@ -21,12 +21,14 @@
 #include "distortos/architecture/Stack.hpp"
 
 #include "distortos/SchedulingPolicy.hpp"
+#include "distortos/TickClock.hpp"
 
 #include "distortos/estd/TypeErasedFunctor.hpp"
 
 namespace distortos
 {
 
+class PeriodicActivation;
 class SignalsReceiver;
 
 namespace synchronization
@@ -40,6 +42,7 @@ namespace scheduler
 {
 
 class ThreadControlBlockList;
+class ThreadControlBlockTimeoutList;
 class ThreadGroupControlBlock;
 
 /// ThreadControlBlock class is a simple description of a Thread
@@ -68,6 +71,27 @@ public:
 		BlockedOnConditionVariable,
 		/// thread is waiting for signal
 		WaitingForSignal,
+		/// thread is blocked on RwLock
+		BlockedOnRwLock,
+		/// thread is waiting for notification
+		WaitingForNotification,
+		/// thread is waiting on WaitSet
+		WaitingForWaitSet,
+		/// thread is blocked on Channel
+		BlockedOnChannel,
+		/// thread is waiting in waitOnAddress()
+		WaitingForAddress,
+	};
+
+	/// action performed on thread's notification value by notify()
+	enum class NotificationAction : uint8_t
+	{
+		/// bitwise OR of notification value with given value
+		SetBits,
+		/// increment of notification value, given value is ignored
+		Increment,
+		/// notification value is replaced with given value
+		Overwrite,
 	};
 
 	/// reason of thread unblocking
@@ -75,7 +99,7 @@ public:
 	{
 		/// explicit request to unblock the thread - normal unblock
 		UnblockRequest,
-		/// timeout - unblock via software timer
+		/// timeout - unblock via timeout list of Scheduler
 		Timeout,
 	};
 
@@ -99,11 +123,14 @@ public:
 	 * be added, nullptr to inherit thread group from currently running thread
 	 * \param [in] signalsReceiver is a pointer to SignalsReceiver object for this thread, nullptr to disable reception
 	 * of signals for this thread
+	 * \param [in] reent is a pointer to storage for newlib's _reent structure of this thread, nullptr to use the global
+	 * _reent structure (_GLOBAL_REENT) shared with other threads
 	 * \param [in] owner is a reference to ThreadBase object that owns this ThreadControlBlock
 	 */
 
 	ThreadControlBlock(architecture::Stack&& stack, uint8_t priority, SchedulingPolicy schedulingPolicy,
-			ThreadGroupControlBlock* threadGroupControlBlock, SignalsReceiver* signalsReceiver, ThreadBase& owner);
+			ThreadGroupControlBlock* threadGroupControlBlock, SignalsReceiver* signalsReceiver, _reent* reent,
+			ThreadBase& owner);
 
 	/**
 	 * \brief ThreadControlBlock's destructor
@@ -111,6 +138,24 @@ public:
 
 	~ThreadControlBlock();
 
+	/**
+	 * \brief Accepts pending notification.
+	 *
+	 * Clears "pending" flag and value of notification.
+	 *
+	 * \attention This function must be called with interrupt masking enabled.
+	 *
+	 * \return value of notification
+	 */
+
+	uint32_t acceptNotification()
+	{
+		const auto notificationValue = notificationValue_;
+		notificationValue_ = {};
+		notificationPending_ = false;
+		return notificationValue;
+	}
+
 	/**
 	 * \brief Hook function executed when thread is added to scheduler.
 	 *
@@ -149,6 +194,15 @@ public:
 		return std::max(priority_, boostedPriority_);
 	}
 
+	/**
+	 * \return pointer to UnblockFunctor saved by blockHook(), valid only when the thread is blocked
+	 */
+
+	const UnblockFunctor* getUnblockFunctor() const
+	{
+		return unblockFunctor_;
+	}
+
 	/**
 	 * \return iterator to the element on the list, valid only when list_ != nullptr
 	 */
@@ -194,6 +248,15 @@ public:
 		return owner_;
 	}
 
+	/**
+	 * \return pointer to PeriodicActivation object of this thread, nullptr if this thread is not periodic
+	 */
+
+	PeriodicActivation* getPeriodicActivation() const
+	{
+		return periodicActivation_;
+	}
+
 	/**
 	 * \return priority of ThreadControlBlock
 	 */
@@ -258,6 +321,43 @@ public:
 		return threadGroupLink_;
 	}
 
+	/**
+	 * \return iterator to the element on the timeout list, valid only when getTimeoutList() != nullptr
+	 */
+
+	ThreadControlBlockListIterator getTimeoutIterator() const
+	{
+		return timeoutIterator_;
+	}
+
+	/**
+	 * \return reference to internal storage for timeout list link
+	 */
+
+	Link& getTimeoutLink()
+	{
+		return timeoutLink_;
+	}
+
+	/**
+	 * \return pointer to timeout list that has this object, nullptr if timeout is not armed
+	 */
+
+	ThreadControlBlockTimeoutList* getTimeoutList() const
+	{
+		return timeoutList_;
+	}
+
+	/**
+	 * \return time point at which the thread will be unblocked with UnblockReason::Timeout, valid only when
+	 * getTimeoutList() != nullptr
+	 */
+
+	TickClock::time_point getTimeoutTimePoint() const
+	{
+		return timeoutTimePoint_;
+	}
+
 	/**
 	 * \return reason of previous unblocking of the thread
 	 */
@@ -267,6 +367,32 @@ public:
 		return unblockReason_;
 	}
 
+	/**
+	 * \return true if notification is pending, false otherwise
+	 */
+
+	bool isNotificationPending() const
+	{
+		return notificationPending_;
+	}
+
+	/**
+	 * \brief Sends notification to the thread.
+	 *
+	 * Modifies notification value with selected action and marks notification as pending. If the thread is waiting for
+	 * notification (or on WaitSet), it is unblocked.
+	 *
+	 * \note This function may be called from thread or interrupt context.
+	 *
+	 * \param [in] action is the action performed on notification value
+	 * \param [in] value is the value used by selected action, ignored for NotificationAction::Increment
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a action is invalid;
+	 */
+
+	int notify(NotificationAction action, uint32_t value);
+
 	/**
 	 * \brief Sets the iterator to the element on the list.
 	 *
@@ -302,12 +428,22 @@ public:
 
 	void setPriority(uint8_t priority, bool alwaysBehind = {});
 
+	/**
+	 * \param [in] periodicActivation is a pointer to PeriodicActivation object of this thread, nullptr if this thread
+	 * is not periodic
+	 */
+
+	void setPeriodicActivation(PeriodicActivation* const periodicActivation)
+	{
+		periodicActivation_ = periodicActivation;
+	}
+
 	/**
 	 * \param [in] priorityInheritanceMutexControlBlock is a pointer to MutexControlBlock (with PriorityInheritance
 	 * protocol) that blocks this thread
 	 */
 
-	void setPriorityInheritanceMutexControlBlock(const synchronization::MutexControlBlock* const
+	void setPriorityInheritanceMutexControlBlock(synchronization::MutexControlBlock* const
 			priorityInheritanceMutexControlBlock)
 	{
 		priorityInheritanceMutexControlBlock_ = priorityInheritanceMutexControlBlock;
@@ -328,17 +464,66 @@ public:
 		state_ = state;
 	}
 
+	/**
+	 * \brief Sets the iterator to the element on the timeout list.
+	 *
+	 * \param [in] timeoutIterator is an iterator to the element on the timeout list
+	 */
+
+	void setTimeoutIterator(const ThreadControlBlockListIterator timeoutIterator)
+	{
+		timeoutIterator_ = timeoutIterator;
+	}
+
+	/**
+	 * \brief Sets the timeout list that has this object.
+	 *
+	 * \param [in] timeoutList is a pointer to timeout list that has this object, nullptr if timeout is not armed
+	 */
+
+	void setTimeoutList(ThreadControlBlockTimeoutList* const timeoutList)
+	{
+		timeoutList_ = timeoutList;
+	}
+
+	/**
+	 * \param [in] timeoutTimePoint is the time point at which the thread will be unblocked with
+	 * UnblockReason::Timeout, it must be set before the object is inserted to timeout list
+	 */
+
+	void setTimeoutTimePoint(const TickClock::time_point timeoutTimePoint)
+	{
+		timeoutTimePoint_ = timeoutTimePoint;
+	}
+
+	/**
+	 * \brief Sets reason of previous unblocking of the thread.
+	 *
+	 * Used to restore the value saved before a nested wait done by a function injected into the thread with
+	 * architecture::requestFunctionExecution(), so that the wait during which the function was injected sees the
+	 * proper reason.
+	 *
+	 * \attention The thread must not be blocked.
+	 *
+	 * \param [in] unblockReason is the new reason of previous unblocking of the thread
+	 */
+
+	void setUnblockReason(const UnblockReason unblockReason)
+	{
+		unblockReason_ = unblockReason;
+	}
+
 	/**
 	 * \brief Hook function called when context is switched to this thread.
 	 *
-	 * Sets global _impure_ptr (from newlib) to thread's \a reent_ member variable.
+	 * Sets global _impure_ptr (from newlib) to thread's _reent structure (its own or the global one).
 	 *
 	 * \attention This function should be called only by Scheduler::switchContext().
 	 */
 
 	void switchedToHook()
 	{
-		_impure_ptr = &reent_;
+		_impure_ptr = reent_;
 	}
 
 	/**
@@ -354,16 +539,28 @@ public:
 	void unblockHook(UnblockReason unblockReason);
 
 	/**
-	 * \brief Updates boosted priority of the thread.
+	 * \brief Updates boosted priority of the thread after "boosted priority" of one of its owned mutexes changed.
 	 *
 	 * This function should be called after all operations involving this thread and a mutex with enabled priority
-	 * protocol.
+	 * protocol. Boosted priority of the thread is the highest "boosted priority" of the mutexes it owns - it is cached,
+	 * so the update is O(1) when the mutex is added to the list of owned mutexes, when its "boosted priority" is raised
+	 * or when the mutex did not determine boosted priority of the thread. Only when the mutex which determined boosted
+	 * priority of the thread is removed from the list or its "boosted priority" is lowered, all m owned mutexes are
+	 * checked, which is O(m). If effective priority of the thread changes, the thread is repositioned on its list,
+	 * which is O(n) in the number of threads on that list.
+	 *
+	 * The change is propagated along the chain of priority inheritance mutexes - this is done iteratively (with
+	 * constant stack usage) and stops at the first link that does not change. Each link of the chain costs the same as
+	 * described above, so the worst case is O(chain * (m + n)), where the length of the chain cannot exceed the number
+	 * of threads.
 	 *
-	 * \param [in] boostedPriority is the initial boosted priority, this should be effective priority of the thread that
-	 * is about to be blocked on a mutex owned by this thread, default - 0
+	 * \param [in] oldBoostedPriority is the previous "boosted priority" of the mutex, 0 if the mutex was just added
+	 * to the list of owned mutexes
+	 * \param [in] newBoostedPriority is the new "boosted priority" of the mutex, 0 if the mutex was just removed from
+	 * the list of owned mutexes
 	 */
 
-	void updateBoostedPriority(uint8_t boostedPriority = {});
+	void updateBoostedPriority(uint8_t oldBoostedPriority, uint8_t newBoostedPriority);
 
 	ThreadControlBlock(const ThreadControlBlock&) = delete;
 	ThreadControlBlock(ThreadControlBlock&&) = default;
@@ -388,15 +585,80 @@ private:
 
 	void reposition(bool loweringBefore);
 
+	/**
+	 * \brief Propagates change of effective priority of the thread along the chain of priority inheritance mutexes.
+	 *
+	 * Starting with the mutex that blocks this thread, boosted priority of each mutex and then of its owner is
+	 * updated, until the first link of the chain which doesn't change.
+	 */
+
+	void propagatePriorityInheritance();
+
+	/**
+	 * \brief Updates boosted priority of the thread (without propagation).
+	 *
+	 * \param [in] oldBoostedPriority is the previous "boosted priority" of the mutex, 0 if the mutex was just added
+	 * to the list of owned mutexes
+	 * \param [in] newBoostedPriority is the new "boosted priority" of the mutex, 0 if the mutex was just removed from
+	 * the list of owned mutexes
+	 *
+	 * \return true if effective priority of the thread changed and the thread was repositioned on its list, false
+	 * otherwise
+	 */
+
+	bool updateBoostedPriorityInternal(uint8_t oldBoostedPriority, uint8_t newBoostedPriority);
+
+	/*
+	 * "Hot" members, used by Scheduler::switchContext(), Scheduler::isContextSwitchRequired(), getEffectivePriority()
+	 * (also by comparisons done while sorting the lists) and tick interrupt handler. They are grouped at the beginning
+	 * of the object, so that they are close to each other and not interleaved with rarely used data. No particular
+	 * alignment of the object (which is usually embedded in ThreadBase after its vtable pointer) is enforced, so these
+	 * members are not guaranteed to fit in a single cache line.
+	 */
+
 	/// internal stack object
 	architecture::Stack stack_;
 
+	/// pointer to list that has this object
+	ThreadControlBlockList* list_;
+
+	/// iterator to the element on the list, valid only when list_ != nullptr
+	ThreadControlBlockListIterator iterator_;
+
+	/// pointer to newlib's _reent structure with thread-specific data, _GLOBAL_REENT if thread doesn't have its own
+	_reent* reent_;
+
+	/// thread's priority, 0 - lowest, UINT8_MAX - highest
+	uint8_t priority_;
+
+	/// thread's boosted priority, 0 - no boosting
+	uint8_t boostedPriority_;
+
+	/// round-robin quantum
+	RoundRobinQuantum roundRobinQuantum_;
+
+	/// scheduling policy of the thread
+	SchedulingPolicy schedulingPolicy_;
+
+	/// current state of object
+	State state_;
+
+	/// true if notification is pending, false otherwise
+	bool notificationPending_;
+
+	/*
+	 * "Cold" members, used only by blocking/unblocking and less frequent operations.
+	 */
+
 	/// storage for list link
 	Link link_;
 
 	/// storage for thread group list link
 	Link threadGroupLink_;
 
+	/// storage for timeout list link
+	Link timeoutLink_;
+
 	/// reference to ThreadBase object that owns this ThreadControlBlock
 	ThreadBase& owner_;
 
@@ -404,13 +666,7 @@ private:
 	MutexControlBlockList ownedProtocolMutexControlBlocksList_;
 
 	/// pointer to MutexControlBlock (with PriorityInheritance protocol) that blocks this thread
-	const synchronization::MutexControlBlock* priorityInheritanceMutexControlBlock_;
-
-	/// pointer to list that has this object
-	ThreadControlBlockList* list_;
-
-	/// iterator to the element on the list, valid only when list_ != nullptr
-	ThreadControlBlockListIterator iterator_;
+	synchronization::MutexControlBlock* priorityInheritanceMutexControlBlock_;
 
 	/// pointer to ThreadGroupControlBlock with which this object is associated
 	ThreadGroupControlBlock* threadGroupControlBlock_;
@@ -421,6 +677,16 @@ private:
 	/// iterator to the element on the ThreadGroupControlBlock's list, valid only when threadGroupList_ != nullptr
 	ThreadControlBlockListIterator threadGroupIterator_;
 
+	/// pointer to timeout list that has this object, nullptr if timeout is not armed
+	ThreadControlBlockTimeoutList* timeoutList_;
+
+	/// iterator to the element on the timeout list, valid only when timeoutList_ != nullptr
+	ThreadControlBlockListIterator timeoutIterator_;
+
+	/// time point at which the thread will be unblocked with UnblockReason::Timeout, valid only when timeoutList_ !=
+	/// nullptr
+	TickClock::time_point timeoutTimePoint_;
+
 	/// information related to unblocking
 	union
 	{
@@ -435,23 +701,11 @@ private:
 	/// receive signals
 	synchronization::SignalsReceiverControlBlock* signalsReceiverControlBlock_;
 
-	/// newlib's _reent structure with thread-specific data
-	_reent reent_;
-
-	/// thread's priority, 0 - lowest, UINT8_MAX - highest
-	uint8_t priority_;
-
-	/// thread's boosted priority, 0 - no boosting
-	uint8_t boostedPriority_;
-
-	/// round-robin quantum
-	RoundRobinQuantum roundRobinQuantum_;
+	/// pointer to PeriodicActivation object of this thread, nullptr if this thread is not periodic
+	PeriodicActivation* periodicActivation_;
 
-	/// scheduling policy of the thread
-	SchedulingPolicy schedulingPolicy_;
-
-	/// current state of object
-	State state_;
+	/// value of notification, see notify()
+	uint32_t notificationValue_;
 };
 
 }	// namespace scheduler
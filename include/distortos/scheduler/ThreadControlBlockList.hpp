@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-03-13
+ * \date 2015-05-26
  */
 
 #ifndef INCLUDE_DISTORTOS_SCHEDULER_THREADCONTROLBLOCKLIST_HPP_
@@ -115,6 +115,20 @@ public:
 		return it;
 	}
 
+	/**
+	 * \brief Moves element of this list to its front.
+	 *
+	 * \warning Sorting order is not verified - effective priority of moved element must not be lower than effective
+	 * priority of current first element.
+	 *
+	 * \param [in] position is the position of the moved object in this list
+	 */
+
+	void spliceFront(const iterator position)
+	{
+		container_.splice(begin(), container_, position);
+	}
+
 	/**
 	 * \brief Wrapper for sortedSplice()
 	 *
@@ -0,0 +1,118 @@
+/**
+ * \file
+ * \brief ThreadControlBlockTimeoutList class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-17
+ */
+
+#ifndef INCLUDE_DISTORTOS_SCHEDULER_THREADCONTROLBLOCKTIMEOUTLIST_HPP_
+#define INCLUDE_DISTORTOS_SCHEDULER_THREADCONTROLBLOCKTIMEOUTLIST_HPP_
+
+#include "distortos/scheduler/ThreadControlBlock.hpp"
+
+#include "distortos/containers/SortedContainer.hpp"
+
+namespace distortos
+{
+
+namespace scheduler
+{
+
+/// functor which gives ascending timeout time point order of elements on the list
+struct ThreadControlBlockAscendingTimeoutTimePoint
+{
+	/**
+	 * \brief ThreadControlBlockAscendingTimeoutTimePoint's function call operator
+	 *
+	 * \param [in] left is the object on the left side of comparison
+	 * \param [in] right is the object on the right side of comparison
+	 *
+	 * \return true if left's timeout time point is greater than right's timeout time point
+	 */
+
+	bool operator()(const ThreadControlBlockListValueType& left, const ThreadControlBlockListValueType& right) const
+	{
+		return left.get().getTimeoutTimePoint() > right.get().getTimeoutTimePoint();
+	}
+};
+
+/// base of ThreadControlBlockTimeoutList
+using ThreadControlBlockTimeoutListBase = containers::SortedContainer
+		<
+				ThreadControlBlockUnsortedList,
+				ThreadControlBlockAscendingTimeoutTimePoint
+		>;
+
+/// List of ThreadControlBlock objects with armed timeout in ascending order of timeout time point. Storage for elements
+/// is embedded in ThreadControlBlock (ThreadControlBlock::getTimeoutLink()), so it must be fed to the pool of allocator
+/// just before the element is inserted.
+class ThreadControlBlockTimeoutList : private ThreadControlBlockTimeoutListBase
+{
+public:
+
+	/// base of ThreadControlBlockTimeoutList
+	using Base = ThreadControlBlockTimeoutListBase;
+
+	using typename Base::iterator;
+	using typename Base::value_type;
+
+	using Base::begin;
+	using Base::empty;
+	using Base::end;
+
+	/**
+	 * \brief ThreadControlBlockTimeoutList's constructor
+	 *
+	 * \param [in] allocator is a reference to ThreadControlBlockListAllocator object used to copy-construct allocator
+	 * of base container
+	 */
+
+	explicit ThreadControlBlockTimeoutList(const ThreadControlBlockListAllocator& allocator) :
+			Base{allocator}
+	{
+
+	}
+
+	/**
+	 * \brief Removes element from the list.
+	 *
+	 * Clears timeout list pointer of erased element.
+	 *
+	 * \param [in] threadControlBlock is a reference to ThreadControlBlock which will be removed, it must be on this
+	 * list
+	 */
+
+	void erase(ThreadControlBlock& threadControlBlock)
+	{
+		Base::erase(threadControlBlock.getTimeoutIterator());
+		threadControlBlock.setTimeoutList(nullptr);
+	}
+
+	/**
+	 * \brief Inserts element to the list.
+	 *
+	 * Sets timeout list pointer and iterator of inserted element.
+	 *
+	 * \param [in] threadControlBlock is a reference to ThreadControlBlock which will be inserted, its timeout time
+	 * point must be already set
+	 */
+
+	void sortedEmplace(ThreadControlBlock& threadControlBlock)
+	{
+		const auto it = Base::sortedEmplace(threadControlBlock);
+		threadControlBlock.setTimeoutList(this);
+		threadControlBlock.setTimeoutIterator(it);
+	}
+};
+
+}	// namespace scheduler
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_SCHEDULER_THREADCONTROLBLOCKTIMEOUTLIST_HPP_
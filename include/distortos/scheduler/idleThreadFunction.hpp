@@ -2,13 +2,13 @@
  * \file
  * \brief idleThreadFunction() declaration
  *
- * \author Copyright (C) 2014 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-08-14
+ * \date 2015-05-21
  */
 
 #ifndef INCLUDE_DISTORTOS_SCHEDULER_IDLETHREADFUNCTION_HPP_
@@ -22,6 +22,10 @@ namespace scheduler
 
 /**
  * \brief Idle thread's function
+ *
+ * Executes idle hook (see setIdleHook()) and - if CONFIG_IDLE_SLEEP == 1 - puts the core to sleep until next interrupt
+ * with architecture::sleep(). Time spent in idle thread is measured by scheduler (see statistics::getIdleTime()), so
+ * it doesn't depend on the selected mode.
  */
 
 void idleThreadFunction();
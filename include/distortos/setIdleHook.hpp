@@ -0,0 +1,41 @@
+/**
+ * \file
+ * \brief setIdleHook() declaration
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-21
+ */
+
+#ifndef INCLUDE_DISTORTOS_SETIDLEHOOK_HPP_
+#define INCLUDE_DISTORTOS_SETIDLEHOOK_HPP_
+
+namespace distortos
+{
+
+/// type of idle hook - function executed by idle thread
+using IdleHook = void(*)();
+
+/**
+ * \brief Sets idle hook.
+ *
+ * Idle hook is executed by idle thread in each iteration of its loop, just before the core is put to sleep (if
+ * CONFIG_IDLE_SLEEP == 1). With "sleep-on-exit" enabled the loop is resumed only after a context switch to idle thread,
+ * not after each interrupt.
+ *
+ * \attention Idle hook must never block and it must be short - it is executed with the small stack of idle thread.
+ *
+ * \param [in] idleHook is the new idle hook, nullptr to disable
+ *
+ * \return previous idle hook, nullptr if it was disabled
+ */
+
+IdleHook setIdleHook(IdleHook idleHook);
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_SETIDLEHOOK_HPP_
@@ -2,18 +2,20 @@
  * \file
  * \brief statistics namespace header
  *
- * \author Copyright (C) 2014 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-11-04
+ * \date 2015-05-29
  */
 
 #ifndef INCLUDE_DISTORTOS_STATISTICS_HPP_
 #define INCLUDE_DISTORTOS_STATISTICS_HPP_
 
+#include "distortos/HighResolutionClock.hpp"
+
 #include <cstdint>
 
 namespace distortos
@@ -23,12 +25,118 @@ namespace distortos
 namespace statistics
 {
 
+/// counters of operations related to each type of object on which threads may wait
+struct WaitObjectCounters
+{
+	/// ThisThread::sleepFor() and ThisThread::sleepUntil()
+	uint32_t sleep;
+
+	/// Semaphore (also used internally by FifoQueue, MessageQueue and their variants)
+	uint32_t semaphore;
+
+	/// Mutex
+	uint32_t mutex;
+
+	/// ConditionVariable
+	uint32_t conditionVariable;
+
+	/// signals
+	uint32_t signals;
+
+	/// RwLock
+	uint32_t rwLock;
+
+	/// thread's notification
+	uint32_t notification;
+
+	/// WaitSet
+	uint32_t waitSet;
+
+	/// Channel
+	uint32_t channel;
+
+	/// waitOnAddress()
+	uint32_t address;
+
+	/// other objects (suspension of thread)
+	uint32_t other;
+};
+
+/**
+ * \brief Kernel event counters.
+ *
+ * All counters are 32-bit and wrap around, so differences between two snapshots should be used.
+ */
+
+struct KernelCounters
+{
+	/// number of times threads were blocked, for each type of object
+	WaitObjectCounters blocks;
+
+	/// number of times threads were unblocked (also due to timeout), for each type of object
+	WaitObjectCounters unblocks;
+
+	/// number of timeouts of blocking operations
+	uint32_t timeouts;
+
+	/// number of expirations of software timers
+	uint32_t softwareTimerExpirations;
+
+	/// number of successful Semaphore::post() calls
+	uint32_t semaphorePosts;
+
+	/// number of Semaphore::post() calls which failed with EOVERFLOW
+	uint32_t semaphoreOverflows;
+
+	/// number of times a thread had to block on mutex (Mutex and writer part of RwLock) which was locked
+	uint32_t mutexContentions;
+
+	/// number of times effective priority of thread was raised by priority inheritance or priority protection protocol
+	uint32_t priorityBoosts;
+
+	/// number of successfully generated or queued signals
+	uint32_t signalDeliveries;
+
+	/// number of context switch requests, the number of actual context switches (which may be lower, as requests made
+	/// before the switch are merged) is returned by getContextSwitchCount()
+	uint32_t contextSwitchRequests;
+
+	/// number of kernel requests deferred from interrupt context to PendSV (CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1)
+	uint32_t deferredRequests;
+
+	/// number of kernel requests which had to be executed directly in interrupt context, because the queue of deferred
+	/// requests was full (CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1)
+	uint32_t deferredRequestOverflows;
+};
+
 /**
  * \return number of context switches
  */
 
 uint64_t getContextSwitchCount();
 
+/**
+ * \brief Gets total time spent in idle thread.
+ *
+ * Together with time elapsed since some reference point (for example HighResolutionClock::now()) it can be used to
+ * compute CPU load, also when idle thread puts the core to sleep.
+ *
+ * \return total time spent in idle thread
+ */
+
+HighResolutionClock::duration getIdleTime();
+
+/**
+ * \brief Gets snapshot of kernel event counters.
+ *
+ * \note This function is lock-free - it never masks interrupts. Each counter is read atomically, but the counters
+ * may be modified while the snapshot is taken, so they are not guaranteed to be consistent with each other.
+ *
+ * \return snapshot of kernel event counters
+ */
+
+KernelCounters getKernelCounters();
+
 }	// namespace statistics
 
 }	// namespace distortos
@@ -0,0 +1,92 @@
+/**
+ * \file
+ * \brief BasicMutexControlBlock class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-02
+ */
+
+#ifndef INCLUDE_DISTORTOS_SYNCHRONIZATION_BASICMUTEXCONTROLBLOCK_HPP_
+#define INCLUDE_DISTORTOS_SYNCHRONIZATION_BASICMUTEXCONTROLBLOCK_HPP_
+
+#include "distortos/synchronization/MutexControlBlock.hpp"
+
+namespace distortos
+{
+
+namespace synchronization
+{
+
+/**
+ * \brief BasicMutexControlBlock class is a control block for BasicMutex with protocol selected at compile time.
+ *
+ * Mutexes with priority protocols use MutexControlBlock, as they must be put on the list of mutexes owned by their
+ * owner.
+ *
+ * \param protocol is the mutex protocol
+ */
+
+template<MutexControlBlock::Protocol protocol>
+class BasicMutexControlBlock : public MutexControlBlock
+{
+public:
+
+	/**
+	 * \brief BasicMutexControlBlock's constructor
+	 *
+	 * \param [in] priorityCeiling is the priority ceiling of mutex, ignored when protocol != Protocol::PriorityProtect
+	 * \param [in] competitive selects the unlocking mode, see MutexControlBlock::MutexControlBlock()
+	 */
+
+	BasicMutexControlBlock(const uint8_t priorityCeiling, const bool competitive) :
+			MutexControlBlock{protocol, priorityCeiling, competitive}
+	{
+
+	}
+};
+
+/**
+ * \brief BasicMutexControlBlock class is a control block for BasicMutex with protocol selected at compile time.
+ *
+ * Specialization for Protocol::None - MutexControlBlockBase is enough for mutexes without priority protocol, so these
+ * don't have the storage for link on the list of owned mutexes and don't do any bookkeeping of that list.
+ */
+
+template<>
+class BasicMutexControlBlock<MutexControlBlock::Protocol::None> : public MutexControlBlockBase
+{
+public:
+
+	/**
+	 * \brief BasicMutexControlBlock's constructor
+	 *
+	 * \param [in] priorityCeiling is ignored
+	 * \param [in] competitive selects the unlocking mode, see MutexControlBlockBase::MutexControlBlockBase()
+	 */
+
+	BasicMutexControlBlock(uint8_t, const bool competitive) :
+			MutexControlBlockBase{competitive}
+	{
+
+	}
+
+	/**
+	 * \return 0 - mutex without protocol has no priority ceiling
+	 */
+
+	constexpr static uint8_t getPriorityCeiling()
+	{
+		return 0;
+	}
+};
+
+}	// namespace synchronization
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_SYNCHRONIZATION_BASICMUTEXCONTROLBLOCK_HPP_
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-01-19
+ * \date 2015-05-26
  */
 
 #ifndef INCLUDE_DISTORTOS_SYNCHRONIZATION_FIFOQUEUEBASE_HPP_
@@ -50,6 +50,16 @@ public:
 		return elementSize_;
 	}
 
+	/**
+	 * \return reference to semaphore guarding access to "pop" functions - its value is equal to the number of available
+	 * elements
+	 */
+
+	Semaphore& getPopSemaphore()
+	{
+		return popSemaphore_;
+	}
+
 	/**
 	 * \brief Implementation of pop() using type-erased functor
 	 *
@@ -64,7 +74,7 @@ public:
 
 	int pop(const SemaphoreFunctor& waitSemaphoreFunctor, const QueueFunctor& functor)
 	{
-		return popPush(waitSemaphoreFunctor, functor, popSemaphore_, pushSemaphore_, readPosition_);
+		return popPush(waitSemaphoreFunctor, functor, popSemaphore_, pushSemaphore_, readPosition_, false);
 	}
 
 	/**
@@ -73,15 +83,19 @@ public:
 	 * \param [in] waitSemaphoreFunctor is a reference to SemaphoreFunctor which will be executed with \a pushSemaphore_
 	 * \param [in] functor is a reference to QueueFunctor which will execute actions related to pushing - it will get
 	 * writePosition_ as argument
+	 * \param [in] switchToUnblocked selects whether \a popSemaphore_ is posted with Semaphore::postAndSwitch() (true)
+	 * or with Semaphore::post() (false)
 	 *
 	 * \return zero if element was pushed successfully, error code otherwise:
 	 * - error codes returned by \a waitSemaphoreFunctor's operator() call;
 	 * - error codes returned by Semaphore::post();
 	 */
 
-	int push(const SemaphoreFunctor& waitSemaphoreFunctor, const QueueFunctor& functor)
+	int push(const SemaphoreFunctor& waitSemaphoreFunctor, const QueueFunctor& functor,
+			const bool switchToUnblocked = false)
 	{
-		return popPush(waitSemaphoreFunctor, functor, pushSemaphore_, popSemaphore_, writePosition_);
+		return popPush(waitSemaphoreFunctor, functor, pushSemaphore_, popSemaphore_, writePosition_,
+				switchToUnblocked);
 	}
 
 private:
@@ -98,6 +112,8 @@ private:
 	 * for pop(), \a popSemaphore_ for push()
 	 * \param [in] storage is a reference to appropriate pointer to storage, which will be passed to \a functor, \a
 	 * readPosition_ for pop(), \a writePosition_ for push()
+	 * \param [in] switchToUnblocked selects whether \a postSemaphore is posted with Semaphore::postAndSwitch() (true)
+	 * or with Semaphore::post() (false)
 	 *
 	 * \return zero if operation was successful, error code otherwise:
 	 * - error codes returned by \a waitSemaphoreFunctor's operator() call;
@@ -105,7 +121,7 @@ private:
 	 */
 
 	int popPush(const SemaphoreFunctor& waitSemaphoreFunctor, const QueueFunctor& functor, Semaphore& waitSemaphore,
-			Semaphore& postSemaphore, void*& storage);
+			Semaphore& postSemaphore, void*& storage, bool switchToUnblocked);
 
 	/// semaphore guarding access to "pop" functions - its value is equal to the number of available elements
 	Semaphore popSemaphore_;
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-03-13
+ * \date 2015-05-16
  */
 
 #ifndef INCLUDE_DISTORTOS_SYNCHRONIZATION_MESSAGEQUEUEBASE_HPP_
@@ -147,6 +147,16 @@ public:
 
 	MessageQueueBase(EntryStorage* entryStorage, void* valueStorage, size_t elementSize, size_t maxElements);
 
+	/**
+	 * \return reference to semaphore guarding access to "pop" functions - its value is equal to the number of available
+	 * elements
+	 */
+
+	Semaphore& getPopSemaphore()
+	{
+		return popSemaphore_;
+	}
+
 	/**
 	 * \brief Implementation of pop() using type-erased functor
 	 *
@@ -8,13 +8,13 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-01-12
+ * \date 2015-06-04
  */
 
 #ifndef INCLUDE_DISTORTOS_SYNCHRONIZATION_MUTEXCONTROLBLOCK_HPP_
 #define INCLUDE_DISTORTOS_SYNCHRONIZATION_MUTEXCONTROLBLOCK_HPP_
 
-#include "distortos/scheduler/ThreadControlBlockList.hpp"
+#include "distortos/synchronization/MutexControlBlockBase.hpp"
 
 namespace distortos
 {
@@ -23,10 +23,12 @@ namespace synchronization
 {
 
 /// MutexControlBlock class is a control block for Mutex
-class MutexControlBlock
+class MutexControlBlock : private MutexControlBlockBase
 {
 public:
 
+	using MutexControlBlockBase::getOwner;
+
 	/// mutex protocols
 	enum class Protocol : uint8_t
 	{
@@ -43,12 +45,19 @@ public:
 	 *
 	 * \param [in] protocol is the mutex protocol
 	 * \param [in] priorityCeiling is the priority ceiling of mutex, ignored when protocol != Protocol::PriorityProtect
+	 * \param [in] competitive selects the unlocking mode when some threads are blocked on the mutex - false to transfer
+	 * ownership directly to the highest priority waiting thread ("handoff"), true to just unblock this thread and let
+	 * it compete for the mutex with other threads, default - false
 	 */
 
-	MutexControlBlock(Protocol protocol, uint8_t priorityCeiling);
+	MutexControlBlock(Protocol protocol, uint8_t priorityCeiling, bool competitive = {});
 
 	/**
 	 * \brief Blocks current thread, transferring it to blockedList_.
+	 *
+	 * When the function returns, current thread is the owner of the mutex. In competitive mode the thread may be
+	 * unblocked without getting the ownership - in that case it tries to lock the mutex and blocks again if it was
+	 * already locked by some other thread.
 	 */
 
 	void block();
@@ -56,6 +65,9 @@ public:
 	/**
 	 * \brief Blocks current thread with timeout, transferring it to blockedList_.
 	 *
+	 * When the function returns 0, current thread is the owner of the mutex. Competitive mode is handled in the same
+	 * way as in block().
+	 *
 	 * \param [in] timePoint is the time point at which the thread will be unblocked (if not already unblocked)
 	 *
 	 * \return 0 on success, error code otherwise:
@@ -73,18 +85,15 @@ public:
 	 * threads are blocked,
 	 * - PriorityProtect - priority ceiling.
 	 *
+	 * The value is cached in the mutex - it is updated by updateBoostedPriority() or when the ownership is transferred,
+	 * so reading it is O(1).
+	 *
 	 * \return "boosted priority" of the mutex
 	 */
 
-	uint8_t getBoostedPriority() const;
-
-	/**
-	 * \return owner of the mutex, nullptr if mutex is currently unlocked
-	 */
-
-	scheduler::ThreadControlBlock* getOwner() const
+	uint8_t getBoostedPriority() const
 	{
-		return owner_;
+		return boostedPriority_;
 	}
 
 	/**
@@ -113,10 +122,61 @@ public:
 
 	void lock();
 
+	/**
+	 * \brief Tries to lock the mutex without interrupt masking.
+	 *
+	 * Lock-free fast path - ownership is acquired with single atomic compare-and-swap of \a owner_ (LDREX/STREX on
+	 * ARMv7-M). It succeeds only if the mutex is unlocked and its protocol is Protocol::None.
+	 *
+	 * \param [in] threadControlBlock is a reference to ThreadControlBlock of current thread
+	 *
+	 * \return true if the mutex was locked, false if slow path (with interrupt masking) must be used
+	 */
+
+	bool tryLockFast(scheduler::ThreadControlBlock& threadControlBlock)
+	{
+		return protocol_ == Protocol::None && MutexControlBlockBase::tryLockFast(threadControlBlock) == true;
+	}
+
+	/**
+	 * \brief Tries to unlock the mutex without interrupt masking.
+	 *
+	 * Lock-free fast path - ownership is released with single atomic compare-and-swap of \a owner_ (LDREX/STREX on
+	 * ARMv7-M). It succeeds only if the mutex is owned by \a threadControlBlock, its protocol is Protocol::None and no
+	 * thread has ever blocked on it since it was locked (the "contended" flag in \a owner_ is not set).
+	 *
+	 * \param [in] threadControlBlock is a reference to ThreadControlBlock of current thread
+	 *
+	 * \return true if the mutex was unlocked, false if slow path (with interrupt masking) must be used
+	 */
+
+	bool tryUnlockFast(scheduler::ThreadControlBlock& threadControlBlock)
+	{
+		return protocol_ == Protocol::None && MutexControlBlockBase::tryUnlockFast(threadControlBlock) == true;
+	}
+
+	/**
+	 * \brief Updates "boosted priority" of the mutex with PriorityInheritance protocol.
+	 *
+	 * New "boosted priority" is the effective priority of the highest priority thread blocked on this mutex or
+	 * \a boostedPriority (whichever is higher). This is O(1).
+	 *
+	 * \note Owner's boosted priority is not updated by this function - if the value changes, the caller must pass the
+	 * previous and the new value to scheduler::ThreadControlBlock::updateBoostedPriority() of the owner.
+	 *
+	 * \param [in] boostedPriority is the initial boosted priority, this should be effective priority of the thread that
+	 * is about to be blocked on this mutex, default - 0
+	 *
+	 * \return true if "boosted priority" of the mutex changed, false otherwise
+	 */
+
+	bool updateBoostedPriority(uint8_t boostedPriority = {});
+
 	/**
 	 * \brief Performs unlocking or transfer of lock from current owner to next thread on the list.
 	 *
-	 * Mutex is unlocked if blockedList_ is empty, otherwise the ownership is transfered to the next thread.
+	 * Mutex is unlocked if blockedList_ is empty, otherwise the ownership is transfered to the next thread. In
+	 * competitive mode the mutex is always unlocked and the next thread (if any) is only unblocked.
 	 *
 	 * \attention mutex must be locked
 	 */
@@ -129,14 +189,14 @@ private:
 	using Link = std::array<std::aligned_storage<sizeof(void*), alignof(void*)>::type, 3>;
 
 	/**
-	 * \brief Performs action required for priority inheritance before actually blocking on the mutex.
+	 * \brief Performs unlocking of mutex and unblocking of next thread on the list, without transfer of ownership.
 	 *
-	 * This must be called in block() and blockUntil() before actually blocking of the calling thread.
+	 * Used in competitive mode - mutex stays "contended" if there are still other threads blocked on it.
 	 *
-	 * \attantion mutex's protocol must be PriorityInheritance
+	 * \attention mutex must be locked and blockedList_ must not be empty
 	 */
 
-	void priorityInheritanceBeforeBlock() const;
+	void competitiveUnlock();
 
 	/**
 	 * \brief Performs transfer of lock from current owner to next thread on the list.
@@ -154,8 +214,14 @@ private:
 
 	void unlock();
 
-	/// ThreadControlBlock objects blocked on mutex
-	scheduler::ThreadControlBlockList blockedList_;
+	/// mutex protocol
+	Protocol protocol_;
+
+	/// priority ceiling of mutex, valid only when protocol_ == Protocol::PriorityProtect
+	uint8_t priorityCeiling_;
+
+	/// "boosted priority" of the mutex, see getBoostedPriority()
+	uint8_t boostedPriority_;
 
 	/// storage for list link
 	Link link_;
@@ -165,15 +231,6 @@ private:
 
 	/// iterator to the element on the list, valid only when list_ != nullptr
 	scheduler::MutexControlBlockList::iterator iterator_;
-
-	/// owner of the mutex
-	scheduler::ThreadControlBlock* owner_;
-
-	/// mutex protocol
-	Protocol protocol_;
-
-	/// priority ceiling of mutex, valid only when protocol_ == Protocol::PriorityProtect
-	uint8_t priorityCeiling_;
 };
 
 }	// namespace synchronization
@@ -0,0 +1,239 @@
+/**
+ * \file
+ * \brief MutexControlBlockBase class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#ifndef INCLUDE_DISTORTOS_SYNCHRONIZATION_MUTEXCONTROLBLOCKBASE_HPP_
+#define INCLUDE_DISTORTOS_SYNCHRONIZATION_MUTEXCONTROLBLOCKBASE_HPP_
+
+#include "distortos/scheduler/ThreadControlBlockList.hpp"
+
+#include "distortos/estd/TypeErasedFunctor.hpp"
+
+namespace distortos
+{
+
+namespace synchronization
+{
+
+/**
+ * \brief MutexControlBlockBase class is a control block for mutex without any priority protocol.
+ *
+ * It has only the owner, the list of blocked threads and the unlocking mode - it is used directly by BasicMutex with
+ * Protocol::None and as a base of MutexControlBlock, which adds support for priority protocols.
+ */
+
+class MutexControlBlockBase
+{
+public:
+
+	/// BeforeBlockFunctor is a functor executed by blockInternal() right before current thread is blocked on the mutex
+	class BeforeBlockFunctor : public estd::TypeErasedFunctor<void()>
+	{
+
+	};
+
+	/**
+	 * \brief MutexControlBlockBase's constructor
+	 *
+	 * \param [in] competitive selects the unlocking mode when some threads are blocked on the mutex - false to transfer
+	 * ownership directly to the highest priority waiting thread ("handoff"), true to just unblock this thread and let
+	 * it compete for the mutex with other threads, default - false
+	 */
+
+	explicit MutexControlBlockBase(bool competitive = {});
+
+	/**
+	 * \brief Blocks current thread, transferring it to blockedList_.
+	 *
+	 * When the function returns, current thread is the owner of the mutex. In competitive mode the thread may be
+	 * unblocked without getting the ownership - in that case it tries to lock the mutex and blocks again if it was
+	 * already locked by some other thread.
+	 */
+
+	void block();
+
+	/**
+	 * \brief Blocks current thread with timeout, transferring it to blockedList_.
+	 *
+	 * When the function returns 0, current thread is the owner of the mutex. Competitive mode is handled in the same
+	 * way as in block().
+	 *
+	 * \param [in] timePoint is the time point at which the thread will be unblocked (if not already unblocked)
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ETIMEDOUT - thread was unblocked because timePoint was reached;
+	 */
+
+	int blockUntil(TickClock::time_point timePoint);
+
+	/**
+	 * \return owner of the mutex, nullptr if mutex is currently unlocked
+	 */
+
+	scheduler::ThreadControlBlock* getOwner() const
+	{
+		return reinterpret_cast<scheduler::ThreadControlBlock*>(__atomic_load_n(&owner_, __ATOMIC_RELAXED) &
+				~contendedFlag_);
+	}
+
+	/**
+	 * \brief Performs actual locking of previously unlocked mutex.
+	 *
+	 * \attention mutex must be unlocked
+	 */
+
+	void lock();
+
+	/**
+	 * \brief Tries to lock the mutex without interrupt masking.
+	 *
+	 * Lock-free fast path - ownership is acquired with single atomic compare-and-swap of \a owner_ (LDREX/STREX on
+	 * ARMv7-M). It succeeds only if the mutex is unlocked.
+	 *
+	 * \param [in] threadControlBlock is a reference to ThreadControlBlock of current thread
+	 *
+	 * \return true if the mutex was locked, false if slow path (with interrupt masking) must be used
+	 */
+
+	bool tryLockFast(scheduler::ThreadControlBlock& threadControlBlock)
+	{
+		uintptr_t expected {};
+		return __atomic_compare_exchange_n(&owner_, &expected, reinterpret_cast<uintptr_t>(&threadControlBlock),
+				false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+	}
+
+	/**
+	 * \brief Tries to unlock the mutex without interrupt masking.
+	 *
+	 * Lock-free fast path - ownership is released with single atomic compare-and-swap of \a owner_ (LDREX/STREX on
+	 * ARMv7-M). It succeeds only if the mutex is owned by \a threadControlBlock and no thread has ever blocked on it
+	 * since it was locked (the "contended" flag in \a owner_ is not set).
+	 *
+	 * \param [in] threadControlBlock is a reference to ThreadControlBlock of current thread
+	 *
+	 * \return true if the mutex was unlocked, false if slow path (with interrupt masking) must be used
+	 */
+
+	bool tryUnlockFast(scheduler::ThreadControlBlock& threadControlBlock)
+	{
+		auto expected = reinterpret_cast<uintptr_t>(&threadControlBlock);
+		return __atomic_compare_exchange_n(&owner_, &expected, 0, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+	}
+
+	/**
+	 * \brief Performs unlocking or transfer of lock from current owner to next thread on the list.
+	 *
+	 * Mutex is unlocked if blockedList_ is empty, otherwise the ownership is transfered to the next thread. In
+	 * competitive mode the mutex is always unlocked and the next thread (if any) is only unblocked.
+	 *
+	 * \attention mutex must be locked
+	 */
+
+	void unlockOrTransferLock();
+
+protected:
+
+	/**
+	 * \brief Blocks current thread (optionally with timeout), transferring it to blockedList_.
+	 *
+	 * When the function returns 0 in "handoff" mode, current thread is the owner of the mutex. In competitive mode the
+	 * thread blocks again each time it is unblocked while the mutex is already locked by some other thread - when the
+	 * function returns 0, the mutex is unlocked and the caller must lock it with lock().
+	 *
+	 * \param [in] timePoint is a pointer to time point at which the thread will be unblocked (if not already
+	 * unblocked), nullptr to block without timeout
+	 * \param [in] beforeBlockFunctor is a pointer to BeforeBlockFunctor which will be executed before each blocking of
+	 * current thread, nullptr to skip this step
+	 * \param [in] unblockFunctor is a pointer to scheduler::ThreadControlBlock::UnblockFunctor which will be executed
+	 * in scheduler::ThreadControlBlock::unblockHook(), nullptr if no functor should be executed
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ETIMEDOUT - thread was unblocked because *timePoint was reached;
+	 */
+
+	int blockInternal(const TickClock::time_point* timePoint, const BeforeBlockFunctor* beforeBlockFunctor,
+			const scheduler::ThreadControlBlock::UnblockFunctor* unblockFunctor);
+
+	/**
+	 * \return true if competitive unlocking mode is selected, false if ownership is transferred to waiting thread on
+	 * unlock
+	 */
+
+	bool isCompetitive() const
+	{
+		return competitive_;
+	}
+
+	/**
+	 * \brief Performs unlocking of mutex and unblocking of next thread on the list, without transfer of ownership.
+	 *
+	 * Used in competitive mode - mutex stays "contended" if there are still other threads blocked on it.
+	 *
+	 * \attention mutex must be locked and blockedList_ must not be empty
+	 */
+
+	void competitiveUnlock();
+
+	/**
+	 * \brief Sets the owner of the mutex.
+	 *
+	 * \attention This function must be called with interrupt masking enabled.
+	 *
+	 * \param [in] owner is a pointer to new owner of the mutex, nullptr to mark the mutex as unlocked
+	 * \param [in] contended selects whether "contended" flag should be set in \a owner_, default - false
+	 */
+
+	void setOwner(scheduler::ThreadControlBlock* const owner, const bool contended = {})
+	{
+		auto value = reinterpret_cast<uintptr_t>(owner);
+		if (contended == true)
+			value |= contendedFlag_;
+		__atomic_store_n(&owner_, value, __ATOMIC_RELAXED);
+	}
+
+	/**
+	 * \brief Performs transfer of lock from current owner to next thread on the list.
+	 *
+	 * \attention mutex must be locked and blockedList_ must not be empty
+	 */
+
+	void transferLock();
+
+	/**
+	 * \brief Performs actual unlocking of previously locked mutex.
+	 *
+	 * \attention mutex must be locked and blockedList_ must be empty
+	 */
+
+	void unlock();
+
+	/// ThreadControlBlock objects blocked on mutex
+	scheduler::ThreadControlBlockList blockedList_;
+
+private:
+
+	/// flag in \a owner_ which is set when some thread blocked on the mutex, it forces unlocking via slow path
+	constexpr static uintptr_t contendedFlag_ {1};
+
+	/// pointer to owner of the mutex (0 if mutex is currently unlocked) with "contended" flag in the least significant
+	/// bit, modified atomically by lock-free fast paths and with interrupt masking enabled by all other code
+	uintptr_t owner_;
+
+	/// true if competitive unlocking mode is selected, false if ownership is transferred to waiting thread on unlock
+	bool competitive_;
+};
+
+}	// namespace synchronization
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_SYNCHRONIZATION_MUTEXCONTROLBLOCKBASE_HPP_
@@ -8,28 +8,31 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-03-31
+ * \date 2015-05-31
  */
 
 #ifndef INCLUDE_DISTORTOS_SYNCHRONIZATION_SIGNALINFORMATIONQUEUE_HPP_
 #define INCLUDE_DISTORTOS_SYNCHRONIZATION_SIGNALINFORMATIONQUEUE_HPP_
 
-#include "distortos/allocators/PoolAllocator.hpp"
-#include "distortos/allocators/FeedablePool.hpp"
-
 #include "distortos/SignalInformation.hpp"
+#include "distortos/SignalSet.hpp"
 
-#include <forward_list>
+#include <type_traits>
 
 namespace distortos
 {
 
-class SignalSet;
-
 namespace synchronization
 {
 
-/// SignalInformationQueue class can be used for queuing of SignalInformation objects
+/**
+ * \brief SignalInformationQueue class can be used for queuing of SignalInformation objects
+ *
+ * Queued objects are kept in separate FIFO list for each signal number, so queuing, accepting and checking which
+ * signals are queued are all O(1) operations. Each FIFO is a circular singly linked list - only the pointer to its last
+ * element is stored, as the last element is linked to the first one.
+ */
+
 class SignalInformationQueue
 {
 public:
@@ -85,23 +88,15 @@ public:
 
 private:
 
-	/// type of allocator used by \a List
-	using PoolAllocator = allocators::PoolAllocator<SignalInformation, allocators::FeedablePool>;
-
-	/// type of container with SignalInformation objects
-	using List = std::forward_list<SignalInformation, PoolAllocator>;
-
-	/// PoolAllocator::Pool used by \a poolAllocator_
-	PoolAllocator::Pool pool_;
-
-	/// PoolAllocator used by \a signalInformationList_ and \a freeSignalInformationList_
-	PoolAllocator poolAllocator_;
+	/// pointers to last elements of FIFO lists of queued SignalInformation objects, one for each signal number, nullptr
+	/// if no signal with given number is queued
+	LinkAndSignalInformation* lastQueued_[SignalSet::Bitset{}.size()];
 
-	/// list of queued SignalInformation objects
-	List signalInformationList_;
+	/// pointer to first element of list of "free" SignalInformation objects, nullptr if list is empty
+	LinkAndSignalInformation* freeList_;
 
-	/// list of "free" SignalInformation objects
-	List freeSignalInformationList_;
+	/// set of signal numbers for which the FIFO list is not empty
+	SignalSet::Bitset queuedSignalsBitset_;
 };
 
 }	// namespace synchronization
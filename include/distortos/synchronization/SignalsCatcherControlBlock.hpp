@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-05-09
+ * \date 2015-06-04
  */
 
 #ifndef INCLUDE_DISTORTOS_SYNCHRONIZATION_SIGNALSCATCHERCONTROLBLOCK_HPP_
@@ -16,6 +16,8 @@
 
 #include "distortos/SignalAction.hpp"
 
+#include <array>
+
 namespace distortos
 {
 
@@ -29,7 +31,14 @@ class ThreadControlBlock;
 namespace synchronization
 {
 
-/// SignalsCatcherControlBlock class is a structure required by threads for "catching" and "handling" of signals
+/**
+ * \brief SignalsCatcherControlBlock class is a structure required by threads for "catching" and "handling" of signals
+ *
+ * Set of signals which have associations is always maintained, so checking whether a signal is caught is a constant
+ * time operation. Finding the association is done either with linear search in the range of Association objects or -
+ * if IndexTable is provided - in constant time, by direct indexing.
+ */
+
 class SignalsCatcherControlBlock
 {
 public:
@@ -40,18 +49,26 @@ public:
 	/// type of uninitialized storage for Association objects
 	using Storage = std::aligned_storage<sizeof(Association), alignof(Association)>::type;
 
+	/// type of table which maps signal numbers to indexes of Association objects
+	using IndexTable = std::array<uint8_t, SignalSet::Bitset{}.size()>;
+
 	/**
 	 * \brief SignalsCatcherControlBlock's constructor
 	 *
 	 * \param [in] storageBegin is a pointer to first element of storage for Association objects
 	 * \param [in] storageEnd is a pointer to "one past the last" element of storage for Association objects
+	 * \param [in] indexTable is a pointer to IndexTable used for direct indexing of Association objects, nullptr to use
+	 * linear search, default - nullptr
 	 */
 
-	constexpr SignalsCatcherControlBlock(Storage* const storageBegin, Storage* const storageEnd) :
+	constexpr SignalsCatcherControlBlock(Storage* const storageBegin, Storage* const storageEnd,
+			IndexTable* const indexTable = {}) :
 			signalMask_{SignalSet::empty},
+			associatedBitset_{},
 			associationsBegin_{reinterpret_cast<decltype(associationsBegin_)>(storageBegin)},
 			storageBegin_{storageBegin},
-			storageEnd_{storageEnd}
+			storageEnd_{storageEnd},
+			indexTable_{indexTable}
 	{
 
 	}
@@ -88,6 +105,7 @@ public:
 	 *
 	 * \return 0 on success, error code otherwise:
 	 * - EINVAL - \a signalNumber value is invalid;
+	 * - error codes returned by architecture::requestFunctionExecution() - signal remains pending;
 	 */
 
 	int postGenerate(uint8_t signalNumber, const scheduler::ThreadControlBlock& threadControlBlock) const;
@@ -130,9 +148,22 @@ private:
 
 	SignalAction clearAssociation(uint8_t signalNumber);
 
+	/**
+	 * \brief Finds Association for given signal number.
+	 *
+	 * \param [in] signalNumber is the signal for which the association will be searched, [0; 31]
+	 *
+	 * \return pointer to found Association object, \a associationsEnd_ if no match was found
+	 */
+
+	Association* findAssociation(uint8_t signalNumber) const;
+
 	/// SignalSet with signal mask for associated thread
 	SignalSet signalMask_;
 
+	/// set of signal numbers which have associations
+	SignalSet::Bitset associatedBitset_;
+
 	/// pointer to first element of range of Association objects
 	Association* associationsBegin_;
 
@@ -148,6 +179,9 @@ private:
 
 	/// pointer to "one past the last" element of range of Storage objects
 	Storage* storageEnd_;
+
+	/// pointer to IndexTable used for direct indexing of Association objects, nullptr if linear search is used
+	IndexTable* indexTable_;
 };
 
 }	// namespace synchronization
@@ -0,0 +1,128 @@
+/**
+ * \file
+ * \brief WaitSetObserver class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#ifndef INCLUDE_DISTORTOS_SYNCHRONIZATION_WAITSETOBSERVER_HPP_
+#define INCLUDE_DISTORTOS_SYNCHRONIZATION_WAITSETOBSERVER_HPP_
+
+namespace distortos
+{
+
+class Semaphore;
+
+namespace scheduler
+{
+
+class ThreadControlBlock;
+
+}	// namespace scheduler
+
+namespace synchronization
+{
+
+/**
+ * \brief WaitSetObserver class is an element of intrusive list of observers of a Semaphore, used by WaitSet.
+ *
+ * While the thread waits on WaitSet, one WaitSetObserver for each registered semaphore is linked into the list of that
+ * semaphore. Semaphore::post() which makes the semaphore "ready" (its value changes from zero) notifies all linked
+ * observers.
+ */
+
+class WaitSetObserver
+{
+public:
+
+	/**
+	 * \brief WaitSetObserver's constructor
+	 */
+
+	constexpr WaitSetObserver() :
+			semaphore_{},
+			next_{},
+			threadControlBlock_{}
+	{
+
+	}
+
+	/**
+	 * \return pointer to observed semaphore
+	 */
+
+	Semaphore* getSemaphore() const
+	{
+		return semaphore_;
+	}
+
+	/**
+	 * \return pointer to next observer on the list, nullptr if this is the last element
+	 */
+
+	WaitSetObserver* getNext() const
+	{
+		return next_;
+	}
+
+	/**
+	 * \brief Unblocks associated thread if it is waiting on WaitSet.
+	 *
+	 * \attention This function must be called with interrupt masking enabled.
+	 *
+	 * \param [in] inContextSwitch selects whether this function is called while processing deferred requests in
+	 * Scheduler::switchContext() (true - context switch is not requested) or not (false), default - false
+	 */
+
+	void notify(bool inContextSwitch = {}) const;
+
+	/**
+	 * \param [in] next is a pointer to next observer on the list, nullptr if this is the last element
+	 */
+
+	void setNext(WaitSetObserver* const next)
+	{
+		next_ = next;
+	}
+
+	/**
+	 * \param [in] semaphore is a reference to observed semaphore
+	 */
+
+	void setSemaphore(Semaphore& semaphore)
+	{
+		semaphore_ = &semaphore;
+	}
+
+	/**
+	 * \param [in] threadControlBlock is a pointer to ThreadControlBlock of thread waiting on WaitSet
+	 */
+
+	void setThreadControlBlock(scheduler::ThreadControlBlock* const threadControlBlock)
+	{
+		threadControlBlock_ = threadControlBlock;
+	}
+
+private:
+
+	/// pointer to observed semaphore
+	Semaphore* semaphore_;
+
+	/// pointer to next observer on the list, nullptr if this is the last element
+	WaitSetObserver* next_;
+
+	/// pointer to ThreadControlBlock of thread waiting on WaitSet, valid only when this observer is linked
+	scheduler::ThreadControlBlock* threadControlBlock_;
+};
+
+}	// namespace synchronization
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_SYNCHRONIZATION_WAITSETOBSERVER_HPP_
@@ -0,0 +1,91 @@
+/**
+ * \file
+ * \brief waitOnAddress() and wakeAddress() header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-28
+ */
+
+#ifndef INCLUDE_DISTORTOS_WAITONADDRESS_HPP_
+#define INCLUDE_DISTORTOS_WAITONADDRESS_HPP_
+
+#include "distortos/TickClock.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief Tries to wait on address until given time point.
+ *
+ * Futex-like primitive for building synchronization objects whose fast path is done entirely with atomic operations
+ * on a 32-bit word - kernel is entered only to sleep and to wake sleeping threads. If value of the word is equal to
+ * \a expected, calling thread is blocked until wakeAddress() is called for the same address or until the timeout
+ * expires. Comparison and blocking are done atomically with regard to wakeAddress().
+ *
+ * Waiting threads are kept in a hashed table of wait queues (with CONFIG_WAIT_ON_ADDRESS_BUCKETS buckets), each
+ * sorted by priority, so no memory is associated with the address itself.
+ *
+ * \param [in] address is a pointer to 32-bit word on which the calling thread will wait
+ * \param [in] expected is the expected value of the word
+ * \param [in] timePoint is the time point at which the wait will be terminated
+ *
+ * \return 0 if the thread was woken with wakeAddress(), error code otherwise:
+ * - EAGAIN - value of the word was not equal to \a expected;
+ * - ETIMEDOUT - the thread was not woken before specified \a timePoint;
+ */
+
+int tryWaitOnAddressUntil(const volatile uint32_t* address, uint32_t expected, TickClock::time_point timePoint);
+
+/**
+ * \brief Tries to wait on address for given duration of time.
+ *
+ * Same as tryWaitOnAddressUntil(), but with relative timeout.
+ *
+ * \param [in] address is a pointer to 32-bit word on which the calling thread will wait
+ * \param [in] expected is the expected value of the word
+ * \param [in] duration is the duration after which the wait will be terminated
+ *
+ * \return 0 if the thread was woken with wakeAddress(), error code otherwise:
+ * - EAGAIN - value of the word was not equal to \a expected;
+ * - ETIMEDOUT - the thread was not woken before the specified timeout expired;
+ */
+
+int tryWaitOnAddressFor(const volatile uint32_t* address, uint32_t expected, TickClock::duration duration);
+
+/**
+ * \brief Waits on address.
+ *
+ * Same as tryWaitOnAddressUntil(), but without timeout.
+ *
+ * \param [in] address is a pointer to 32-bit word on which the calling thread will wait
+ * \param [in] expected is the expected value of the word
+ *
+ * \return 0 if the thread was woken with wakeAddress(), error code otherwise:
+ * - EAGAIN - value of the word was not equal to \a expected;
+ */
+
+int waitOnAddress(const volatile uint32_t* address, uint32_t expected);
+
+/**
+ * \brief Wakes threads waiting on address.
+ *
+ * Threads are woken in priority order (FIFO among threads with the same priority).
+ *
+ * \note This function may be called from interrupt context.
+ *
+ * \param [in] address is a pointer to 32-bit word on which the threads are waiting
+ * \param [in] count is the max number of threads that will be woken, SIZE_MAX to wake all
+ *
+ * \return number of woken threads
+ */
+
+size_t wakeAddress(const volatile uint32_t* address, size_t count);
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_WAITONADDRESS_HPP_
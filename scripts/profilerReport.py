@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+#
+# file: profilerReport.py
+#
+# author: Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+#
+# This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+# distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+#
+# date: 2015-05-23
+#
+
+"""Converts samples of distortos sampling profiler to per-thread flat profiles.
+
+Input file contains one sample per line - program counter and address of ThreadBase object of interrupted thread (0 for
+interrupt handlers), both as hexadecimal numbers separated with whitespace, for example:
+
+	0x08001234 0x20000560
+
+Such lines can be produced by the application from samples read with distortos::profiler::readSamples() or dumped from
+the target with debugger. Program counters are mapped to functions with symbols read from the ELF file (with nm from
+the toolchain, arm-none-eabi-nm by default).
+"""
+
+import argparse
+import bisect
+import collections
+import subprocess
+import sys
+
+def readSymbols(nm, elf):
+	"""Returns sorted list of (address, size, name) tuples with function symbols from ELF file."""
+	output = subprocess.check_output([nm, '--demangle', '--numeric-sort', '--print-size', '--defined-only', elf],
+			universal_newlines=True)
+	symbols = []
+	for line in output.splitlines():
+		fields = line.split(None, 3)
+		if len(fields) != 4 or fields[2] not in ('T', 't', 'W', 'w'):
+			continue
+		# clear "Thumb" bit of function address
+		symbols.append((int(fields[0], 16) & ~1, int(fields[1], 16), fields[3]))
+	symbols.sort()
+	return symbols
+
+def findSymbol(symbols, addresses, programCounter):
+	"""Returns name of function containing programCounter, or hexadecimal program counter if it is unknown."""
+	index = bisect.bisect_right(addresses, programCounter) - 1
+	if index >= 0:
+		address, size, name = symbols[index]
+		if programCounter < address + size:
+			return name
+	return '0x{:08x}'.format(programCounter)
+
+def readSamples(inputFile):
+	"""Returns list of (programCounter, thread) tuples read from inputFile."""
+	samples = []
+	for line in inputFile:
+		fields = line.split()
+		if len(fields) != 2:
+			continue
+		samples.append((int(fields[0], 16), int(fields[1], 16)))
+	return samples
+
+def main():
+	parser = argparse.ArgumentParser(description = 'Converts samples of distortos sampling profiler to per-thread flat '
+			'profiles.')
+	parser.add_argument('elf', help = 'ELF file of the application')
+	parser.add_argument('samples', nargs = '?', type = argparse.FileType('r'), default = sys.stdin,
+			help = 'file with samples, standard input by default')
+	parser.add_argument('--nm', default = 'arm-none-eabi-nm', help = 'nm executable, default: %(default)s')
+	arguments = parser.parse_args()
+
+	symbols = readSymbols(arguments.nm, arguments.elf)
+	addresses = [symbol[0] for symbol in symbols]
+	samples = readSamples(arguments.samples)
+
+	profiles = collections.defaultdict(collections.Counter)
+	for programCounter, thread in samples:
+		profiles[thread][findSymbol(symbols, addresses, programCounter)] += 1
+
+	for thread, profile in sorted(profiles.items()):
+		threadSamples = sum(profile.values())
+		print('{} - {} samples ({:.1f}% of all)'.format('interrupts' if thread == 0 else 'thread 0x{:08x}'.format(thread),
+				threadSamples, 100.0 * threadSamples / len(samples)))
+		for name, count in profile.most_common():
+			print('\t{:8} {:6.1f}%  {}'.format(count, 100.0 * count / threadSamples, name))
+
+if __name__ == '__main__':
+	main()
@@ -8,12 +8,16 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-03-19
+ * \date 2015-05-30
  */
 
 #include "distortos/scheduler/getScheduler.hpp"
 #include "distortos/scheduler/Scheduler.hpp"
 
+#include "distortos/architecture/injectRequestedFunction.hpp"
+
+#include "distortos/distortosConfiguration.h"
+
 #include "distortos/chip/CMSIS-proxy.h"
 
 
@@ -24,6 +28,8 @@
 /**
  * \brief Wrapper for void* distortos::scheduler::getScheduler().switchContext(void*)
  *
+ * Before the switch, call of function requested from interrupt context is injected into context of current thread.
+ *
  * \param [in] stackPointer is the current value of current thread's stack pointer
  *
  * \return new thread's stack pointer
@@ -31,7 +37,15 @@
 
 extern "C" void* schedulerSwitchContextWrapper(void* const stackPointer)
 {
-	return distortos::scheduler::getScheduler().switchContext(stackPointer);
+#if CONFIG_IDLE_SLEEP == 1 && CONFIG_ARCHITECTURE_ARMV7_M_IDLE_SLEEP_ON_EXIT == 1
+
+	// "sleep-on-exit" is set by idle thread before going to sleep, it must not affect other threads
+	SCB->SCR &= ~SCB_SCR_SLEEPONEXIT_Msk;
+
+#endif	// CONFIG_IDLE_SLEEP == 1 && CONFIG_ARCHITECTURE_ARMV7_M_IDLE_SLEEP_ON_EXIT == 1
+
+	const auto newStackPointer = distortos::architecture::injectRequestedFunction(stackPointer);
+	return distortos::scheduler::getScheduler().switchContext(newStackPointer);
 }
 
 /**
@@ -0,0 +1,61 @@
+/**
+ * \file
+ * \brief SVC_Handler() for ARMv7-M (Cortex-M3 / Cortex-M4)
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#include "distortos/chip/CMSIS-proxy.h"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief SVC_Handler() for ARMv7-M (Cortex-M3 / Cortex-M4)
+ *
+ * Restores context of thread which was saved by PendSV_Handler() before call of function was injected into it by
+ * requestFunctionExecution(). Stack pointer of saved context is passed in r0 by the trampoline, which is the only user
+ * of "svc" instruction. Current exception frame (created by the trampoline's "svc") is discarded.
+ *
+ * If floating-point was used by the trampoline, space for its s0-s15 and FPSCR was reserved in the discarded frame by
+ * lazy stacking - FPCCR.LSPACT is set and FPCAR points into that frame. As the exception returns with EXC_RETURN of
+ * restored context, the hardware wouldn't clear LSPACT and next floating-point instruction of the thread would save
+ * these registers into the discarded area of stack, which may be already used again. Lazy state preservation is
+ * therefore cancelled by clearing LSPACT - the floating-point registers of the trampoline are not needed.
+ */
+
+extern "C" __attribute__ ((naked)) void SVC_Handler()
+{
+	asm volatile
+	(
+			"	mrs			r0, PSP							\n"
+			"	ldr			r0, [r0]						\n"	// stacked r0 - saved stack pointer
+			"												\n"
+#if __FPU_PRESENT == 1 && __FPU_USED == 1
+			"	movw		r1, #0xef34						\n"	// r1 = &FPU->FPCCR (0xe000ef34)
+			"	movt		r1, #0xe000						\n"
+			"	ldr			r2, [r1]						\n"
+			"	bic			r2, r2, #1						\n"	// clear FPCCR.LSPACT
+			"	str			r2, [r1]						\n"
+			"												\n"
+			"	ldmia		r0!, {r4-r11, lr}				\n"	// load "regular" context of thread
+			"	tst			lr, #(1 << 4)					\n"	// was floating-point used by the thread?
+			"	it			eq								\n"
+			"	vldmiaeq	r0!, {s16-s31}					\n"	// load "floating-point" context of thread
+#else
+			"	ldmia		r0!, {r4-r11}					\n"	// load context of thread
+#endif	// __FPU_PRESENT == 1 && __FPU_USED == 1
+			"	msr			PSP, r0							\n"
+			"												\n"
+			"	bx			lr								\n"	// return to thread
+	);
+
+	__builtin_unreachable();
+}
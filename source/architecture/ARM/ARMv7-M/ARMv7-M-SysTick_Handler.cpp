@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-04-28
+ * \date 2015-05-23
  */
 
 #include "distortos/scheduler/getScheduler.hpp"
@@ -16,10 +16,66 @@
 
 #include "distortos/architecture/requestContextSwitch.hpp"
 
+#include "distortos/profiler.hpp"
+
+#include <cstdint>
+
+#if CONFIG_SAMPLING_PROFILER == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Implementation of SysTick_Handler() with sampling profiler
+ *
+ * \param [in] stackFrame is a pointer to exception stack frame of interrupted code
+ * \param [in] excReturn is the EXC_RETURN value of this exception
+ */
+
+extern "C" void sysTickHandlerImplementation(const uint32_t* const stackFrame, const uint32_t excReturn)
+{
+	// stacked PC is the 7th word of both basic and extended (with floating-point context) exception stack frame, bit 2
+	// of EXC_RETURN is set when process stack was used - so thread was interrupted
+	distortos::profiler::sample(stackFrame[6], (excReturn & (1 << 2)) != 0);
+
+	const auto contextSwitchRequired = distortos::scheduler::getScheduler().tickInterruptHandler();
+	if (contextSwitchRequired == true)
+		distortos::architecture::requestContextSwitch();
+}
+
+#endif	// CONFIG_SAMPLING_PROFILER == 1
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | global functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
+#if CONFIG_SAMPLING_PROFILER == 1
+
+/**
+ * \brief SysTick_Handler() for ARMv7-M (Cortex-M3 / Cortex-M4)
+ *
+ * Tick interrupt of scheduler. Passes the address of exception stack frame of interrupted code (from the stack that was
+ * active before the exception) to sysTickHandlerImplementation(), which records a sample for sampling profiler.
+ */
+
+extern "C" __attribute__ ((naked)) void SysTick_Handler()
+{
+	asm volatile
+	(
+			"	tst			lr, #(1 << 2)					\n"	// was process stack used?
+			"	ite			eq								\n"
+			"	mrseq		r0, MSP							\n"
+			"	mrsne		r0, PSP							\n"
+			"	mov			r1, lr							\n"
+			"	b			sysTickHandlerImplementation	\n"	// returns directly to interrupted code
+	);
+
+	__builtin_unreachable();
+}
+
+#else
+
 /**
  * \brief SysTick_Handler() for ARMv7-M (Cortex-M3 / Cortex-M4)
  *
@@ -32,3 +88,5 @@ extern "C" void SysTick_Handler()
 	if (contextSwitchRequired == true)
 		distortos::architecture::requestContextSwitch();
 }
+
+#endif	// CONFIG_SAMPLING_PROFILER == 1
@@ -0,0 +1,45 @@
+/**
+ * \file
+ * \brief getTickTimerCounter() implementation for ARMv7-M (Cortex-M3 / Cortex-M4)
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#include "distortos/architecture/getTickTimerCounter.hpp"
+
+#include "distortos/chip/CMSIS-proxy.h"
+
+namespace distortos
+{
+
+namespace architecture
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+uint32_t getTickTimerCounter()
+{
+	// SysTick counts down from LOAD to 0, the interrupt is pended when the counter is reloaded
+	const auto load = SysTick->LOAD;
+	const auto value = SysTick->VAL;
+
+	if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) == 0)	// no pending "tick"?
+		return load - value;
+
+	// the counter may have been reloaded after it was read above, so it must be read again - now it surely has a value
+	// from after the reload; this compensation doesn't work when SysTick_Handler() is already active, but didn't
+	// increment tick count yet - see the warning in getTickTimerCounter() description
+	return load + 1 + load - SysTick->VAL;
+}
+
+}	// namespace architecture
+
+}	// namespace distortos
@@ -0,0 +1,35 @@
+/**
+ * \file
+ * \brief isInInterruptContext() implementation for ARMv7-M (Cortex-M3 / Cortex-M4)
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-29
+ */
+
+#include "distortos/architecture/isInInterruptContext.hpp"
+
+#include "distortos/chip/CMSIS-proxy.h"
+
+namespace distortos
+{
+
+namespace architecture
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool isInInterruptContext()
+{
+	return __get_IPSR() != 0;
+}
+
+}	// namespace architecture
+
+}	// namespace distortos
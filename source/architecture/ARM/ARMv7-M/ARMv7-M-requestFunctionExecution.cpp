@@ -8,35 +8,291 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-04-28
+ * \date 2015-06-04
  */
 
 #include "distortos/architecture/requestFunctionExecution.hpp"
+#include "distortos/architecture/injectRequestedFunction.hpp"
 
 #include "distortos/chip/CMSIS-proxy.h"
 
 #include "distortos/scheduler/Scheduler.hpp"
 #include "distortos/scheduler/getScheduler.hpp"
 
+#include "distortos/architecture/InterruptMaskingLock.hpp"
+#include "distortos/architecture/parameters.hpp"
+#include "distortos/architecture/requestContextSwitch.hpp"
+
+#include <cerrno>
+
 namespace distortos
 {
 
 namespace architecture
 {
 
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// type of single element of stack
+using StackElement = uint32_t;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+#if __FPU_PRESENT == 1 && __FPU_USED == 1
+
+/// max size of software stack frame saved by PendSV_Handler() (r4-r11, lr and s16-s31), bytes
+constexpr size_t maxSoftwareStackFrameSize {(8 + 1 + 16) * sizeof(StackElement)};
+
+/// size of stack frame created by injectFunctionCall() (with worst-case alignment), bytes
+constexpr size_t injectedStackFrameSize {(8 + 1 + 8) * sizeof(StackElement) + stackAlignment};
+
+#else
+
+/// max size of software stack frame saved by PendSV_Handler() (r4-r11), bytes
+constexpr size_t maxSoftwareStackFrameSize {8 * sizeof(StackElement)};
+
+/// size of stack frame created by injectFunctionCall() (with worst-case alignment), bytes
+constexpr size_t injectedStackFrameSize {(8 + 8) * sizeof(StackElement) + stackAlignment};
+
+#endif	// __FPU_PRESENT == 1 && __FPU_USED == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// function which should be executed in current thread, requested from interrupt context, nullptr if there's no request
+void (* requestedFunction)();
+
+/// pointer to ThreadControlBlock of thread in which \a requestedFunction should be executed
+const scheduler::ThreadControlBlock* requestedFunctionThreadControlBlock;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Trampoline for function which was injected into thread's context.
+ *
+ * Executes the function and restores thread's context which was saved before the injection - this is done by
+ * SVC_Handler(), which gets the saved stack pointer in r0.
+ *
+ * If the thread was blocked when the call was injected, the function is executed after the thread is unblocked, but
+ * before the interrupted wait reads the reason of unblocking. The function may block the thread again (for example by
+ * sleeping), which would overwrite this reason, so it is saved before the function is executed and restored afterwards.
+ *
+ * \param [in] function is a reference to function that should be executed
+ * \param [in] savedStackPointer is the value of thread's stack pointer before the injection
+ */
+
+__attribute__ ((noreturn)) void functionTrampoline(void (& function)(), void* const savedStackPointer)
+{
+	auto& threadControlBlock = scheduler::getScheduler().getCurrentThreadControlBlock();
+	const auto unblockReason = threadControlBlock.getUnblockReason();
+
+	function();
+
+	threadControlBlock.setUnblockReason(unblockReason);
+
+	asm volatile
+	(
+			"	mov			r0, %[savedStackPointer]		\n"
+			"	svc			0								\n"	// restore saved context
+			:: [savedStackPointer] "r" (savedStackPointer)
+			: "r0"
+	);
+
+	__builtin_unreachable();
+}
+
+/**
+ * \brief Checks whether call of function is already injected on top of thread's saved context.
+ *
+ * \param [in] stackPointer is the value of thread's stack pointer, its whole context must be saved on the stack
+ * \param [in] function is a reference to function that should be executed
+ *
+ * \return true if call of \a function via functionTrampoline() is the first thing the thread will execute, false
+ * otherwise
+ */
+
+bool isFunctionInjected(const void* const stackPointer, void (& function)())
+{
+	auto frame = static_cast<const StackElement*>(stackPointer);
+
+#if __FPU_PRESENT == 1 && __FPU_USED == 1
+	const auto exceptionReturn = frame[8];
+	frame += 9;	// r4-r11 and lr
+	if ((exceptionReturn & (1 << 4)) == 0)	// was floating-point used by the thread?
+		frame += 16;	// s16-s31
+#else
+	frame += 8;	// r4-r11
+#endif	// __FPU_PRESENT == 1 && __FPU_USED == 1
+
+	return frame[6] == reinterpret_cast<StackElement>(&functionTrampoline) &&	// pc
+			frame[0] == reinterpret_cast<StackElement>(&function);				// r0
+}
+
+/**
+ * \brief Checks whether there is enough free space in thread's stack.
+ *
+ * \param [in] stack is a reference to thread's stack
+ * \param [in] stackPointer is the value of thread's stack pointer
+ * \param [in] size is the required size of free space, bytes
+ *
+ * \return true if there are at least \a size bytes between \a stackPointer and the beginning of \a stack, false
+ * otherwise
+ */
+
+bool isEnoughSpace(const Stack& stack, const void* const stackPointer, const size_t size)
+{
+	const auto bufferAddress = reinterpret_cast<uintptr_t>(stack.getAdjustedBuffer());
+	const auto stackPointerAddress = reinterpret_cast<uintptr_t>(stackPointer);
+	return stackPointerAddress >= bufferAddress && stackPointerAddress - bufferAddress >= size;
+}
+
+/**
+ * \brief Injects call of function into thread's saved context.
+ *
+ * New context - which executes functionTrampoline() - is created below saved context, in the same form that is
+ * created by initializeStack(). Previous context is restored after the function returns. If the same call is already
+ * injected (the thread was not scheduled since previous request), nothing is done - this way stack usage doesn't grow
+ * with the number of requests.
+ *
+ * \attention The caller must ensure that there are at least injectedStackFrameSize bytes of free space below
+ * \a stackPointer.
+ *
+ * \param [in] stackPointer is the value of thread's stack pointer, its whole context must be saved on the stack
+ * \param [in] function is a reference to function that should be executed
+ *
+ * \return new value of thread's stack pointer
+ */
+
+void* injectFunctionCall(void* const stackPointer, void (& function)())
+{
+	if (isFunctionInjected(stackPointer, function) == true)
+		return stackPointer;
+
+	// software stack frame saved by PendSV_Handler() is not necessarily aligned, trampoline must get aligned stack
+	auto newStackPointer = reinterpret_cast<StackElement*>(reinterpret_cast<uintptr_t>(stackPointer) &
+			~(uintptr_t{stackAlignment} - 1));
+
+	*--newStackPointer = 0x01000000;												// xPSR
+	*--newStackPointer = reinterpret_cast<StackElement>(&functionTrampoline);		// pc
+	*--newStackPointer = 0;															// lr
+	*--newStackPointer = 0xcccccccc;												// r12
+	*--newStackPointer = 0x33333333;												// r3
+	*--newStackPointer = 0x22222222;												// r2
+	*--newStackPointer = reinterpret_cast<StackElement>(stackPointer);				// r1
+	*--newStackPointer = reinterpret_cast<StackElement>(&function);				// r0
+#if __FPU_PRESENT == 1 && __FPU_USED == 1
+	*--newStackPointer = 0xfffffffd;												// lr
+#endif	// __FPU_PRESENT == 1 && __FPU_USED == 1
+	*--newStackPointer = 0xbbbbbbbb;												// r11
+	*--newStackPointer = 0xaaaaaaaa;												// r10
+	*--newStackPointer = 0x99999999;												// r9
+	*--newStackPointer = 0x88888888;												// r8
+	*--newStackPointer = 0x77777777;												// r7
+	*--newStackPointer = 0x66666666;												// r6
+	*--newStackPointer = 0x55555555;												// r5
+	*--newStackPointer = 0x44444444;												// r4
+
+	return newStackPointer;
+}
+
+/**
+ * \brief Injects call of function into context of non-current thread.
+ *
+ * \param [in] threadControlBlock is a reference to scheduler::ThreadControlBlock of non-current thread
+ * \param [in] function is a reference to function that should be executed
+ *
+ * \return 0 on success, error code otherwise:
+ * - ENOSPC - there is not enough free space in the stack of the thread to inject the call of function;
+ */
+
+int injectFunctionCall(const scheduler::ThreadControlBlock& threadControlBlock, void (& function)())
+{
+	// stack pointer of the thread is modified, but the thread itself is not
+	auto& stack = const_cast<scheduler::ThreadControlBlock&>(threadControlBlock).getStack();
+	const auto stackPointer = stack.getStackPointer();
+	if (isFunctionInjected(stackPointer, function) == true)
+		return 0;
+
+	if (isEnoughSpace(stack, stackPointer, injectedStackFrameSize) == false)
+		return ENOSPC;
+
+	stack.setStackPointer(injectFunctionCall(stackPointer, function));
+	return 0;
+}
+
+}	// namespace
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | global functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
-void requestFunctionExecution(const scheduler::ThreadControlBlock& threadControlBlock, void (& function)())
+void* injectRequestedFunction(void* const stackPointer)
+{
+	InterruptMaskingLock interruptMaskingLock;
+
+	if (requestedFunction == nullptr)
+		return stackPointer;
+
+	auto& function = *requestedFunction;
+	requestedFunction = nullptr;
+
+	// thread may be already switched out if the request was made while PendSV_Handler() was switching contexts; the
+	// space in the stack was checked by requestFunctionExecution() for the worst case, so injection cannot fail
+	if (requestedFunctionThreadControlBlock != &scheduler::getScheduler().getCurrentThreadControlBlock())
+	{
+		injectFunctionCall(*requestedFunctionThreadControlBlock, function);
+		return stackPointer;
+	}
+
+	return injectFunctionCall(stackPointer, function);
+}
+
+int requestFunctionExecution(const scheduler::ThreadControlBlock& threadControlBlock, void (& function)())
 {
 	const auto& currentThreadControlBlock = scheduler::getScheduler().getCurrentThreadControlBlock();
 	if (&threadControlBlock == &currentThreadControlBlock)	// request to current thread?
 	{
 		const auto inInterrupt = __get_IPSR() != 0;
 		if (inInterrupt == false)	// current thread is sending the request to itself?
+		{
 			function();				// execute function right away
+			return 0;
+		}
+
+		// interrupt is sending the request to current thread - its context is not saved yet, so the call will be
+		// injected by PendSV_Handler()
+		InterruptMaskingLock interruptMaskingLock;
+
+		// there's only one slot for such request - the same request is satisfied by the pending one
+		if (requestedFunction != nullptr)
+			return requestedFunction == &function && requestedFunctionThreadControlBlock == &threadControlBlock ? 0 :
+					EBUSY;
+
+		// hardware stack frame is already on the stack, software stack frame will be saved by PendSV_Handler()
+		const auto& stack = const_cast<scheduler::ThreadControlBlock&>(threadControlBlock).getStack();
+		if (isEnoughSpace(stack, reinterpret_cast<const void*>(__get_PSP()),
+				maxSoftwareStackFrameSize + injectedStackFrameSize) == false)
+			return ENOSPC;
+
+		requestedFunction = &function;
+		requestedFunctionThreadControlBlock = &threadControlBlock;
+		requestContextSwitch();
+		return 0;
 	}
+
+	// current thread or interrupt is sending the request to non-current thread - its context is saved on its stack
+	InterruptMaskingLock interruptMaskingLock;
+	return injectFunctionCall(threadControlBlock, function);
 }
 
 }	// namespace architecture
@@ -0,0 +1,52 @@
+/**
+ * \file
+ * \brief sleep() implementation for ARMv7-M (Cortex-M3 / Cortex-M4)
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-21
+ */
+
+#include "distortos/architecture/sleep.hpp"
+
+#include "distortos/distortosConfiguration.h"
+
+#include "distortos/chip/CMSIS-proxy.h"
+
+namespace distortos
+{
+
+namespace architecture
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void sleep()
+{
+#if CONFIG_ARCHITECTURE_ARMV7_M_IDLE_SLEEP_ON_EXIT == 1
+
+	// the flag is cleared by PendSV_Handler() during each context switch, so only returns to idle thread are affected
+	SCB->SCR |= SCB_SCR_SLEEPONEXIT_Msk;
+
+#endif	// CONFIG_ARCHITECTURE_ARMV7_M_IDLE_SLEEP_ON_EXIT == 1
+
+#if CONFIG_ARCHITECTURE_ARMV7_M_IDLE_WAIT_FOR_EVENT == 1
+
+	__WFE();
+
+#else
+
+	__WFI();
+
+#endif	// CONFIG_ARCHITECTURE_ARMV7_M_IDLE_WAIT_FOR_EVENT == 1
+}
+
+}	// namespace architecture
+
+}	// namespace distortos
@@ -0,0 +1,41 @@
+/**
+ * \file
+ * \brief injectRequestedFunction() declaration
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-30
+ */
+
+#ifndef SOURCE_ARCHITECTURE_ARM_ARMV7_M_INCLUDE_DISTORTOS_ARCHITECTURE_INJECTREQUESTEDFUNCTION_HPP_
+#define SOURCE_ARCHITECTURE_ARM_ARMV7_M_INCLUDE_DISTORTOS_ARCHITECTURE_INJECTREQUESTEDFUNCTION_HPP_
+
+namespace distortos
+{
+
+namespace architecture
+{
+
+/**
+ * \brief Injects call of function requested from interrupt context into context of current thread.
+ *
+ * Interrupt cannot modify context of current thread, because it is not saved yet - requestFunctionExecution() only
+ * records such request and pends PendSV. This function is called by PendSV_Handler() after the context of current
+ * thread is saved and before the scheduler chooses next thread.
+ *
+ * \param [in] stackPointer is the current value of current thread's stack pointer
+ *
+ * \return new value of current thread's stack pointer
+ */
+
+void* injectRequestedFunction(void* stackPointer);
+
+}	// namespace architecture
+
+}	// namespace distortos
+
+#endif	// SOURCE_ARCHITECTURE_ARM_ARMV7_M_INCLUDE_DISTORTOS_ARCHITECTURE_INJECTREQUESTEDFUNCTION_HPP_
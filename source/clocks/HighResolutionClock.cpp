@@ -0,0 +1,63 @@
+/**
+ * \file
+ * \brief HighResolutionClock class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#include "distortos/HighResolutionClock.hpp"
+
+#include "distortos/scheduler/getScheduler.hpp"
+#include "distortos/scheduler/Scheduler.hpp"
+
+#include "distortos/architecture/getTickTimerCounter.hpp"
+#include "distortos/architecture/InterruptMaskingLock.hpp"
+
+namespace distortos
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// number of tick timer's clock cycles in one tick
+constexpr HighResolutionClock::rep cyclesPerTick {CONFIG_TICK_CLOCK / CONFIG_TICK_RATE_HZ};
+
+static_assert(CONFIG_TICK_CLOCK % CONFIG_TICK_RATE_HZ == 0,
+		"CONFIG_TICK_CLOCK must be an integer multiple of CONFIG_TICK_RATE_HZ!");
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public static functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+HighResolutionClock::time_point HighResolutionClock::now()
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	// last value returned by this function, modified only with interrupt masking enabled
+	static rep lastValue;
+
+	const auto tickCount = scheduler::getScheduler().getTickCount();
+	const auto tickTimerCounter = architecture::getTickTimerCounter();
+	const auto value = tickCount * cyclesPerTick + tickTimerCounter;
+
+	// when called from interrupt which preempted "tick" interrupt before tick count was incremented, the value is one
+	// "tick" behind - the clock just stops until the tick count is incremented, it never goes backwards
+	if (value > lastValue)
+		lastValue = value;
+
+	return time_point{duration{lastValue}};
+}
+
+}	// namespace distortos
@@ -0,0 +1,77 @@
+/**
+ * \file
+ * \brief DeferredRequestQueue class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#include "distortos/scheduler/DeferredRequestQueue.hpp"
+
+#if CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+#include "distortos/Semaphore.hpp"
+
+#include "distortos/scheduler/getScheduler.hpp"
+#include "distortos/scheduler/Scheduler.hpp"
+
+#include "distortos/architecture/requestContextSwitch.hpp"
+
+namespace distortos
+{
+
+namespace scheduler
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void DeferredRequestQueue::process()
+{
+	while (1)
+	{
+		auto& slot = slots_[readIndex_ % maxRequests_];
+		const auto semaphore = __atomic_exchange_n(&slot, nullptr, __ATOMIC_ACQUIRE);
+		if (semaphore == nullptr)	// queue is empty or first request is not yet published?
+			return;
+
+		// slot is free again - it may be reserved by producer
+		__atomic_store_n(&readIndex_, readIndex_ + 1, __ATOMIC_RELEASE);
+		semaphore->handOverValue(true);
+	}
+}
+
+bool DeferredRequestQueue::push(Semaphore& semaphore)
+{
+	auto& kernelCounters = getScheduler().getKernelCounters();
+
+	auto writeIndex = __atomic_load_n(&writeIndex_, __ATOMIC_RELAXED);
+	do
+	{
+		if (writeIndex - __atomic_load_n(&readIndex_, __ATOMIC_ACQUIRE) >= maxRequests_)	// queue is full?
+		{
+			__atomic_fetch_add(&kernelCounters.deferredRequestOverflows, 1, __ATOMIC_RELAXED);
+			return false;
+		}
+	} while (__atomic_compare_exchange_n(&writeIndex_, &writeIndex, writeIndex + 1, true, __ATOMIC_RELAXED,
+			__ATOMIC_RELAXED) == false);
+
+	__atomic_store_n(&slots_[writeIndex % maxRequests_], &semaphore, __ATOMIC_RELEASE);
+
+	__atomic_fetch_add(&kernelCounters.deferredRequests, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&kernelCounters.contextSwitchRequests, 1, __ATOMIC_RELAXED);
+	architecture::requestContextSwitch();
+	return true;
+}
+
+}	// namespace scheduler
+
+}	// namespace distortos
+
+#endif	// CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-04-28
+ * \date 2015-06-03
  */
 
 #include "distortos/scheduler/MainThread.hpp"
@@ -51,8 +51,9 @@ architecture::Stack stackWrapper(const std::pair<void*, size_t> stackBuffer)
 
 MainThread::MainThread(const uint8_t priority, ThreadGroupControlBlock& threadGroupControlBlock,
 		SignalsReceiver* const signalsReceiver) :
+		// main thread keeps using global _reent structure, which was already used before the scheduler was started
 		ThreadBase{stackWrapper(architecture::getMainStack()), priority, SchedulingPolicy::RoundRobin,
-				&threadGroupControlBlock, signalsReceiver}
+				&threadGroupControlBlock, signalsReceiver, nullptr}
 {
 
 }
@@ -0,0 +1,119 @@
+/**
+ * \file
+ * \brief ScheduleTable class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#include "distortos/ScheduleTable.hpp"
+
+#include "distortos/Semaphore.hpp"
+
+#include "distortos/scheduler/getScheduler.hpp"
+#include "distortos/scheduler/Scheduler.hpp"
+
+#include "distortos/architecture/InterruptMaskingLock.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| ScheduleTable::Entry private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void ScheduleTable::Entry::execute() const
+{
+	if (semaphore_ != nullptr)
+		semaphore_->post();
+	else if (function_ != nullptr)
+		function_();
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+ScheduleTable::~ScheduleTable()
+{
+	stop();
+}
+
+bool ScheduleTable::isActive() const
+{
+	return scheduler::getScheduler().getScheduleTable() == this;
+}
+
+int ScheduleTable::start(const TickClock::time_point timePoint)
+{
+	if (isValid(entries_, size_, majorFrame_) == false)
+		return EINVAL;
+
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	auto& scheduler = scheduler::getScheduler();
+	if (scheduler.getScheduleTable() != nullptr)
+		return EBUSY;
+
+	frameTimePoint_ = timePoint;
+	index_ = 0;
+	overrunCount_ = 0;
+	scheduler.setScheduleTable(this);
+	return 0;
+}
+
+int ScheduleTable::start()
+{
+	return start(TickClock::now() + TickClock::duration{1});
+}
+
+int ScheduleTable::stop()
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	auto& scheduler = scheduler::getScheduler();
+	if (scheduler.getScheduleTable() != this)
+		return EINVAL;
+
+	scheduler.setScheduleTable(nullptr);
+	return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void ScheduleTable::tickInterruptHandler(const TickClock::time_point timePoint)
+{
+	// skip whole missed major frames at once
+	if (frameTimePoint_ + majorFrame_ <= timePoint)
+	{
+		const auto frames = (timePoint - frameTimePoint_) / majorFrame_;
+		overrunCount_ += size_ - index_ + (frames - 1) * size_;
+		frameTimePoint_ += majorFrame_ * frames;
+		index_ = 0;
+	}
+
+	while (frameTimePoint_ + entries_[index_].getOffset() <= timePoint)
+	{
+		if (frameTimePoint_ + entries_[index_].getOffset() == timePoint)
+			entries_[index_].execute();
+		else
+			++overrunCount_;
+
+		if (++index_ == size_)
+		{
+			index_ = 0;
+			frameTimePoint_ += majorFrame_;
+		}
+	}
+}
+
+}	// namespace distortos
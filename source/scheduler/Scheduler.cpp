@@ -8,14 +8,15 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-04-28
+ * \date 2015-06-04
  */
 
 #include "distortos/scheduler/Scheduler.hpp"
 
-#include "distortos/SoftwareTimer.hpp"
 #include "distortos/scheduler/MainThread.hpp"
 
+#include "distortos/ScheduleTable.hpp"
+
 #include "distortos/architecture/InterruptMaskingLock.hpp"
 #include "distortos/architecture/InterruptUnmaskingLock.hpp"
 #include "distortos/architecture/requestContextSwitch.hpp"
@@ -35,14 +36,83 @@ namespace
 | local functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
+/**
+ * \brief Reads 64-bit counter without interrupt masking.
+ *
+ * The counter must be modified only from interrupt context. It is read twice, until both values are equal - if the read
+ * is interrupted by modification of the counter (possibly between halves of the value), the values differ and the read
+ * is repeated.
+ *
+ * \param [in] counter is a reference to counter which will be read
+ *
+ * \return consistent value of \a counter
+ */
+
+uint64_t readCounter(const uint64_t& counter)
+{
+	const volatile uint64_t& volatileCounter = counter;
+
+	while (1)
+	{
+		const uint64_t first = volatileCounter;
+		const uint64_t second = volatileCounter;
+		if (first == second)
+			return first;
+	}
+}
+
+/**
+ * \brief Gets counter of operations related to given type of wait object.
+ *
+ * \param [in] waitObjectCounters is a reference to set of counters
+ * \param [in] state is the state of thread which is blocked on the wait object
+ *
+ * \return reference to counter for wait object associated with \a state
+ */
+
+uint32_t& getWaitObjectCounter(statistics::WaitObjectCounters& waitObjectCounters,
+		const ThreadControlBlock::State state)
+{
+	using State = ThreadControlBlock::State;
+
+	switch (state)
+	{
+		case State::Sleeping:
+			return waitObjectCounters.sleep;
+		case State::BlockedOnSemaphore:
+			return waitObjectCounters.semaphore;
+		case State::BlockedOnMutex:
+			return waitObjectCounters.mutex;
+		case State::BlockedOnConditionVariable:
+			return waitObjectCounters.conditionVariable;
+		case State::WaitingForSignal:
+			return waitObjectCounters.signals;
+		case State::BlockedOnRwLock:
+			return waitObjectCounters.rwLock;
+		case State::WaitingForNotification:
+			return waitObjectCounters.notification;
+		case State::WaitingForWaitSet:
+			return waitObjectCounters.waitSet;
+		case State::BlockedOnChannel:
+			return waitObjectCounters.channel;
+		case State::WaitingForAddress:
+			return waitObjectCounters.address;
+		default:
+			return waitObjectCounters.other;
+	}
+}
+
 /**
  * \brief Forces unconditional context switch.
  *
  * Temporarily disables any interrupt masking and requests unconditional context switch.
+ *
+ * \param [in] kernelCounters is a reference to kernel event counters
  */
 
-void forceContextSwitch()
+void forceContextSwitch(statistics::KernelCounters& kernelCounters)
 {
+	++kernelCounters.contextSwitchRequests;
 	architecture::requestContextSwitch();
 	architecture::InterruptUnmaskingLock interruptUnmaskingLock;
 }
@@ -61,8 +131,16 @@ Scheduler::Scheduler() :
 		runnableList_{threadControlBlockListAllocator_, ThreadControlBlock::State::Runnable},
 		suspendedList_{threadControlBlockListAllocator_, ThreadControlBlock::State::Suspended},
 		softwareTimerControlBlockSupervisor_{},
+		timeoutListAllocatorPool_{},
+		timeoutListAllocator_{timeoutListAllocatorPool_},
+		timeoutList_{timeoutListAllocator_},
 		contextSwitchCount_{},
-		tickCount_{}
+		tickCount_{},
+		idleThreadControlBlock_{},
+		idleSwitchTimePoint_{},
+		idleTime_{},
+		kernelCounters_{},
+		scheduleTable_{}
 {
 
 }
@@ -99,7 +177,7 @@ int Scheduler::block(ThreadControlBlockList& container, const ThreadControlBlock
 			return 0;
 	}
 
-	forceContextSwitch();
+	forceContextSwitch(kernelCounters_);
 
 	const auto unblockReason = currentThreadControlBlock_->get().getUnblockReason();
 	return unblockReason == ThreadControlBlock::UnblockReason::UnblockRequest ? 0 : ETIMEDOUT;
@@ -108,49 +186,65 @@ int Scheduler::block(ThreadControlBlockList& container, const ThreadControlBlock
 int Scheduler::blockUntil(ThreadControlBlockList& container, const TickClock::time_point timePoint,
 		const ThreadControlBlock::UnblockFunctor* const unblockFunctor)
 {
-	architecture::InterruptMaskingLock interruptMaskingLock;
+	{
+		architecture::InterruptMaskingLock interruptMaskingLock;
+
+		const auto ret = blockInternal(container, currentThreadControlBlock_, unblockFunctor);
+		if (ret != 0)
+			return ret;
 
-	const auto iterator = currentThreadControlBlock_;
-	// This lambda unblocks the thread only if it wasn't already unblocked - this is necessary because double unblock
-	// should be avoided (it could mess the order of threads of the same priority). In that case it also sets
-	// UnblockReason::Timeout.
-	auto softwareTimer = makeSoftwareTimer([this, iterator]()
-			{
-				if (iterator->get().getList() != &runnableList_)
-					unblockInternal(iterator, ThreadControlBlock::UnblockReason::Timeout);
-			});
-	softwareTimer.start(timePoint);
-
-	return block(container, unblockFunctor);
+		// timeout is disarmed in unblockInternal(), so the thread will never be unblocked twice
+		auto& threadControlBlock = getCurrentThreadControlBlock();
+		threadControlBlock.setTimeoutTimePoint(timePoint);
+		timeoutListAllocatorPool_.feed(threadControlBlock.getTimeoutLink());
+		timeoutList_.sortedEmplace(threadControlBlock);
+	}
+
+	forceContextSwitch(kernelCounters_);
+
+	const auto unblockReason = currentThreadControlBlock_->get().getUnblockReason();
+	return unblockReason == ThreadControlBlock::UnblockReason::UnblockRequest ? 0 : ETIMEDOUT;
 }
 
 uint64_t Scheduler::getContextSwitchCount() const
+{
+	return readCounter(contextSwitchCount_);
+}
+
+HighResolutionClock::duration Scheduler::getIdleTime() const
 {
 	architecture::InterruptMaskingLock interruptMaskingLock;
-	return contextSwitchCount_;
+
+	if (&getCurrentThreadControlBlock() != idleThreadControlBlock_)
+		return idleTime_;
+
+	return idleTime_ + (HighResolutionClock::now() - idleSwitchTimePoint_);
 }
 
 uint64_t Scheduler::getTickCount() const
 {
-	architecture::InterruptMaskingLock interruptMaskingLock;
-	return tickCount_;
+	return readCounter(tickCount_);
 }
 
-int Scheduler::initialize(MainThread& mainThread)
+int Scheduler::initialize(MainThread& mainThread, ThreadControlBlock& idleThreadControlBlock)
 {
 	const auto ret = addInternal(mainThread.getThreadControlBlock());
 	if (ret != 0)
 		return ret;
 
 	currentThreadControlBlock_ = runnableList_.begin();
+	idleThreadControlBlock_ = &idleThreadControlBlock;
 
 	return 0;
 }
 
-void Scheduler::maybeRequestContextSwitch() const
+void Scheduler::maybeRequestContextSwitch()
 {
 	if (isContextSwitchRequired() == true)
+	{
+		++kernelCounters_.contextSwitchRequests;
 		architecture::requestContextSwitch();
+	}
 }
 
 int Scheduler::remove(void (ThreadBase::*terminationHook)())
@@ -166,7 +260,7 @@ int Scheduler::remove(void (ThreadBase::*terminationHook)())
 		(terminatedList.begin()->get().getOwner().*terminationHook)();
 	}
 
-	forceContextSwitch();
+	forceContextSwitch(kernelCounters_);
 
 	return 0;
 }
@@ -196,8 +290,31 @@ void* Scheduler::switchContext(void* const stackPointer)
 {
 	architecture::InterruptMaskingLock interruptMaskingLock;
 	++contextSwitchCount_;
+
+	const auto previousIsIdle = &getCurrentThreadControlBlock() == idleThreadControlBlock_;
+
 	getCurrentThreadControlBlock().getStack().setStackPointer(stackPointer);
+
+#if CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+	// requests deferred by interrupts may unblock threads, so they must be processed before choosing the next thread
+	deferredRequestQueue_.process();
+
+#endif	// CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
 	currentThreadControlBlock_ = runnableList_.begin();
+
+	// clock is read only when switching to or from idle thread, so switches between other threads are not slowed down
+	const auto nextIsIdle = &getCurrentThreadControlBlock() == idleThreadControlBlock_;
+	if (previousIsIdle != nextIsIdle)
+	{
+		const auto now = HighResolutionClock::now();
+		if (previousIsIdle == true)
+			idleTime_ += now - idleSwitchTimePoint_;
+		else
+			idleSwitchTimePoint_ = now;
+	}
+
 	getCurrentThreadControlBlock().switchedToHook();
 	return getCurrentThreadControlBlock().getStack().getStackPointer();
 }
@@ -221,9 +338,27 @@ bool Scheduler::tickInterruptHandler()
 		runnableList_.sortedSplice(runnableList_, currentThreadControlBlock_);
 	}
 
-	softwareTimerControlBlockSupervisor_.tickInterruptHandler(TickClock::time_point{TickClock::duration{tickCount_}});
+	const auto timePoint = TickClock::time_point{TickClock::duration{tickCount_}};
+
+	// entries of active schedule table are executed first, so time-triggered activities have minimal jitter
+	if (scheduleTable_ != nullptr)
+		scheduleTable_->tickInterruptHandler(timePoint);
+
+	softwareTimerControlBlockSupervisor_.tickInterruptHandler(timePoint);
+
+	// unblock all threads which reached their timeout time point - software timers are executed first, so objects
+	// made available at the same tick are not reported as timeouts
+	for (auto iterator = timeoutList_.begin();
+			iterator != timeoutList_.end() && iterator->get().getTimeoutTimePoint() <= timePoint;
+			iterator = timeoutList_.begin())
+		unblockInternal(iterator->get().getIterator(), ThreadControlBlock::UnblockReason::Timeout);
 
-	return isContextSwitchRequired();
+	// context switch is requested by the caller
+	const auto contextSwitchRequired = isContextSwitchRequired();
+	if (contextSwitchRequired == true)
+		++kernelCounters_.contextSwitchRequests;
+
+	return contextSwitchRequired;
 }
 
 void Scheduler::unblock(const ThreadControlBlockListIterator iterator)
@@ -234,6 +369,15 @@ void Scheduler::unblock(const ThreadControlBlockListIterator iterator)
 	maybeRequestContextSwitch();
 }
 
+void Scheduler::unblockAndSwitch(const ThreadControlBlockListIterator iterator)
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	unblockInternal(iterator);
+	yieldToInternal(iterator->get());
+	maybeRequestContextSwitch();
+}
+
 void Scheduler::yield()
 {
 	architecture::InterruptMaskingLock interruptMaskingLock;
@@ -242,6 +386,18 @@ void Scheduler::yield()
 	maybeRequestContextSwitch();
 }
 
+int Scheduler::yieldTo(ThreadControlBlock& threadControlBlock)
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	const auto ret = yieldToInternal(threadControlBlock);
+	if (ret != 0)
+		return ret;
+
+	maybeRequestContextSwitch();
+	return 0;
+}
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | private functions
 +---------------------------------------------------------------------------------------------------------------------*/
@@ -266,6 +422,7 @@ int Scheduler::blockInternal(ThreadControlBlockList& container, const ThreadCont
 
 	container.sortedSplice(runnableList_, iterator);
 	iterator->get().blockHook(unblockFunctor);
+	++getWaitObjectCounter(kernelCounters_.blocks, iterator->get().getState());
 
 	return 0;
 }
@@ -284,8 +441,27 @@ bool Scheduler::isContextSwitchRequired() const
 void Scheduler::unblockInternal(const ThreadControlBlockListIterator iterator,
 		const ThreadControlBlock::UnblockReason unblockReason)
 {
-	runnableList_.sortedSplice(*iterator->get().getList(), iterator);
-	iterator->get().unblockHook(unblockReason);
+	auto& threadControlBlock = iterator->get();
+	++getWaitObjectCounter(kernelCounters_.unblocks, threadControlBlock.getState());
+	if (unblockReason == ThreadControlBlock::UnblockReason::Timeout)
+		++kernelCounters_.timeouts;
+	runnableList_.sortedSplice(*threadControlBlock.getList(), iterator);
+	if (threadControlBlock.getTimeoutList() != nullptr)
+		timeoutList_.erase(threadControlBlock);
+	threadControlBlock.unblockHook(unblockReason);
+}
+
+int Scheduler::yieldToInternal(ThreadControlBlock& threadControlBlock)
+{
+	if (&threadControlBlock == &getCurrentThreadControlBlock() || threadControlBlock.getList() != &runnableList_)
+		return EINVAL;
+
+	// moving the thread to the front of the list must not break the ordering by effective priority
+	if (threadControlBlock.getEffectivePriority() < runnableList_.begin()->get().getEffectivePriority())
+		return EPERM;
+
+	runnableList_.spliceFront(threadControlBlock.getIterator());
+	return 0;
 }
 
 }	// namespace scheduler
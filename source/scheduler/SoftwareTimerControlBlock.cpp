@@ -2,13 +2,13 @@
  * \file
  * \brief SoftwareTimerControlBlock class implementation
  *
- * \author Copyright (C) 2014 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-11-20
+ * \date 2015-06-04
  */
 
 #include "distortos/scheduler/SoftwareTimerControlBlock.hpp"
@@ -18,6 +18,8 @@
 
 #include "distortos/architecture/InterruptMaskingLock.hpp"
 
+#include <cerrno>
+
 namespace distortos
 {
 
@@ -30,8 +32,10 @@ namespace scheduler
 
 SoftwareTimerControlBlock::SoftwareTimerControlBlock() :
 		timePoint_{},
+		period_{},
 		list_{},
-		iterator_{}
+		iterator_{},
+		overrunCount_{}
 {
 
 }
@@ -44,9 +48,22 @@ void SoftwareTimerControlBlock::start(const TickClock::duration duration)
 
 void SoftwareTimerControlBlock::start(const TickClock::time_point timePoint)
 {
-	timePoint_ = timePoint;
+	startInternal(timePoint, TickClock::duration{});
+}
 
-	iterator_ = getScheduler().getSoftwareTimerSupervisor().add(*this);
+int SoftwareTimerControlBlock::start(const TickClock::duration duration, const TickClock::duration period)
+{
+	const auto now = TickClock::now();
+	return start(now + duration + decltype(duration){1}, period);
+}
+
+int SoftwareTimerControlBlock::start(const TickClock::time_point timePoint, const TickClock::duration period)
+{
+	if (period <= TickClock::duration{})
+		return EINVAL;
+
+	startInternal(timePoint, period);
+	return 0;
 }
 
 void SoftwareTimerControlBlock::stop()
@@ -60,6 +77,17 @@ void SoftwareTimerControlBlock::stop()
 	}
 }
 
+void SoftwareTimerControlBlock::updateTimePoint(const TickClock::time_point timePoint)
+{
+	timePoint_ += period_;
+	if (timePoint_ > timePoint)
+		return;
+
+	const auto overruns = (timePoint - timePoint_) / period_ + 1;
+	overrunCount_ += overruns;
+	timePoint_ += period_ * overruns;
+}
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | protected functions
 +---------------------------------------------------------------------------------------------------------------------*/
@@ -69,6 +97,24 @@ SoftwareTimerControlBlock::~SoftwareTimerControlBlock()
 	stop();
 }
 
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void SoftwareTimerControlBlock::startInternal(const TickClock::time_point timePoint, const TickClock::duration period)
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	// restarting running timer (possibly from its own function) is safe - storage for list link is free again
+	stop();
+
+	timePoint_ = timePoint;
+	period_ = period;
+	overrunCount_ = 0;
+
+	iterator_ = getScheduler().getSoftwareTimerSupervisor().add(*this);
+}
+
 }	// namespace scheduler
 
 }	// namespace distortos
@@ -2,17 +2,20 @@
  * \file
  * \brief SoftwareTimerControlBlockSupervisor class implementation
  *
- * \author Copyright (C) 2014 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-09-18
+ * \date 2015-05-24
  */
 
 #include "distortos/scheduler/SoftwareTimerControlBlockSupervisor.hpp"
 
+#include "distortos/scheduler/getScheduler.hpp"
+#include "distortos/scheduler/Scheduler.hpp"
+
 #include "distortos/architecture/InterruptMaskingLock.hpp"
 
 namespace distortos
@@ -45,14 +48,27 @@ SoftwareTimerControlBlockSupervisor::add(SoftwareTimerControlBlock& softwareTime
 
 void SoftwareTimerControlBlockSupervisor::tickInterruptHandler(const TickClock::time_point timePoint)
 {
-	// execute all software timers that reached their time point
+	// execute all software timers that reached their time point - each timer is removed or rescheduled before its
+	// function is executed, so the function may freely stop or restart the timer
 	for (auto iterator = activeList_.begin();
 			iterator != activeList_.end() && iterator->get().getTimePoint() <= timePoint;
 			iterator = activeList_.begin())
 	{
-		iterator->get().execute();
-		iterator->get().setList(nullptr);
-		activeList_.erase(iterator);
+		auto& softwareTimerControlBlock = iterator->get();
+
+		if (softwareTimerControlBlock.getPeriod() == TickClock::duration{})	// one-shot timer?
+		{
+			softwareTimerControlBlock.setList(nullptr);
+			activeList_.erase(iterator);
+		}
+		else	// periodic timer - next expiration time point is based on the previous one, not on current time
+		{
+			softwareTimerControlBlock.updateTimePoint(timePoint);
+			activeList_.sortedSplice(activeList_, iterator);
+		}
+
+		++getScheduler().getKernelCounters().softwareTimerExpirations;
+		softwareTimerControlBlock.execute();
 	}
 }
 
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-03-15
+ * \date 2015-06-04
  */
 
 #include "distortos/scheduler/ThreadControlBlock.hpp"
@@ -23,6 +23,7 @@
 
 #include "distortos/SignalsReceiver.hpp"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 
@@ -38,31 +39,41 @@ namespace scheduler
 
 ThreadControlBlock::ThreadControlBlock(architecture::Stack&& stack, const uint8_t priority,
 		const SchedulingPolicy schedulingPolicy, ThreadGroupControlBlock* const threadGroupControlBlock,
-		SignalsReceiver* const signalsReceiver, ThreadBase& owner) :
+		SignalsReceiver* const signalsReceiver, _reent* const reent, ThreadBase& owner) :
 		stack_{std::move(stack)},
+		list_{},
+		iterator_{},
+		reent_{reent != nullptr ? reent : _GLOBAL_REENT},
+		priority_{priority},
+		boostedPriority_{},
+		roundRobinQuantum_{},
+		schedulingPolicy_{schedulingPolicy},
+		state_{State::New},
+		notificationPending_{},
 		owner_(owner),
 		ownedProtocolMutexControlBlocksList_
 		{
 				MutexControlBlockListAllocator{getScheduler().getMutexControlBlockListAllocatorPool()}
 		},
 		priorityInheritanceMutexControlBlock_{},
-		list_{},
-		iterator_{},
 		threadGroupControlBlock_{threadGroupControlBlock},
 		threadGroupList_{},
 		threadGroupIterator_{},
+		timeoutList_{},
+		timeoutIterator_{},
+		timeoutTimePoint_{},
 		unblockReason_{},
 		signalsReceiverControlBlock_
 		{
 				signalsReceiver != nullptr ? &signalsReceiver->signalsReceiverControlBlock_ : nullptr
 		},
-		priority_{priority},
-		boostedPriority_{},
-		roundRobinQuantum_{},
-		schedulingPolicy_{schedulingPolicy},
-		state_{State::New}
+		periodicActivation_{},
+		notificationValue_{}
 {
-	_REENT_INIT_PTR(&reent_);
+	if (reent != nullptr)
+	{
+		_REENT_INIT_PTR(reent);
+	}
 }
 
 ThreadControlBlock::~ThreadControlBlock()
@@ -72,7 +83,8 @@ ThreadControlBlock::~ThreadControlBlock()
 	if (threadGroupList_ != nullptr)
 		threadGroupList_->erase(threadGroupIterator_);
 
-	_reclaim_reent(&reent_);
+	if (reent_ != _GLOBAL_REENT)
+		_reclaim_reent(reent_);
 }
 
 int ThreadControlBlock::addHook()
@@ -91,6 +103,29 @@ int ThreadControlBlock::addHook()
 	return 0;
 }
 
+int ThreadControlBlock::notify(const NotificationAction action, const uint32_t value)
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	if (action == NotificationAction::SetBits)
+		notificationValue_ |= value;
+	else if (action == NotificationAction::Increment)
+		++notificationValue_;
+	else if (action == NotificationAction::Overwrite)
+		notificationValue_ = value;
+	else
+		return EINVAL;
+
+	notificationPending_ = true;
+
+	// thread waiting on WaitSet will check its readiness after wake up, so unblocking it is harmless even if it does not
+	// wait for notification
+	if (state_ == State::WaitingForNotification || state_ == State::WaitingForWaitSet)
+		getScheduler().unblock(iterator_);
+
+	return 0;
+}
+
 void ThreadControlBlock::setPriority(const uint8_t priority, const bool alwaysBehind)
 {
 	architecture::InterruptMaskingLock interruptMaskingLock;
@@ -108,9 +143,7 @@ void ThreadControlBlock::setPriority(const uint8_t priority, const bool alwaysBe
 		return;
 
 	reposition(loweringBefore);
-
-	if (priorityInheritanceMutexControlBlock_ != nullptr)
-		priorityInheritanceMutexControlBlock_->getOwner()->updateBoostedPriority();
+	propagatePriorityInheritance();
 }
 
 void ThreadControlBlock::setSchedulingPolicy(const SchedulingPolicy schedulingPolicy)
@@ -130,35 +163,10 @@ void ThreadControlBlock::unblockHook(const UnblockReason unblockReason)
 		(*unblockFunctor)(*this);
 }
 
-void ThreadControlBlock::updateBoostedPriority(const uint8_t boostedPriority)
+void ThreadControlBlock::updateBoostedPriority(const uint8_t oldBoostedPriority, const uint8_t newBoostedPriority)
 {
-	decltype(boostedPriority_) newBoostedPriority {boostedPriority};
-
-	for (const auto &mutexControlBlock : ownedProtocolMutexControlBlocksList_)
-	{
-		const auto mutexBoostedPriority = mutexControlBlock.get().getBoostedPriority();
-		newBoostedPriority = std::max(newBoostedPriority, mutexBoostedPriority);
-	}
-
-	if (boostedPriority_ == newBoostedPriority)
-		return;
-
-	const auto oldEffectivePriority = getEffectivePriority();
-	boostedPriority_ = newBoostedPriority;
-	const auto newEffectivePriority = getEffectivePriority();
-
-	if (oldEffectivePriority == newEffectivePriority || list_ == nullptr)
-		return;
-
-	const auto loweringBefore = newEffectivePriority < oldEffectivePriority;
-
-	reposition(loweringBefore);
-
-	// this code is placed here, even though it could be moved to ThreadControlBlock::reposition(), simplifying
-	// ThreadControlBlock::setPriority(). This way optimizer can remove recursive calls to this function, reducing
-	// memory usage of threads.
-	if (priorityInheritanceMutexControlBlock_ != nullptr)
-		priorityInheritanceMutexControlBlock_->getOwner()->updateBoostedPriority();
+	if (updateBoostedPriorityInternal(oldBoostedPriority, newBoostedPriority) == true)
+		propagatePriorityInheritance();
 }
 
 /*---------------------------------------------------------------------------------------------------------------------+
@@ -180,6 +188,59 @@ void ThreadControlBlock::reposition(const bool loweringBefore)
 	getScheduler().maybeRequestContextSwitch();
 }
 
+void ThreadControlBlock::propagatePriorityInheritance()
+{
+	auto threadControlBlock = this;
+
+	while (1)
+	{
+		const auto mutexControlBlock = threadControlBlock->priorityInheritanceMutexControlBlock_;
+		if (mutexControlBlock == nullptr)
+			return;
+
+		const auto oldBoostedPriority = mutexControlBlock->getBoostedPriority();
+		if (mutexControlBlock->updateBoostedPriority() == false)
+			return;
+
+		threadControlBlock = mutexControlBlock->getOwner();
+		if (threadControlBlock == nullptr || threadControlBlock->updateBoostedPriorityInternal(oldBoostedPriority,
+				mutexControlBlock->getBoostedPriority()) == false)
+			return;
+	}
+}
+
+bool ThreadControlBlock::updateBoostedPriorityInternal(const uint8_t oldBoostedPriority,
+		const uint8_t newBoostedPriority)
+{
+	decltype(boostedPriority_) newThreadBoostedPriority {newBoostedPriority};
+
+	// mutex didn't determine boosted priority of the thread and it was not raised above it - nothing changes
+	if (newBoostedPriority < boostedPriority_ && oldBoostedPriority < boostedPriority_)
+		return false;
+
+	// boosted priority of the thread may be lowered - all owned mutexes must be checked
+	if (newBoostedPriority < boostedPriority_)
+		for (const auto& mutexControlBlock : ownedProtocolMutexControlBlocksList_)
+			newThreadBoostedPriority = std::max(newThreadBoostedPriority, mutexControlBlock.get().getBoostedPriority());
+
+	if (boostedPriority_ == newThreadBoostedPriority)
+		return false;
+
+	const auto oldEffectivePriority = getEffectivePriority();
+	boostedPriority_ = newThreadBoostedPriority;
+	const auto newEffectivePriority = getEffectivePriority();
+
+	if (oldEffectivePriority == newEffectivePriority || list_ == nullptr)
+		return false;
+
+	const auto loweringBefore = newEffectivePriority < oldEffectivePriority;
+	if (loweringBefore == false)
+		++getScheduler().getKernelCounters().priorityBoosts;
+
+	reposition(loweringBefore);
+	return true;
+}
+
 }	// namespace scheduler
 
 }	// namespace distortos
@@ -1,23 +1,48 @@
 /**
  * \file
- * \brief idleThreadFunction() definition
+ * \brief idleThreadFunction() and setIdleHook() definitions
  *
- * \author Copyright (C) 2014 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-08-14
+ * \date 2015-05-21
  */
 
 #include "distortos/scheduler/idleThreadFunction.hpp"
 
-#include <cstdint>
+#include "distortos/setIdleHook.hpp"
+
+#include "distortos/architecture/sleep.hpp"
+
+#include "distortos/distortosConfiguration.h"
 
 namespace distortos
 {
 
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// idle hook executed by idle thread, nullptr if disabled
+IdleHook idleHook_;
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+IdleHook setIdleHook(const IdleHook idleHook)
+{
+	return __atomic_exchange_n(&idleHook_, idleHook, __ATOMIC_RELAXED);
+}
+
 namespace scheduler
 {
 
@@ -27,11 +52,15 @@ namespace scheduler
 
 void idleThreadFunction()
 {
-	volatile uint64_t i {};
-
 	while (1)
 	{
-		++i;
+		const auto idleHook = __atomic_load_n(&idleHook_, __ATOMIC_RELAXED);
+		if (idleHook != nullptr)
+			idleHook();
+
+#if CONFIG_IDLE_SLEEP == 1
+		architecture::sleep();
+#endif	// CONFIG_IDLE_SLEEP == 1
 	}
 }
 
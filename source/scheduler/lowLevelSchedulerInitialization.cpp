@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-04-16
+ * \date 2015-06-03
  */
 
 #include "distortos/scheduler/lowLevelSchedulerInitialization.hpp"
@@ -35,10 +35,20 @@ namespace
 +---------------------------------------------------------------------------------------------------------------------*/
 
 /// size of idle thread's stack, bytes
-constexpr size_t idleThreadStackSize {128};
+constexpr size_t idleThreadStackSize {256};
 
-/// type of idle thread
-using IdleThread = decltype(makeStaticThread<idleThreadStackSize>(0, idleThreadFunction));
+/// base of IdleThread, without its own _reent structure
+using IdleThreadBase = decltype(makeStaticThread<idleThreadStackSize, false, 0, 0, false>(0, idleThreadFunction));
+
+/// IdleThread class is a StaticThread for idleThreadFunction() which gives access to its ThreadControlBlock
+class IdleThread : public IdleThreadBase
+{
+public:
+
+	using IdleThreadBase::IdleThreadBase;
+
+	using ThreadBase::getThreadControlBlock;
+};
 
 /// storage for idle thread instance
 std::aligned_storage<sizeof(IdleThread), alignof(IdleThread)>::type idleThreadStorage;
@@ -84,10 +94,11 @@ void lowLevelSchedulerInitialization()
 
 	auto& mainThread = *new (&mainThreadStorage) MainThread {UINT8_MAX, mainThreadGroupControlBlock,
 			mainThreadStaticSignalsReceiverPointer};
-	schedulerInstance.initialize(mainThread);	/// \todo error handling?
+	auto& idleThread = *new (&idleThreadStorage) IdleThread {0, idleThreadFunction};
+
+	schedulerInstance.initialize(mainThread, idleThread.getThreadControlBlock());	/// \todo error handling?
 	mainThread.getThreadControlBlock().switchedToHook();
 
-	auto& idleThread = *new (&idleThreadStorage) IdleThread {0, idleThreadFunction};
 	idleThread.start();
 }
 
@@ -0,0 +1,103 @@
+/**
+ * \file
+ * \brief profiler namespace implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-23
+ */
+
+#include "distortos/profiler.hpp"
+
+#if CONFIG_SAMPLING_PROFILER == 1
+
+#include "distortos/scheduler/getScheduler.hpp"
+#include "distortos/scheduler/Scheduler.hpp"
+
+#include "distortos/architecture/InterruptMaskingLock.hpp"
+
+namespace distortos
+{
+
+namespace profiler
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// max number of samples in the buffer
+constexpr size_t maxSamples {CONFIG_SAMPLING_PROFILER_SAMPLES};
+
+static_assert(maxSamples > 0, "CONFIG_SAMPLING_PROFILER_SAMPLES must be positive and non-zero!");
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// ring buffer with samples
+Sample samples[maxSamples];
+
+/// number of lost samples
+uint64_t lostSampleCount;
+
+/// index of oldest sample in \a samples
+size_t readPosition;
+
+/// number of samples in \a samples
+size_t sampleCount;
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+uint64_t getLostSampleCount()
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+	return lostSampleCount;
+}
+
+size_t readSamples(Sample* const buffer, const size_t size)
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	size_t i {};
+	for (; i < size && sampleCount != 0; ++i, --sampleCount)
+	{
+		buffer[i] = samples[readPosition];
+		readPosition = (readPosition + 1) % maxSamples;
+	}
+
+	return i;
+}
+
+void sample(const uintptr_t programCounter, const bool threadContext)
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	if (sampleCount == maxSamples)
+	{
+		++lostSampleCount;
+		return;
+	}
+
+	const auto thread = threadContext == true ? &scheduler::getScheduler().getCurrentThreadControlBlock().getOwner() :
+			nullptr;
+	samples[(readPosition + sampleCount) % maxSamples] = {programCounter, thread};
+	++sampleCount;
+}
+
+}	// namespace profiler
+
+}	// namespace distortos
+
+#endif	// CONFIG_SAMPLING_PROFILER == 1
@@ -2,13 +2,13 @@
  * \file
  * \brief statistics namespace implementation
  *
- * \author Copyright (C) 2014 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-11-04
+ * \date 2015-05-24
  */
 
 #include "distortos/statistics.hpp"
@@ -31,6 +31,17 @@ uint64_t getContextSwitchCount()
 	return scheduler::getScheduler().getContextSwitchCount();
 }
 
+HighResolutionClock::duration getIdleTime()
+{
+	return scheduler::getScheduler().getIdleTime();
+}
+
+KernelCounters getKernelCounters()
+{
+	// all counters are naturally aligned 32-bit values, so each of them is read with single access
+	return scheduler::getScheduler().getKernelCounters();
+}
+
 }	// namespace statistics
 
 }	// namespace distortos
@@ -0,0 +1,160 @@
+/**
+ * \file
+ * \brief BasicMutex class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-02
+ */
+
+#include "distortos/BasicMutex.hpp"
+
+#include "distortos/scheduler/getScheduler.hpp"
+#include "distortos/scheduler/Scheduler.hpp"
+
+#include "distortos/architecture/InterruptMaskingLock.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+template<Mutex::Type type, Mutex::Protocol protocol>
+int BasicMutex<type, protocol>::lock()
+{
+	// lock-free fast path is possible only for mutexes without protocol
+	if (protocol == Protocol::None &&
+			controlBlock_.tryLockFast(scheduler::getScheduler().getCurrentThreadControlBlock()) == true)
+		return 0;
+
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	const auto ret = tryLockInternal();
+	if (ret != EBUSY)	// lock successful, recursive lock not possible or deadlock detected?
+		return ret;
+
+	controlBlock_.block();
+	return 0;
+}
+
+template<Mutex::Type type, Mutex::Protocol protocol>
+int BasicMutex<type, protocol>::tryLock()
+{
+	if (protocol == Protocol::None &&
+			controlBlock_.tryLockFast(scheduler::getScheduler().getCurrentThreadControlBlock()) == true)
+		return 0;
+
+	architecture::InterruptMaskingLock interruptMaskingLock;
+	const auto ret = tryLockInternal();
+	return ret != EDEADLK ? ret : EBUSY;
+}
+
+template<Mutex::Type type, Mutex::Protocol protocol>
+int BasicMutex<type, protocol>::tryLockFor(const TickClock::duration duration)
+{
+	return tryLockUntil(TickClock::now() + duration + TickClock::duration{1});
+}
+
+template<Mutex::Type type, Mutex::Protocol protocol>
+int BasicMutex<type, protocol>::tryLockUntil(const TickClock::time_point timePoint)
+{
+	if (protocol == Protocol::None &&
+			controlBlock_.tryLockFast(scheduler::getScheduler().getCurrentThreadControlBlock()) == true)
+		return 0;
+
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	const auto ret = tryLockInternal();
+	if (ret != EBUSY)	// lock successful, recursive lock not possible or deadlock detected?
+		return ret;
+
+	return controlBlock_.blockUntil(timePoint);
+}
+
+template<Mutex::Type type, Mutex::Protocol protocol>
+int BasicMutex<type, protocol>::unlock()
+{
+	auto& currentThreadControlBlock = scheduler::getScheduler().getCurrentThreadControlBlock();
+
+	// recursiveLocksCount_ is modified only by the owner, so it can be safely read here without interrupt masking
+	if (protocol == Protocol::None && (type != Type::Recursive || recursiveLocksCount_ == 0) &&
+			controlBlock_.tryUnlockFast(currentThreadControlBlock) == true)
+		return 0;
+
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	if (type != Type::Normal)
+	{
+		if (controlBlock_.getOwner() != &currentThreadControlBlock)
+			return EPERM;
+
+		if (type == Type::Recursive && recursiveLocksCount_ != 0)
+		{
+			--recursiveLocksCount_;
+			return 0;
+		}
+	}
+
+	controlBlock_.unlockOrTransferLock();
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+template<Mutex::Type type, Mutex::Protocol protocol>
+int BasicMutex<type, protocol>::tryLockInternal()
+{
+	if (protocol == Protocol::PriorityProtect &&
+			scheduler::getScheduler().getCurrentThreadControlBlock().getPriority() > controlBlock_.getPriorityCeiling())
+		return EINVAL;
+
+	if (controlBlock_.getOwner() == nullptr)
+	{
+		controlBlock_.lock();
+		return 0;
+	}
+
+	if (type == Type::Normal)
+		return EBUSY;
+
+	if (controlBlock_.getOwner() == &scheduler::getScheduler().getCurrentThreadControlBlock())
+	{
+		if (type == Type::ErrorChecking)
+			return EDEADLK;
+
+		if (recursiveLocksCount_ == getMaxRecursiveLocks())
+			return EAGAIN;
+
+		++recursiveLocksCount_;
+		return 0;
+	}
+
+	return EBUSY;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| explicit instantiations
++---------------------------------------------------------------------------------------------------------------------*/
+
+template class BasicMutex<Mutex::Type::Normal, Mutex::Protocol::None>;
+template class BasicMutex<Mutex::Type::Normal, Mutex::Protocol::PriorityInheritance>;
+template class BasicMutex<Mutex::Type::Normal, Mutex::Protocol::PriorityProtect>;
+template class BasicMutex<Mutex::Type::ErrorChecking, Mutex::Protocol::None>;
+template class BasicMutex<Mutex::Type::ErrorChecking, Mutex::Protocol::PriorityInheritance>;
+template class BasicMutex<Mutex::Type::ErrorChecking, Mutex::Protocol::PriorityProtect>;
+template class BasicMutex<Mutex::Type::Recursive, Mutex::Protocol::None>;
+template class BasicMutex<Mutex::Type::Recursive, Mutex::Protocol::PriorityInheritance>;
+template class BasicMutex<Mutex::Type::Recursive, Mutex::Protocol::PriorityProtect>;
+
+}	// namespace distortos
@@ -0,0 +1,229 @@
+/**
+ * \file
+ * \brief Channel class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#include "distortos/Channel.hpp"
+
+#include "distortos/scheduler/getScheduler.hpp"
+#include "distortos/scheduler/Scheduler.hpp"
+
+#include "distortos/architecture/InterruptMaskingLock.hpp"
+
+#include <algorithm>
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// ChannelUnblockFunctor is a functor executed when unblocking a thread that waits in Channel::send() - it is used only
+/// to keep the message of the client, so that Channel::receive() can find it via
+/// scheduler::ThreadControlBlock::getUnblockFunctor()
+class ChannelUnblockFunctor : public scheduler::ThreadControlBlock::UnblockFunctor
+{
+public:
+
+	/**
+	 * \brief ChannelUnblockFunctor's constructor
+	 *
+	 * \param [in] message is a reference to message of the client
+	 */
+
+	constexpr explicit ChannelUnblockFunctor(Channel::Message& message) :
+			message_(message)
+	{
+
+	}
+
+	/**
+	 * \return reference to message of the client
+	 */
+
+	Channel::Message& getMessage() const
+	{
+		return message_;
+	}
+
+	/**
+	 * \brief ChannelUnblockFunctor's function call operator
+	 *
+	 * Does nothing.
+	 */
+
+	void operator()(scheduler::ThreadControlBlock&) const override
+	{
+
+	}
+
+private:
+
+	/// reference to message of the client
+	Channel::Message& message_;
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+Channel::Channel() :
+		serverControlBlock_{synchronization::MutexControlBlock::Protocol::PriorityInheritance, {}},
+		sendersList_{scheduler::getScheduler().getThreadControlBlockListAllocator(),
+				scheduler::ThreadControlBlock::State::BlockedOnChannel},
+		repliesList_{scheduler::getScheduler().getThreadControlBlockListAllocator(),
+				scheduler::ThreadControlBlock::State::BlockedOnChannel},
+		receiverList_{scheduler::getScheduler().getThreadControlBlockListAllocator(),
+				scheduler::ThreadControlBlock::State::BlockedOnChannel}
+{
+
+}
+
+std::pair<int, Channel::Message*> Channel::receive()
+{
+	return receiveImplementation(false, nullptr);	// blocking mode, no timeout
+}
+
+int Channel::reply(Message& message)
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	const auto client = message.client_;
+	if (client == nullptr || client->getList() != &repliesList_)
+		return EINVAL;
+
+	// message is in client's stack, so it must not be accessed after the client is unblocked
+	message.client_ = nullptr;
+	scheduler::getScheduler().unblock(client->getIterator());
+
+	updateServerPriority();
+	releaseServerIfIdle();
+	return 0;
+}
+
+int Channel::send(const void* const request, const size_t requestSize, void* const reply, const size_t replySize)
+{
+	auto& scheduler = scheduler::getScheduler();
+	auto& currentThreadControlBlock = scheduler.getCurrentThreadControlBlock();
+
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	if (serverControlBlock_.getOwner() == &currentThreadControlBlock)
+		return EDEADLK;
+
+	Message message {request, requestSize, reply, replySize, currentThreadControlBlock};
+	const ChannelUnblockFunctor unblockFunctor {message};
+
+	if (receiverList_.empty() == false)
+		scheduler.unblock(receiverList_.begin());
+
+	// calling thread is not yet on the list of senders, that's why it's effective priority is given explicitly
+	updateServerPriority(currentThreadControlBlock.getEffectivePriority());
+
+	// reply() unblocks the thread, after it was moved to repliesList_ by receive()
+	return scheduler.block(sendersList_, &unblockFunctor);
+}
+
+std::pair<int, Channel::Message*> Channel::tryReceive()
+{
+	return receiveImplementation(true, nullptr);	// non-blocking mode
+}
+
+std::pair<int, Channel::Message*> Channel::tryReceiveFor(const TickClock::duration duration)
+{
+	return tryReceiveUntil(TickClock::now() + duration + TickClock::duration{1});
+}
+
+std::pair<int, Channel::Message*> Channel::tryReceiveUntil(const TickClock::time_point timePoint)
+{
+	return receiveImplementation(false, &timePoint);	// blocking mode, with timeout
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void Channel::releaseServerIfIdle()
+{
+	if (serverControlBlock_.getOwner() == nullptr || sendersList_.empty() == false || repliesList_.empty() == false ||
+			receiverList_.empty() == false)
+		return;
+
+	serverControlBlock_.unlockOrTransferLock();
+}
+
+std::pair<int, Channel::Message*> Channel::receiveImplementation(const bool nonBlocking,
+		const TickClock::time_point* const timePoint)
+{
+	auto& scheduler = scheduler::getScheduler();
+
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	const auto owner = serverControlBlock_.getOwner();
+	if (owner != nullptr && owner != &scheduler.getCurrentThreadControlBlock())
+		return {EBUSY, nullptr};
+
+	if (owner == nullptr)
+	{
+		serverControlBlock_.lock();
+		updateServerPriority();
+	}
+
+	while (sendersList_.empty() == true)
+	{
+		if (nonBlocking == true)
+		{
+			releaseServerIfIdle();
+			return {EAGAIN, nullptr};
+		}
+
+		const auto ret = timePoint == nullptr ? scheduler.block(receiverList_) :
+				scheduler.blockUntil(receiverList_, *timePoint);
+		if (ret != 0)
+		{
+			releaseServerIfIdle();
+			return {ret, nullptr};
+		}
+	}
+
+	auto& client = sendersList_.begin()->get();
+	auto& message = static_cast<const ChannelUnblockFunctor*>(client.getUnblockFunctor())->getMessage();
+
+	// client stays blocked, but now it waits for reply
+	repliesList_.sortedSplice(sendersList_, client.getIterator());
+	return {0, &message};
+}
+
+void Channel::updateServerPriority(uint8_t priority)
+{
+	const auto owner = serverControlBlock_.getOwner();
+	if (owner == nullptr)
+		return;
+
+	if (sendersList_.empty() == false)
+		priority = std::max(priority, sendersList_.begin()->get().getEffectivePriority());
+	if (repliesList_.empty() == false)
+		priority = std::max(priority, repliesList_.begin()->get().getEffectivePriority());
+
+	const auto oldBoostedPriority = serverControlBlock_.getBoostedPriority();
+	if (serverControlBlock_.updateBoostedPriority(priority) == true)
+		owner->updateBoostedPriority(oldBoostedPriority, serverControlBlock_.getBoostedPriority());
+}
+
+}	// namespace distortos
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-01-19
+ * \date 2015-05-26
  */
 
 #include "distortos/synchronization/FifoQueueBase.hpp"
@@ -43,7 +43,7 @@ FifoQueueBase::FifoQueueBase(void* const storageBegin, const void* const storage
 +---------------------------------------------------------------------------------------------------------------------*/
 
 int FifoQueueBase::popPush(const SemaphoreFunctor& waitSemaphoreFunctor, const QueueFunctor& functor,
-		Semaphore& waitSemaphore, Semaphore& postSemaphore, void*& storage)
+		Semaphore& waitSemaphore, Semaphore& postSemaphore, void*& storage, const bool switchToUnblocked)
 {
 	architecture::InterruptMaskingLock interruptMaskingLock;
 
@@ -57,7 +57,7 @@ int FifoQueueBase::popPush(const SemaphoreFunctor& waitSemaphoreFunctor, const Q
 	if (storage >= storageEnd_)
 		storage = storageBegin_;
 
-	return postSemaphore.post();
+	return switchToUnblocked == false ? postSemaphore.post() : postSemaphore.postAndSwitch();
 }
 
 }	// namespace synchronization
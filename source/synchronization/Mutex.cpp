@@ -2,13 +2,13 @@
  * \file
  * \brief Mutex class implementation
  *
- * \author Copyright (C) 2014 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-11-03
+ * \date 2015-05-14
  */
 
 #include "distortos/Mutex.hpp"
@@ -27,8 +27,8 @@ namespace distortos
 | public functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
-Mutex::Mutex(const Type type, const Protocol protocol, const uint8_t priorityCeiling) :
-		controlBlock_{protocol, priorityCeiling},
+Mutex::Mutex(const Type type, const Protocol protocol, const uint8_t priorityCeiling, const bool competitive) :
+		controlBlock_{protocol, priorityCeiling, competitive},
 		recursiveLocksCount_{},
 		type_{type}
 {
@@ -37,6 +37,9 @@ Mutex::Mutex(const Type type, const Protocol protocol, const uint8_t priorityCei
 
 int Mutex::lock()
 {
+	if (controlBlock_.tryLockFast(scheduler::getScheduler().getCurrentThreadControlBlock()) == true)
+		return 0;
+
 	architecture::InterruptMaskingLock interruptMaskingLock;
 
 	const auto ret = tryLockInternal();
@@ -49,6 +52,9 @@ int Mutex::lock()
 
 int Mutex::tryLock()
 {
+	if (controlBlock_.tryLockFast(scheduler::getScheduler().getCurrentThreadControlBlock()) == true)
+		return 0;
+
 	architecture::InterruptMaskingLock interruptMaskingLock;
 	const auto ret = tryLockInternal();
 	return ret != EDEADLK ? ret : EBUSY;
@@ -61,6 +67,9 @@ int Mutex::tryLockFor(const TickClock::duration duration)
 
 int Mutex::tryLockUntil(const TickClock::time_point timePoint)
 {
+	if (controlBlock_.tryLockFast(scheduler::getScheduler().getCurrentThreadControlBlock()) == true)
+		return 0;
+
 	architecture::InterruptMaskingLock interruptMaskingLock;
 
 	const auto ret = tryLockInternal();
@@ -72,11 +81,18 @@ int Mutex::tryLockUntil(const TickClock::time_point timePoint)
 
 int Mutex::unlock()
 {
+	auto& currentThreadControlBlock = scheduler::getScheduler().getCurrentThreadControlBlock();
+
+	// recursiveLocksCount_ is modified only by the owner, so it can be safely read here without interrupt masking
+	if ((type_ != Type::Recursive || recursiveLocksCount_ == 0) &&
+			controlBlock_.tryUnlockFast(currentThreadControlBlock) == true)
+		return 0;
+
 	architecture::InterruptMaskingLock interruptMaskingLock;
 
 	if (type_ != Type::Normal)
 	{
-		if (controlBlock_.getOwner() != &scheduler::getScheduler().getCurrentThreadControlBlock())
+		if (controlBlock_.getOwner() != &currentThreadControlBlock)
 			return EPERM;
 
 		if (type_ == Type::Recursive && recursiveLocksCount_ != 0)
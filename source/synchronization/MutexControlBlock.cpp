@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-02-01
+ * \date 2015-06-04
  */
 
 #include "distortos/synchronization/MutexControlBlock.hpp"
@@ -16,6 +16,7 @@
 #include "distortos/scheduler/getScheduler.hpp"
 #include "distortos/scheduler/Scheduler.hpp"
 
+#include <algorithm>
 #include <cerrno>
 
 namespace distortos
@@ -31,6 +32,50 @@ namespace
 | local types
 +---------------------------------------------------------------------------------------------------------------------*/
 
+/// PriorityInheritanceMutexControlBlockBeforeBlockFunctor is a functor executed right before blocking a thread on a
+/// mutex with PriorityInheritance protocol
+class PriorityInheritanceMutexControlBlockBeforeBlockFunctor : public MutexControlBlockBase::BeforeBlockFunctor
+{
+public:
+
+	/**
+	 * \brief PriorityInheritanceMutexControlBlockBeforeBlockFunctor's constructor
+	 *
+	 * \param [in] mutexControlBlock is a reference to MutexControlBlock on which the thread will be blocked
+	 */
+
+	constexpr explicit PriorityInheritanceMutexControlBlockBeforeBlockFunctor(MutexControlBlock& mutexControlBlock) :
+			mutexControlBlock_(mutexControlBlock)
+	{
+
+	}
+
+	/**
+	 * \brief PriorityInheritanceMutexControlBlockBeforeBlockFunctor's function call operator
+	 *
+	 * Sets pointer to MutexControlBlock with PriorityInheritance protocol which causes current thread to block and
+	 * requests update of boosted priority of the mutex and - if it changed - of current owner of the mutex.
+	 */
+
+	void operator()() const override
+	{
+		auto& currentThreadControlBlock = scheduler::getScheduler().getCurrentThreadControlBlock();
+
+		currentThreadControlBlock.setPriorityInheritanceMutexControlBlock(&mutexControlBlock_);
+
+		// calling thread is not yet on the blocked list, that's why it's effective priority is given explicitly
+		const auto oldBoostedPriority = mutexControlBlock_.getBoostedPriority();
+		if (mutexControlBlock_.updateBoostedPriority(currentThreadControlBlock.getEffectivePriority()) == true)
+			mutexControlBlock_.getOwner()->updateBoostedPriority(oldBoostedPriority,
+					mutexControlBlock_.getBoostedPriority());
+	}
+
+private:
+
+	/// reference to MutexControlBlock on which the thread will be blocked
+	MutexControlBlock& mutexControlBlock_;
+};
+
 /// PriorityInheritanceMutexControlBlockUnblockFunctor is a functor executed when unblocking a thread that is blocked on
 /// a mutex with PriorityInheritance protocol
 class PriorityInheritanceMutexControlBlockUnblockFunctor : public scheduler::ThreadControlBlock::UnblockFunctor
@@ -43,7 +88,7 @@ public:
 	 * \param [in] mutexControlBlock is a reference to MutexControlBlock that blocked the thread
 	 */
 
-	constexpr explicit PriorityInheritanceMutexControlBlockUnblockFunctor(const MutexControlBlock& mutexControlBlock) :
+	constexpr explicit PriorityInheritanceMutexControlBlockUnblockFunctor(MutexControlBlock& mutexControlBlock) :
 			mutexControlBlock_(mutexControlBlock)
 	{
 
@@ -52,8 +97,9 @@ public:
 	/**
 	 * \brief PriorityInheritanceMutexControlBlockUnblockFunctor's function call operator
 	 *
-	 * If the wait for mutex was interrupted, requests update of boosted priority of current owner of the mutex. Pointer
-	 * to MutexControlBlock with PriorityInheritance protocol which caused the thread to block is reset to nullptr.
+	 * If the wait for mutex was interrupted, requests update of boosted priority of the mutex and - if it changed - of
+	 * current owner of the mutex. Pointer to MutexControlBlock with PriorityInheritance protocol which caused the
+	 * thread to block is reset to nullptr.
 	 *
 	 * \param [in] threadControlBlock is a reference to ThreadControlBlock that is being unblocked
 	 */
@@ -61,11 +107,12 @@ public:
 	void operator()(scheduler::ThreadControlBlock& threadControlBlock) const override
 	{
 		const auto owner = mutexControlBlock_.getOwner();
+		const auto oldBoostedPriority = mutexControlBlock_.getBoostedPriority();
 
-		// waiting for mutex was interrupted and some thread still holds it?
+		// waiting for mutex was interrupted, some thread still holds it and boosted priority of mutex changed?
 		if (threadControlBlock.getUnblockReason() != scheduler::ThreadControlBlock::UnblockReason::UnblockRequest &&
-				owner != nullptr)
-			owner->updateBoostedPriority();
+				owner != nullptr && mutexControlBlock_.updateBoostedPriority() == true)
+			owner->updateBoostedPriority(oldBoostedPriority, mutexControlBlock_.getBoostedPriority());
 
 		threadControlBlock.setPriorityInheritanceMutexControlBlock(nullptr);
 	}
@@ -73,7 +120,7 @@ public:
 private:
 
 	/// reference to MutexControlBlock that blocked the thread
-	const MutexControlBlock& mutexControlBlock_;
+	MutexControlBlock& mutexControlBlock_;
 };
 
 }	// namespace
@@ -82,121 +129,139 @@ private:
 | public functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
-MutexControlBlock::MutexControlBlock(const Protocol protocol, const uint8_t priorityCeiling) :
-		blockedList_{scheduler::getScheduler().getThreadControlBlockListAllocator(),
-				scheduler::ThreadControlBlock::State::BlockedOnMutex},
-		list_{},
-		iterator_{},
-		owner_{},
+MutexControlBlock::MutexControlBlock(const Protocol protocol, const uint8_t priorityCeiling, const bool competitive) :
+		MutexControlBlockBase{competitive},
 		protocol_{protocol},
-		priorityCeiling_{priorityCeiling}
+		priorityCeiling_{priorityCeiling},
+		boostedPriority_{protocol == Protocol::PriorityProtect ? priorityCeiling : uint8_t{}},
+		list_{},
+		iterator_{}
 {
 
 }
 
 void MutexControlBlock::block()
 {
-	if (protocol_ == Protocol::PriorityInheritance)
-		priorityInheritanceBeforeBlock();
+	const PriorityInheritanceMutexControlBlockBeforeBlockFunctor beforeBlockFunctor {*this};
+
+	blockInternal(nullptr, protocol_ == Protocol::PriorityInheritance ? &beforeBlockFunctor : nullptr, nullptr);
 
-	scheduler::getScheduler().block(blockedList_);
+	if (isCompetitive() == true)	// mutex is unlocked, current thread must lock it?
+		lock();
 }
 
 int MutexControlBlock::blockUntil(const TickClock::time_point timePoint)
 {
-	if (protocol_ == Protocol::PriorityInheritance)
-		priorityInheritanceBeforeBlock();
-
+	const PriorityInheritanceMutexControlBlockBeforeBlockFunctor beforeBlockFunctor {*this};
 	const PriorityInheritanceMutexControlBlockUnblockFunctor unblockFunctor {*this};
-	return scheduler::getScheduler().blockUntil(blockedList_, timePoint,
-			protocol_ == Protocol::PriorityInheritance ? &unblockFunctor : nullptr);
-}
 
-uint8_t MutexControlBlock::getBoostedPriority() const
-{
-	if (protocol_ == Protocol::PriorityInheritance)
-	{
-		if (blockedList_.empty() == true)
-			return 0;
-		return blockedList_.begin()->get().getEffectivePriority();
-	}
+	const auto priorityInheritance = protocol_ == Protocol::PriorityInheritance;
+	const auto ret = blockInternal(&timePoint, priorityInheritance == true ? &beforeBlockFunctor : nullptr,
+			priorityInheritance == true ? &unblockFunctor : nullptr);
 
-	if (protocol_ == Protocol::PriorityProtect)
-		return priorityCeiling_;
+	if (ret == 0 && isCompetitive() == true)	// mutex is unlocked, current thread must lock it?
+		lock();
 
-	return 0;
+	return ret;
 }
 
 void MutexControlBlock::lock()
 {
-	auto& scheduler = scheduler::getScheduler();
-	owner_ = &scheduler.getCurrentThreadControlBlock();
+	MutexControlBlockBase::lock();
 
 	if (protocol_ == Protocol::None)
 		return;
 
-	scheduler.getMutexControlBlockListAllocatorPool().feed(link_);
-	list_ = &owner_->getOwnedProtocolMutexControlBlocksList();
+	const auto owner = getOwner();
+	scheduler::getScheduler().getMutexControlBlockListAllocatorPool().feed(link_);
+	list_ = &owner->getOwnedProtocolMutexControlBlocksList();
 	list_->emplace_front(*this);
 	iterator_ = list_->begin();
 
-	if (protocol_ == Protocol::PriorityProtect)
-		owner_->updateBoostedPriority();
+	if (protocol_ == Protocol::PriorityProtect || blockedList_.empty() == false)
+		owner->updateBoostedPriority({}, boostedPriority_);
+}
+
+bool MutexControlBlock::updateBoostedPriority(const uint8_t boostedPriority)
+{
+	if (protocol_ != Protocol::PriorityInheritance)
+		return false;
+
+	const auto newBoostedPriority = blockedList_.empty() == true ? boostedPriority :
+			std::max(boostedPriority, blockedList_.begin()->get().getEffectivePriority());
+	if (boostedPriority_ == newBoostedPriority)
+		return false;
+
+	boostedPriority_ = newBoostedPriority;
+	return true;
 }
 
 void MutexControlBlock::unlockOrTransferLock()
 {
-	auto& oldOwner = *owner_;
+	auto& oldOwner = *getOwner();
+	const auto oldBoostedPriority = boostedPriority_;
 
-	if (blockedList_.empty() == false)
-		transferLock();
-	else
+	if (blockedList_.empty() == true)
 		unlock();
+	else if (isCompetitive() == true)
+		competitiveUnlock();
+	else
+		transferLock();
 
 	if (protocol_ == Protocol::None)
 		return;
 
-	oldOwner.updateBoostedPriority();
+	// mutex was removed from the list of mutexes owned by previous owner
+	oldOwner.updateBoostedPriority(oldBoostedPriority, {});
 
-	if (owner_ == nullptr)
+	const auto owner = getOwner();
+	if (owner == nullptr)
 		return;
 
-	owner_->updateBoostedPriority();
+	// mutex was added to the list of mutexes owned by new owner
+	owner->updateBoostedPriority({}, boostedPriority_);
 }
 
 /*---------------------------------------------------------------------------------------------------------------------+
 | private functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
-void MutexControlBlock::priorityInheritanceBeforeBlock() const
+void MutexControlBlock::competitiveUnlock()
 {
-	auto& currentThreadControlBlock = scheduler::getScheduler().getCurrentThreadControlBlock();
+	unlock();
+
+	if (protocol_ == Protocol::PriorityInheritance)
+		blockedList_.begin()->get().setPriorityInheritanceMutexControlBlock(nullptr);
 
-	currentThreadControlBlock.setPriorityInheritanceMutexControlBlock(this);
+	MutexControlBlockBase::competitiveUnlock();
 
-	// calling thread is not yet on the blocked list, that's why it's effective priority is given explicitly
-	owner_->updateBoostedPriority(currentThreadControlBlock.getEffectivePriority());
+	// mutex is not owned by any thread, so this just updates the value
+	updateBoostedPriority();
 }
 
 void MutexControlBlock::transferLock()
 {
-	owner_ = &blockedList_.begin()->get();	// pass ownership to the unblocked thread
-	scheduler::getScheduler().unblock(blockedList_.begin());
+	MutexControlBlockBase::transferLock();
 
 	if (list_ == nullptr)
 		return;
 
+	const auto owner = getOwner();
+
+	if (protocol_ == Protocol::PriorityInheritance)
+		boostedPriority_ = blockedList_.empty() == true ? 0 : blockedList_.begin()->get().getEffectivePriority();
+
 	auto& oldList = *list_;
-	list_ = &owner_->getOwnedProtocolMutexControlBlocksList();
+	list_ = &owner->getOwnedProtocolMutexControlBlocksList();
 	list_->splice(list_->begin(), oldList, iterator_);
 
 	if (protocol_ == Protocol::PriorityInheritance)
-		owner_->setPriorityInheritanceMutexControlBlock(nullptr);
+		owner->setPriorityInheritanceMutexControlBlock(nullptr);
 }
 
 void MutexControlBlock::unlock()
 {
-	owner_ = nullptr;
+	MutexControlBlockBase::unlock();
 
 	if (list_ == nullptr)
 		return;
@@ -0,0 +1,125 @@
+/**
+ * \file
+ * \brief MutexControlBlockBase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#include "distortos/synchronization/MutexControlBlockBase.hpp"
+
+#include "distortos/scheduler/getScheduler.hpp"
+#include "distortos/scheduler/Scheduler.hpp"
+
+namespace distortos
+{
+
+namespace synchronization
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+MutexControlBlockBase::MutexControlBlockBase(const bool competitive) :
+		blockedList_{scheduler::getScheduler().getThreadControlBlockListAllocator(),
+				scheduler::ThreadControlBlock::State::BlockedOnMutex},
+		owner_{},
+		competitive_{competitive}
+{
+	static_assert(alignof(scheduler::ThreadControlBlock) > contendedFlag_,
+			"Alignment of ThreadControlBlock doesn't leave space for \"contended\" flag in owner_!");
+}
+
+void MutexControlBlockBase::block()
+{
+	blockInternal(nullptr, nullptr, nullptr);
+
+	if (competitive_ == true)	// mutex is unlocked, current thread must lock it?
+		lock();
+}
+
+int MutexControlBlockBase::blockUntil(const TickClock::time_point timePoint)
+{
+	const auto ret = blockInternal(&timePoint, nullptr, nullptr);
+
+	if (ret == 0 && competitive_ == true)	// mutex is unlocked, current thread must lock it?
+		lock();
+
+	return ret;
+}
+
+void MutexControlBlockBase::lock()
+{
+	// in competitive mode the mutex may be locked while other threads are still blocked on it
+	setOwner(&scheduler::getScheduler().getCurrentThreadControlBlock(), blockedList_.empty() == false);
+}
+
+void MutexControlBlockBase::unlockOrTransferLock()
+{
+	if (blockedList_.empty() == true)
+		unlock();
+	else if (competitive_ == true)
+		competitiveUnlock();
+	else
+		transferLock();
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| protected functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int MutexControlBlockBase::blockInternal(const TickClock::time_point* const timePoint,
+		const BeforeBlockFunctor* const beforeBlockFunctor,
+		const scheduler::ThreadControlBlock::UnblockFunctor* const unblockFunctor)
+{
+	auto& scheduler = scheduler::getScheduler();
+
+	++scheduler.getKernelCounters().mutexContentions;
+
+	while (1)
+	{
+		if (beforeBlockFunctor != nullptr)
+			(*beforeBlockFunctor)();
+
+		setOwner(getOwner(), true);
+		const auto ret = timePoint == nullptr ? scheduler.block(blockedList_, unblockFunctor) :
+				scheduler.blockUntil(blockedList_, *timePoint, unblockFunctor);
+
+		if (ret != 0 || competitive_ == false)	// timeout or ownership was transferred to current thread?
+			return ret;
+
+		if (getOwner() == nullptr)	// mutex is unlocked?
+			return 0;
+	}
+}
+
+void MutexControlBlockBase::competitiveUnlock()
+{
+	scheduler::getScheduler().unblock(blockedList_.begin());
+
+	// unlocked mutex stays "contended" if there are other threads blocked on it, so that lock-free fast path of locking
+	// fails and the next owner doesn't release the mutex with fast path of unlocking
+	setOwner(nullptr, blockedList_.empty() == false);
+}
+
+void MutexControlBlockBase::transferLock()
+{
+	// pass ownership to the unblocked thread, mutex stays "contended" if there are other threads blocked on it
+	setOwner(&blockedList_.begin()->get(), std::next(blockedList_.begin()) != blockedList_.end());
+	scheduler::getScheduler().unblock(blockedList_.begin());
+}
+
+void MutexControlBlockBase::unlock()
+{
+	setOwner(nullptr);
+}
+
+}	// namespace synchronization
+
+}	// namespace distortos
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-01-19
+ * \date 2015-05-26
  */
 
 #include "distortos/RawFifoQueue.hpp"
@@ -48,6 +48,12 @@ int RawFifoQueue::push(const void* const data, const size_t size)
 	return pushInternal(semaphoreWaitFunctor, data, size);
 }
 
+int RawFifoQueue::pushAndSwitch(const void* const data, const size_t size)
+{
+	const synchronization::SemaphoreWaitFunctor semaphoreWaitFunctor;
+	return pushInternal(semaphoreWaitFunctor, data, size, true);
+}
+
 int RawFifoQueue::tryPop(void* const buffer, const size_t size)
 {
 	const synchronization::SemaphoreTryWaitFunctor semaphoreTryWaitFunctor;
@@ -99,13 +105,13 @@ int RawFifoQueue::popInternal(const synchronization::SemaphoreFunctor& waitSemap
 }
 
 int RawFifoQueue::pushInternal(const synchronization::SemaphoreFunctor& waitSemaphoreFunctor, const void* const data,
-		const size_t size)
+		const size_t size, const bool switchToUnblocked)
 {
 	if (size != fifoQueueBase_.getElementSize())
 		return EMSGSIZE;
 
 	const synchronization::MemcpyPushQueueFunctor memcpyPushQueueFunctor {data, size};
-	return fifoQueueBase_.push(waitSemaphoreFunctor, memcpyPushQueueFunctor);
+	return fifoQueueBase_.push(waitSemaphoreFunctor, memcpyPushQueueFunctor, switchToUnblocked);
 }
 
 }	// namespace distortos
@@ -0,0 +1,245 @@
+/**
+ * \file
+ * \brief RwLock class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#include "distortos/RwLock.hpp"
+
+#include "distortos/scheduler/getScheduler.hpp"
+#include "distortos/scheduler/Scheduler.hpp"
+
+#include "distortos/architecture/InterruptMaskingLock.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+RwLock::RwLock(const Preference preference, const Protocol protocol, const uint8_t priorityCeiling) :
+		writerControlBlock_{protocol, priorityCeiling},
+		readersBlockedList_{scheduler::getScheduler().getThreadControlBlockListAllocator(),
+				scheduler::ThreadControlBlock::State::BlockedOnRwLock},
+		writerBlockedList_{scheduler::getScheduler().getThreadControlBlockListAllocator(),
+				scheduler::ThreadControlBlock::State::BlockedOnRwLock},
+		readersCount_{},
+		preference_{preference},
+		writerActive_{}
+{
+
+}
+
+int RwLock::lock()
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	const auto ret = tryLockInternal();
+	if (ret != EBUSY)	// lock successful, priority ceiling violated or deadlock detected?
+		return ret;
+
+	if (writerControlBlock_.getOwner() != nullptr)
+		writerControlBlock_.block();
+	else
+		writerControlBlock_.lock();
+
+	if (readersCount_ == 0)
+	{
+		writerActive_ = true;
+		return 0;
+	}
+
+	// writerActive_ will be set by the last reader
+	return scheduler::getScheduler().block(writerBlockedList_);
+}
+
+int RwLock::lockShared()
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	const auto ret = tryLockSharedInternal();
+	if (ret != EBUSY)	// lock successful, too many readers or deadlock detected?
+		return ret;
+
+	// readersCount_ will be incremented by the thread that grants shared lock
+	return scheduler::getScheduler().block(readersBlockedList_);
+}
+
+int RwLock::tryLock()
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+	const auto ret = tryLockInternal();
+	return ret != EDEADLK ? ret : EBUSY;
+}
+
+int RwLock::tryLockFor(const TickClock::duration duration)
+{
+	return tryLockUntil(TickClock::now() + duration + TickClock::duration{1});
+}
+
+int RwLock::tryLockShared()
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+	const auto ret = tryLockSharedInternal();
+	return ret != EDEADLK ? ret : EBUSY;
+}
+
+int RwLock::tryLockSharedFor(const TickClock::duration duration)
+{
+	return tryLockSharedUntil(TickClock::now() + duration + TickClock::duration{1});
+}
+
+int RwLock::tryLockSharedUntil(const TickClock::time_point timePoint)
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	const auto ret = tryLockSharedInternal();
+	if (ret != EBUSY)	// lock successful, too many readers or deadlock detected?
+		return ret;
+
+	// readersCount_ will be incremented by the thread that grants shared lock
+	return scheduler::getScheduler().blockUntil(readersBlockedList_, timePoint);
+}
+
+int RwLock::tryLockUntil(const TickClock::time_point timePoint)
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	{
+		const auto ret = tryLockInternal();
+		if (ret != EBUSY)	// lock successful, priority ceiling violated or deadlock detected?
+			return ret;
+	}
+
+	if (writerControlBlock_.getOwner() != nullptr)
+	{
+		const auto ret = writerControlBlock_.blockUntil(timePoint);
+		if (ret != 0)
+			return ret;
+	}
+	else
+		writerControlBlock_.lock();
+
+	if (readersCount_ == 0)
+	{
+		writerActive_ = true;
+		return 0;
+	}
+
+	// writerActive_ will be set by the last reader
+	const auto ret = scheduler::getScheduler().blockUntil(writerBlockedList_, timePoint);
+	if (ret != 0)
+		releaseExclusive();
+
+	return ret;
+}
+
+int RwLock::unlock()
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	if (writerActive_ == false ||
+			writerControlBlock_.getOwner() != &scheduler::getScheduler().getCurrentThreadControlBlock())
+		return EPERM;
+
+	writerActive_ = false;
+	releaseExclusive();
+	return 0;
+}
+
+int RwLock::unlockShared()
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	if (readersCount_ == 0)
+		return EPERM;
+
+	--readersCount_;
+
+	// reader left blocked by releaseExclusive() because of getMaxReaders() limit takes the place of this one
+	if (readersBlockedList_.empty() == false && writerActive_ == false &&
+			(preference_ != Preference::Writers || writerControlBlock_.getOwner() == nullptr))
+	{
+		++readersCount_;
+		scheduler::getScheduler().unblock(readersBlockedList_.begin());
+		return 0;
+	}
+
+	if (readersCount_ != 0 || writerBlockedList_.empty() == true)
+		return 0;
+
+	writerActive_ = true;
+	scheduler::getScheduler().unblock(writerBlockedList_.begin());
+	return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void RwLock::releaseExclusive()
+{
+	writerControlBlock_.unlockOrTransferLock();
+
+	// with writers' preference, waiting readers are not admitted if exclusive lock was transferred to next writer
+	if (preference_ == Preference::Writers && writerControlBlock_.getOwner() != nullptr)
+		return;
+
+	auto& scheduler = scheduler::getScheduler();
+	// readers which don't fit in getMaxReaders() limit remain blocked, they are admitted later by unlockShared()
+	while (readersBlockedList_.empty() == false && readersCount_ != getMaxReaders())
+	{
+		++readersCount_;
+		scheduler.unblock(readersBlockedList_.begin());
+	}
+}
+
+int RwLock::tryLockInternal()
+{
+	auto& currentThreadControlBlock = scheduler::getScheduler().getCurrentThreadControlBlock();
+
+	if (writerControlBlock_.getProtocol() == Protocol::PriorityProtect &&
+			currentThreadControlBlock.getPriority() > writerControlBlock_.getPriorityCeiling())
+		return EINVAL;
+
+	const auto owner = writerControlBlock_.getOwner();
+
+	if (owner == &currentThreadControlBlock)
+		return EDEADLK;
+
+	if (owner != nullptr || readersCount_ != 0)
+		return EBUSY;
+
+	writerControlBlock_.lock();
+	writerActive_ = true;
+	return 0;
+}
+
+int RwLock::tryLockSharedInternal()
+{
+	const auto owner = writerControlBlock_.getOwner();
+
+	if (owner == &scheduler::getScheduler().getCurrentThreadControlBlock())
+		return EDEADLK;
+
+	if (writerActive_ == true || (preference_ == Preference::Writers && owner != nullptr))
+		return EBUSY;
+
+	if (readersCount_ == getMaxReaders())
+		return EAGAIN;
+
+	++readersCount_;
+	return 0;
+}
+
+}	// namespace distortos
@@ -8,15 +8,18 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-02-02
+ * \date 2015-06-04
  */
 
 #include "distortos/Semaphore.hpp"
 
+#include "distortos/synchronization/WaitSetObserver.hpp"
+
 #include "distortos/scheduler/getScheduler.hpp"
 #include "distortos/scheduler/Scheduler.hpp"
 
 #include "distortos/architecture/InterruptMaskingLock.hpp"
+#include "distortos/architecture/isInInterruptContext.hpp"
 
 #include <cerrno>
 
@@ -30,6 +33,7 @@ namespace distortos
 Semaphore::Semaphore(const Value value, const Value maxValue) :
 		blockedList_{scheduler::getScheduler().getThreadControlBlockListAllocator(),
 				scheduler::ThreadControlBlock::State::BlockedOnSemaphore},
+		observersList_{},
 		value_{value <= maxValue ? value : maxValue},
 		maxValue_{maxValue}
 {
@@ -43,25 +47,16 @@ Semaphore::~Semaphore()
 
 int Semaphore::post()
 {
-	architecture::InterruptMaskingLock interruptMaskingLock;
-
-	if (value_ == maxValue_)
-		return EOVERFLOW;
-
-	if (blockedList_.empty() == false)
-	{
-		scheduler::getScheduler().unblock(blockedList_.begin());
-		return 0;
-	}
-
-	++value_;
+	return postImplementation(false);
+}
 
-	return 0;
+int Semaphore::postAndSwitch()
+{
+	return postImplementation(true);
 }
 
 int Semaphore::tryWait()
 {
-	architecture::InterruptMaskingLock interruptMaskingLock;
 	return tryWaitInternal();
 }
 
@@ -72,6 +67,9 @@ int Semaphore::tryWaitFor(const TickClock::duration duration)
 
 int Semaphore::tryWaitUntil(const TickClock::time_point timePoint)
 {
+	if (tryWaitInternal() == 0)
+		return 0;
+
 	architecture::InterruptMaskingLock interruptMaskingLock;
 
 	const auto ret = tryWaitInternal();
@@ -83,6 +81,9 @@ int Semaphore::tryWaitUntil(const TickClock::time_point timePoint)
 
 int Semaphore::wait()
 {
+	if (tryWaitInternal() == 0)
+		return 0;
+
 	architecture::InterruptMaskingLock interruptMaskingLock;
 
 	const auto ret = tryWaitInternal();
@@ -96,14 +97,141 @@ int Semaphore::wait()
 | private functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
-int Semaphore::tryWaitInternal()
+int Semaphore::postImplementation(const bool switchToUnblocked)
+{
+	auto& kernelCounters = scheduler::getScheduler().getKernelCounters();
+
+	// threads may be blocked on semaphore only when its value is zero (or when deferred request which will hand the
+	// value over to them is pending) - any other value can be simply incremented with atomic compare-and-swap
+	// (LDREX/STREX on ARMv7-M), without interrupt masking
+	auto value = __atomic_load_n(&value_, __ATOMIC_RELAXED);
+	while (value != 0 && value < maxValue_)
+		if (__atomic_compare_exchange_n(&value_, &value, value + 1, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED) == true)
+		{
+			__atomic_fetch_add(&kernelCounters.semaphorePosts, 1, __ATOMIC_RELAXED);
+			return 0;
+		}
+
+	if (value != 0)
+	{
+		__atomic_fetch_add(&kernelCounters.semaphoreOverflows, 1, __ATOMIC_RELAXED);
+		return EOVERFLOW;
+	}
+
+#if CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+	// in interrupt context lists of threads are modified later, from PendSV
+	if (architecture::isInInterruptContext() == true)
+		return postDeferred();
+
+#endif	// CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+	return postInternal(switchToUnblocked);
+}
+
+int Semaphore::postInternal(const bool switchToUnblocked)
+{
+	auto& kernelCounters = scheduler::getScheduler().getKernelCounters();
+
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	if (value_ == maxValue_)
+	{
+		++kernelCounters.semaphoreOverflows;
+		return EOVERFLOW;
+	}
+
+	++kernelCounters.semaphorePosts;
+
+	if (blockedList_.empty() == false)
+	{
+		auto& scheduler = scheduler::getScheduler();
+		if (switchToUnblocked == false)
+			scheduler.unblock(blockedList_.begin());
+		else
+			scheduler.unblockAndSwitch(blockedList_.begin());
+		return 0;
+	}
+
+	++value_;
+
+	// semaphore became "ready" - WaitSet observers can be linked only when value is zero, so there is no need to check
+	// them in the lock-free fast path above
+	for (auto observer = observersList_; observer != nullptr; observer = observer->getNext())
+		observer->notify();
+
+	return 0;
+}
+
+#if CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+int Semaphore::postDeferred()
 {
-	if (value_ == 0)	// lock not possible?
-		return EAGAIN;
+	auto& scheduler = scheduler::getScheduler();
+	auto& kernelCounters = scheduler.getKernelCounters();
+
+	// value is incremented right away, so overflow is detected before the request is queued - blocked threads (if any)
+	// receive the value later, in handOverValue()
+	auto value = __atomic_load_n(&value_, __ATOMIC_RELAXED);
+	do
+	{
+		if (value >= maxValue_)
+		{
+			__atomic_fetch_add(&kernelCounters.semaphoreOverflows, 1, __ATOMIC_RELAXED);
+			return EOVERFLOW;
+		}
+	} while (__atomic_compare_exchange_n(&value_, &value, value + 1, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED) ==
+			false);
+
+	__atomic_fetch_add(&kernelCounters.semaphorePosts, 1, __ATOMIC_RELAXED);
+
+	// threads block on semaphore and link WaitSet observers only with interrupt masking enabled, so neither list can
+	// become non-empty while any interrupt which can be masked by the kernel is running - if both are empty, there is
+	// nothing to hand the value over to; this is not true for interrupts with priority higher than kernel's BASEPRI, so
+	// post() must not be called from them (just like any other kernel function)
+	if (blockedList_.empty() == true && observersList_ == nullptr)
+		return 0;
 
-	--value_;
+	if (scheduler.getDeferredRequestQueue().push(*this) == false)	// queue is full?
+	{
+		architecture::InterruptMaskingLock interruptMaskingLock;
+		handOverValue(false);
+	}
 
 	return 0;
 }
 
+void Semaphore::handOverValue(const bool inContextSwitch)
+{
+	auto& scheduler = scheduler::getScheduler();
+
+	// value may be posted by several interrupts before the request is processed, so several threads may be unblocked
+	while (value_ != 0 && blockedList_.empty() == false)
+	{
+		--value_;
+		if (inContextSwitch == false)
+			scheduler.unblock(blockedList_.begin());
+		else
+			scheduler.unblockInContextSwitch(blockedList_.begin());
+	}
+
+	if (value_ == 0)
+		return;
+
+	for (auto observer = observersList_; observer != nullptr; observer = observer->getNext())
+		observer->notify(inContextSwitch);
+}
+
+#endif	// CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+int Semaphore::tryWaitInternal()
+{
+	auto value = __atomic_load_n(&value_, __ATOMIC_RELAXED);
+	while (value != 0)
+		if (__atomic_compare_exchange_n(&value_, &value, value - 1, true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) == true)
+			return 0;
+
+	return EAGAIN;	// lock not possible
+}
+
 }	// namespace distortos
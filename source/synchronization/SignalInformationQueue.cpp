@@ -8,12 +8,12 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-03-31
+ * \date 2015-05-31
  */
 
 #include "distortos/synchronization/SignalInformationQueue.hpp"
 
-#include "distortos/SignalSet.hpp"
+#include <new>
 
 #include <cerrno>
 
@@ -28,69 +28,66 @@ namespace synchronization
 +---------------------------------------------------------------------------------------------------------------------*/
 
 SignalInformationQueue::SignalInformationQueue(Storage* const storage, const size_t maxElements) :
-		pool_{},
-		poolAllocator_{pool_},
-		signalInformationList_{poolAllocator_},
-		freeSignalInformationList_{poolAllocator_}
+		lastQueued_{},
+		freeList_{},
+		queuedSignalsBitset_{}
 {
 	for (size_t i {}; i < maxElements; ++i)
-	{
-		pool_.feed(storage[i]);
-		freeSignalInformationList_.emplace_front(uint8_t{}, SignalInformation::Code{}, sigval{});
-	}
+		freeList_ = new (&storage[i]) LinkAndSignalInformation{freeList_,
+				SignalInformation{uint8_t{}, SignalInformation::Code{}, sigval{}}};
 }
 
 std::pair<int, SignalInformation> SignalInformationQueue::acceptQueuedSignal(const uint8_t signalNumber)
 {
-	auto it = signalInformationList_.before_begin();
-	auto next = signalInformationList_.begin();
-	const auto last = signalInformationList_.end();
+	if (signalNumber >= queuedSignalsBitset_.size() || lastQueued_[signalNumber] == nullptr)
+		return {EAGAIN, SignalInformation{uint8_t{}, SignalInformation::Code{}, sigval{}}};
 
-	while (next != last)
+	auto& last = lastQueued_[signalNumber];
+	const auto first = static_cast<LinkAndSignalInformation*>(last->first);
+	if (first == last)	// FIFO list of this signal number becomes empty?
 	{
-		if (next->getSignalNumber() == signalNumber)
-		{
-			const auto signalInformation = *next;
-			signalInformationList_.erase_after(it);
-			freeSignalInformationList_.emplace_front(uint8_t{}, SignalInformation::Code{}, sigval{});
-			return {0, signalInformation};
-		}
-
-		it = next;
-		++next;
+		last = nullptr;
+		queuedSignalsBitset_.reset(signalNumber);
 	}
+	else
+		last->first = first->first;
 
-	return {EAGAIN, SignalInformation{uint8_t{}, SignalInformation::Code{}, sigval{}}};
+	const auto signalInformation = first->second;
+	first->first = freeList_;
+	freeList_ = first;
+	return {0, signalInformation};
 }
 
 SignalSet SignalInformationQueue::getQueuedSignalSet() const
 {
-	SignalSet queuedSignalSet {SignalSet::empty};
-	for (const auto& signalInformation : signalInformationList_)
-		queuedSignalSet.add(signalInformation.getSignalNumber());
-	return queuedSignalSet;
+	return SignalSet{queuedSignalsBitset_};
 }
 
 int SignalInformationQueue::queueSignal(const uint8_t signalNumber, const sigval value)
 {
-	if (signalNumber >= SignalSet::Bitset{}.size())
+	if (signalNumber >= queuedSignalsBitset_.size())
 		return EINVAL;
 
-	if (freeSignalInformationList_.empty() == true)
+	if (freeList_ == nullptr)
 		return EAGAIN;
 
-	auto it = signalInformationList_.before_begin();
-	auto next = signalInformationList_.begin();
-	const auto last = signalInformationList_.end();
+	const auto element = freeList_;
+	freeList_ = static_cast<LinkAndSignalInformation*>(element->first);
+	element->second = SignalInformation{signalNumber, SignalInformation::Code::Queued, value};
 
-	while (next != last)	// find the iterator to the last element on the list ("before end")
+	// new element becomes the last one, so it is linked to the first one
+	auto& last = lastQueued_[signalNumber];
+	if (last == nullptr)	// FIFO list of this signal number is empty?
 	{
-		it = next;
-		++next;
+		element->first = element;
+		queuedSignalsBitset_.set(signalNumber);
 	}
-
-	freeSignalInformationList_.pop_front();
-	signalInformationList_.emplace_after(it, signalNumber, SignalInformation::Code::Queued, value);
+	else
+	{
+		element->first = last->first;
+		last->first = element;
+	}
+	last = element;
 	return 0;
 }
 
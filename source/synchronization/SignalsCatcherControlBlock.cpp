@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-05-06
+ * \date 2015-06-04
  */
 
 #include "distortos/synchronization/SignalsCatcherControlBlock.hpp"
@@ -65,27 +65,6 @@ std::pair<int, SignalInformation> acceptPendingUnblockedSignal(SignalsReceiverCo
 	return signalsReceiverControlBlock.acceptPendingSignal(signalNumber);
 }
 
-/**
- * \brief Tries to find SignalsCatcherControlBlock::Association for given signal number in given range.
- *
- * \param [in] begin is a pointer to first element of range of SignalsCatcherControlBlock::Association objects
- * \param [in] end is a pointer to "one past the last" element of range of SignalsCatcherControlBlock::Association
- * objects
- * \param [in] signalNumber is the signal for which the association will be searched
- *
- * \return pointer to found SignalsCatcherControlBlock::Association object, \e end if no match was found
- */
-
-SignalsCatcherControlBlock::Association* findAssociation(SignalsCatcherControlBlock::Association* const begin,
-		SignalsCatcherControlBlock::Association* const end, const uint8_t signalNumber)
-{
-	return std::find_if(begin, end,
-			[signalNumber](const SignalsCatcherControlBlock::Association& association)
-			{
-				return association.first == signalNumber;
-			});
-}
-
 /**
  * \brief Delivers all unmasked signals that are pending/queued for current thread.
  */
@@ -139,7 +118,7 @@ std::pair<int, SignalAction> SignalsCatcherControlBlock::getAssociation(const ui
 	if (signalNumber >= SignalSet::Bitset{}.size())
 		return {EINVAL, {}};
 
-	const auto association = findAssociation(associationsBegin_, associationsEnd_, signalNumber);
+	const auto association = findAssociation(signalNumber);
 	if (association == associationsEnd_)	// there is no association for this signal number?
 		return {{}, {}};
 
@@ -155,9 +134,7 @@ int SignalsCatcherControlBlock::postGenerate(const uint8_t signalNumber,
 	if (getAssociationResult.second.getHandler() == SignalAction{}.getHandler())	// default handler?
 		return 0;	// ignore signal
 
-	architecture::requestFunctionExecution(threadControlBlock, deliverSignals);
-
-	return 0;
+	return architecture::requestFunctionExecution(threadControlBlock, deliverSignals);
 }
 
 std::pair<int, SignalAction> SignalsCatcherControlBlock::setAssociation(const uint8_t signalNumber,
@@ -172,7 +149,7 @@ std::pair<int, SignalAction> SignalsCatcherControlBlock::setAssociation(const ui
 		return {{}, previousSignalAction};
 	}
 
-	const auto association = findAssociation(associationsBegin_, associationsEnd_, signalNumber);
+	const auto association = findAssociation(signalNumber);
 	if (association != associationsEnd_)	// there is an association for this signal number?
 	{
 		const auto previousSignalAction = association->second;
@@ -184,6 +161,9 @@ std::pair<int, SignalAction> SignalsCatcherControlBlock::setAssociation(const ui
 		return {EAGAIN, {}};
 
 	new (associationsEnd_) Association{signalNumber, signalAction};
+	if (indexTable_ != nullptr)
+		(*indexTable_)[signalNumber] = associationsEnd_ - associationsBegin_;
+	associatedBitset_[signalNumber] = true;
 	++associationsEnd_;
 	return {{}, {}};
 }
@@ -194,18 +174,36 @@ std::pair<int, SignalAction> SignalsCatcherControlBlock::setAssociation(const ui
 
 SignalAction SignalsCatcherControlBlock::clearAssociation(const uint8_t signalNumber)
 {
-	const auto association = findAssociation(associationsBegin_, associationsEnd_, signalNumber);
+	const auto association = findAssociation(signalNumber);
 	if (association == associationsEnd_)	// there is no association for this signal number?
 		return {};
 
 	const auto previousSignalAction = association->second;
 	const auto& lastAssociation = *(associationsEnd_ - 1);
 	*association = lastAssociation;	// replace removed association with the last association in the range
+	if (indexTable_ != nullptr)
+		(*indexTable_)[association->first] = association - associationsBegin_;
 	lastAssociation.~Association();
 	--associationsEnd_;
+	associatedBitset_[signalNumber] = false;
 	return previousSignalAction;
 }
 
+SignalsCatcherControlBlock::Association* SignalsCatcherControlBlock::findAssociation(const uint8_t signalNumber) const
+{
+	if (associatedBitset_[signalNumber] == false)	// there is no association for this signal number?
+		return associationsEnd_;
+
+	if (indexTable_ != nullptr)
+		return associationsBegin_ + (*indexTable_)[signalNumber];
+
+	return std::find_if(associationsBegin_, associationsEnd_,
+			[signalNumber](const Association& association)
+			{
+				return association.first == signalNumber;
+			});
+}
+
 }	// namespace synchronization
 
 }	// namespace distortos
@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-04-29
+ * \date 2015-05-24
  */
 
 #include "distortos/synchronization/SignalsReceiverControlBlock.hpp"
@@ -145,6 +145,8 @@ int SignalsReceiverControlBlock::postGenerate(const uint8_t signalNumber,
 {
 	/// \todo add some form of assertion for validity of \a signalNumber
 
+	++scheduler::getScheduler().getKernelCounters().signalDeliveries;
+
 	if (signalsCatcherControlBlock_ != nullptr)
 	{
 		const auto signalMask = signalsCatcherControlBlock_->getSignalMask();
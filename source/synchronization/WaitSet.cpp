@@ -0,0 +1,265 @@
+/**
+ * \file
+ * \brief WaitSet class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-16
+ */
+
+#include "distortos/WaitSet.hpp"
+
+#include "distortos/RawFifoQueue.hpp"
+#include "distortos/RawMessageQueue.hpp"
+
+#include "distortos/scheduler/getScheduler.hpp"
+#include "distortos/scheduler/Scheduler.hpp"
+
+#include "distortos/synchronization/SignalsReceiverControlBlock.hpp"
+
+#include "distortos/architecture/InterruptMaskingLock.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// WaitSetUnblockFunctor is a functor executed when unblocking a thread that is waiting on WaitSet
+class WaitSetUnblockFunctor : public scheduler::ThreadControlBlock::UnblockFunctor
+{
+public:
+
+	/**
+	 * \brief WaitSetUnblockFunctor's function call operator
+	 *
+	 * Clears pointer to set of signals that were "waited for".
+	 *
+	 * \param [in] threadControlBlock is a reference to ThreadControlBlock that is being unblocked
+	 */
+
+	void operator()(scheduler::ThreadControlBlock& threadControlBlock) const override
+	{
+		const auto signalsReceiverControlBlock = threadControlBlock.getSignalsReceiverControlBlock();
+		if (signalsReceiverControlBlock == nullptr)
+			return;
+
+		signalsReceiverControlBlock->setWaitingSignalSet(nullptr);
+	}
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+WaitSet::WaitSet(Storage* const storage, const size_t maxObjects) :
+		signalSet_{SignalSet::empty},
+		storage_{storage},
+		maxObjects_{maxObjects},
+		objects_{},
+		notificationIndex_{maxObjects},
+		signalsIndex_{maxObjects}
+{
+
+}
+
+std::pair<int, WaitSet::Index> WaitSet::add(RawFifoQueue& rawFifoQueue)
+{
+	return add(rawFifoQueue.fifoQueueBase_.getPopSemaphore());
+}
+
+std::pair<int, WaitSet::Index> WaitSet::add(RawMessageQueue& rawMessageQueue)
+{
+	return add(rawMessageQueue.messageQueueBase_.getPopSemaphore());
+}
+
+std::pair<int, WaitSet::Index> WaitSet::add(Semaphore& semaphore)
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	const auto ret = reserve();
+	if (ret.first != 0)
+		return ret;
+
+	storage_[ret.second].setSemaphore(semaphore);
+	return ret;
+}
+
+std::pair<int, WaitSet::Index> WaitSet::addNotification()
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	if (notificationIndex_ != maxObjects_)
+		return {EEXIST, notificationIndex_};
+
+	const auto ret = reserve();
+	if (ret.first != 0)
+		return ret;
+
+	notificationIndex_ = ret.second;
+	return ret;
+}
+
+std::pair<int, WaitSet::Index> WaitSet::addSignals(const SignalSet& signalSet)
+{
+	if (scheduler::getScheduler().getCurrentThreadControlBlock().getSignalsReceiverControlBlock() == nullptr)
+		return {ENOTSUP, {}};
+
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	if (signalsIndex_ == maxObjects_)
+	{
+		const auto ret = reserve();
+		if (ret.first != 0)
+			return ret;
+
+		signalsIndex_ = ret.second;
+	}
+
+	signalSet_ = SignalSet{signalSet_.getBitset() | signalSet.getBitset()};
+	return {{}, signalsIndex_};
+}
+
+std::pair<int, WaitSet::Index> WaitSet::tryWait()
+{
+	return waitImplementation(true, nullptr);
+}
+
+std::pair<int, WaitSet::Index> WaitSet::tryWaitFor(const TickClock::duration duration)
+{
+	return tryWaitUntil(TickClock::now() + duration + TickClock::duration{1});
+}
+
+std::pair<int, WaitSet::Index> WaitSet::tryWaitUntil(const TickClock::time_point timePoint)
+{
+	return waitImplementation(false, &timePoint);
+}
+
+std::pair<int, WaitSet::Index> WaitSet::wait()
+{
+	return waitImplementation(false, nullptr);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+std::pair<bool, WaitSet::Index> WaitSet::findReady() const
+{
+	const auto& threadControlBlock = scheduler::getScheduler().getCurrentThreadControlBlock();
+	const auto signalsReceiverControlBlock = threadControlBlock.getSignalsReceiverControlBlock();
+
+	for (Index index {}; index < objects_; ++index)
+	{
+		if (index == notificationIndex_)
+		{
+			if (threadControlBlock.isNotificationPending() == true)
+				return {true, index};
+		}
+		else if (index == signalsIndex_)
+		{
+			if (signalsReceiverControlBlock != nullptr &&
+					(signalsReceiverControlBlock->getPendingSignalSet().getBitset() & signalSet_.getBitset()).any() ==
+					true)
+				return {true, index};
+		}
+		else if (storage_[index].getSemaphore()->getValue() != 0)
+			return {true, index};
+	}
+
+	return {false, {}};
+}
+
+std::pair<int, WaitSet::Index> WaitSet::reserve()
+{
+	if (objects_ == maxObjects_)
+		return {ENOSPC, {}};
+
+	const auto index = objects_;
+	storage_[index] = Storage{};
+	++objects_;
+	return {{}, index};
+}
+
+std::pair<int, WaitSet::Index> WaitSet::waitImplementation(const bool nonBlocking,
+		const TickClock::time_point* const timePoint)
+{
+	auto& scheduler = scheduler::getScheduler();
+	auto& currentThreadControlBlock = scheduler.getCurrentThreadControlBlock();
+	const auto signalsReceiverControlBlock = currentThreadControlBlock.getSignalsReceiverControlBlock();
+
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	while (1)
+	{
+		const auto findReadyResult = findReady();
+		if (findReadyResult.first == true)
+			return {{}, findReadyResult.second};
+
+		if (nonBlocking == true)
+			return {EAGAIN, {}};
+
+		// semaphores are not "ready", so their values are zero - each post() which changes that will go through the
+		// "slow" path with interrupt masking and notify linked observers
+		for (Index index {}; index < objects_; ++index)
+		{
+			auto& observer = storage_[index];
+			const auto semaphore = observer.getSemaphore();
+			if (semaphore == nullptr)	// notification or signals?
+				continue;
+
+			observer.setThreadControlBlock(&currentThreadControlBlock);
+			observer.setNext(semaphore->observersList_);
+			semaphore->observersList_ = &observer;
+		}
+
+		if (signalsIndex_ != maxObjects_ && signalsReceiverControlBlock != nullptr)
+			signalsReceiverControlBlock->setWaitingSignalSet(&signalSet_);
+
+		scheduler::ThreadControlBlockList waitingList {scheduler.getThreadControlBlockListAllocator(),
+				scheduler::ThreadControlBlock::State::WaitingForWaitSet};
+
+		const WaitSetUnblockFunctor waitSetUnblockFunctor;
+		const auto ret = timePoint == nullptr ? scheduler.block(waitingList, &waitSetUnblockFunctor) :
+				scheduler.blockUntil(waitingList, *timePoint, &waitSetUnblockFunctor);
+
+		for (Index index {}; index < objects_; ++index)
+		{
+			auto& observer = storage_[index];
+			const auto semaphore = observer.getSemaphore();
+			if (semaphore == nullptr)	// notification or signals?
+				continue;
+
+			// observers of other WaitSets may have been linked after this one, so the list must be searched
+			synchronization::WaitSetObserver* previous {};
+			auto current = semaphore->observersList_;
+			while (current != &observer)
+			{
+				previous = current;
+				current = current->getNext();
+			}
+
+			if (previous == nullptr)
+				semaphore->observersList_ = observer.getNext();
+			else
+				previous->setNext(observer.getNext());
+		}
+
+		if (ret != 0)
+			return {ret, {}};
+	}
+}
+
+}	// namespace distortos
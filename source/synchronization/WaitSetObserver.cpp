@@ -0,0 +1,44 @@
+/**
+ * \file
+ * \brief WaitSetObserver class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#include "distortos/synchronization/WaitSetObserver.hpp"
+
+#include "distortos/scheduler/getScheduler.hpp"
+#include "distortos/scheduler/Scheduler.hpp"
+
+namespace distortos
+{
+
+namespace synchronization
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void WaitSetObserver::notify(const bool inContextSwitch) const
+{
+	// thread may be already unblocked by another observer
+	if (threadControlBlock_->getState() != scheduler::ThreadControlBlock::State::WaitingForWaitSet)
+		return;
+
+	auto& scheduler = scheduler::getScheduler();
+	if (inContextSwitch == false)
+		scheduler.unblock(threadControlBlock_->getIterator());
+	else
+		scheduler.unblockInContextSwitch(threadControlBlock_->getIterator());
+}
+
+}	// namespace synchronization
+
+}	// namespace distortos
@@ -0,0 +1,215 @@
+/**
+ * \file
+ * \brief waitOnAddress() and wakeAddress() implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-28
+ */
+
+#include "distortos/waitOnAddress.hpp"
+
+#include "distortos/scheduler/getScheduler.hpp"
+#include "distortos/scheduler/Scheduler.hpp"
+
+#include "distortos/architecture/InterruptMaskingLock.hpp"
+
+#include <iterator>
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// AddressUnblockFunctor is a functor executed when unblocking a thread that waits in waitOnAddress() - it is used only
+/// to keep the address on which the thread waits, so that wakeAddress() can find it via
+/// scheduler::ThreadControlBlock::getUnblockFunctor()
+class AddressUnblockFunctor : public scheduler::ThreadControlBlock::UnblockFunctor
+{
+public:
+
+	/**
+	 * \brief AddressUnblockFunctor's constructor
+	 *
+	 * \param [in] address is a pointer to 32-bit word on which the thread waits
+	 */
+
+	constexpr explicit AddressUnblockFunctor(const volatile uint32_t* const address) :
+			address_{address}
+	{
+
+	}
+
+	/**
+	 * \return pointer to 32-bit word on which the thread waits
+	 */
+
+	const volatile uint32_t* getAddress() const
+	{
+		return address_;
+	}
+
+	/**
+	 * \brief AddressUnblockFunctor's function call operator
+	 *
+	 * Does nothing.
+	 */
+
+	void operator()(scheduler::ThreadControlBlock&) const override
+	{
+
+	}
+
+private:
+
+	/// pointer to 32-bit word on which the thread waits
+	const volatile uint32_t* address_;
+};
+
+/// single bucket of hashed table of wait queues
+class Bucket
+{
+public:
+
+	/**
+	 * \brief Bucket's constructor
+	 *
+	 * \note Global objects are constructed after the scheduler is initialized (it's done in .preinit_array), so its
+	 * allocator is available here.
+	 */
+
+	Bucket() :
+			blockedList_{scheduler::getScheduler().getThreadControlBlockListAllocator(),
+					scheduler::ThreadControlBlock::State::WaitingForAddress}
+	{
+
+	}
+
+	/**
+	 * \return reference to list of threads waiting on addresses which belong to this bucket
+	 */
+
+	scheduler::ThreadControlBlockList& getBlockedList()
+	{
+		return blockedList_;
+	}
+
+private:
+
+	/// ThreadControlBlock objects waiting on addresses which belong to this bucket
+	scheduler::ThreadControlBlockList blockedList_;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// hashed table of wait queues
+Bucket buckets[CONFIG_WAIT_ON_ADDRESS_BUCKETS];
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Finds bucket for given address.
+ *
+ * \param [in] address is a pointer to 32-bit word
+ *
+ * \return reference to list of threads waiting on addresses which belong to the same bucket as \a address
+ */
+
+scheduler::ThreadControlBlockList& getBlockedList(const volatile uint32_t* const address)
+{
+	// two least significant bits of aligned address are always zero
+	const auto index = (reinterpret_cast<uintptr_t>(address) / sizeof(*address)) % CONFIG_WAIT_ON_ADDRESS_BUCKETS;
+	return buckets[index].getBlockedList();
+}
+
+/**
+ * \brief Implementation of waitOnAddress() and tryWaitOnAddressUntil().
+ *
+ * \param [in] address is a pointer to 32-bit word on which the calling thread will wait
+ * \param [in] expected is the expected value of the word
+ * \param [in] timePoint is a pointer to time point at which the wait will be terminated, nullptr to block without
+ * timeout
+ *
+ * \return 0 if the thread was woken with wakeAddress(), error code otherwise:
+ * - EAGAIN - value of the word was not equal to \a expected;
+ * - ETIMEDOUT - the thread was not woken before specified \a timePoint;
+ */
+
+int waitOnAddressImplementation(const volatile uint32_t* const address, const uint32_t expected,
+		const TickClock::time_point* const timePoint)
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	if (*address != expected)
+		return EAGAIN;
+
+	const AddressUnblockFunctor unblockFunctor {address};
+	auto& scheduler = scheduler::getScheduler();
+	auto& blockedList = getBlockedList(address);
+	return timePoint == nullptr ? scheduler.block(blockedList, &unblockFunctor) :
+			scheduler.blockUntil(blockedList, *timePoint, &unblockFunctor);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int tryWaitOnAddressFor(const volatile uint32_t* const address, const uint32_t expected,
+		const TickClock::duration duration)
+{
+	return tryWaitOnAddressUntil(address, expected, TickClock::now() + duration + TickClock::duration{1});
+}
+
+int tryWaitOnAddressUntil(const volatile uint32_t* const address, const uint32_t expected,
+		const TickClock::time_point timePoint)
+{
+	return waitOnAddressImplementation(address, expected, &timePoint);
+}
+
+int waitOnAddress(const volatile uint32_t* const address, const uint32_t expected)
+{
+	return waitOnAddressImplementation(address, expected, nullptr);
+}
+
+size_t wakeAddress(const volatile uint32_t* const address, const size_t count)
+{
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	auto& scheduler = scheduler::getScheduler();
+	auto& blockedList = getBlockedList(address);
+	size_t woken {};
+	auto iterator = blockedList.begin();
+	while (iterator != blockedList.end() && woken < count)
+	{
+		const auto next = std::next(iterator);
+		// all threads on this list were blocked with AddressUnblockFunctor
+		const auto unblockFunctor = static_cast<const AddressUnblockFunctor*>(iterator->get().getUnblockFunctor());
+		if (unblockFunctor->getAddress() == address)
+		{
+			scheduler.unblock(iterator);
+			++woken;
+		}
+		iterator = next;
+	}
+
+	return woken;
+}
+
+}	// namespace distortos
@@ -0,0 +1,69 @@
+/**
+ * \file
+ * \brief PeriodicActivation class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-22
+ */
+
+#include "distortos/PeriodicActivation.hpp"
+
+#include <algorithm>
+
+namespace distortos
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void PeriodicActivation::start(const TickClock::time_point firstRelease)
+{
+	releaseTimePoint_ = firstRelease - period_;
+	minimumReleaseLatency_ = HighResolutionClock::duration::max();
+	maximumReleaseLatency_ = {};
+	totalReleaseLatency_ = {};
+	activationCount_ = {};
+	missedDeadlineCount_ = {};
+	overrunCount_ = {};
+}
+
+void PeriodicActivation::waitForNextPeriod()
+{
+	auto nextReleaseTimePoint = releaseTimePoint_ + period_;
+
+	// there is no activation to check before first release
+	if (activationCount_ != 0)
+	{
+		const auto now = TickClock::now();
+
+		if (now >= releaseTimePoint_ + deadline_)
+			++missedDeadlineCount_;
+
+		if (now >= nextReleaseTimePoint)
+		{
+			const auto overruns = (now - nextReleaseTimePoint) / period_ + 1;
+			overrunCount_ += overruns;
+			nextReleaseTimePoint += period_ * overruns;
+
+			if (overrunHook_ != nullptr)
+				overrunHook_(*this);
+		}
+	}
+
+	ThisThread::sleepUntil(nextReleaseTimePoint);
+
+	const HighResolutionClock::duration releaseLatency {HighResolutionClock::now() - nextReleaseTimePoint};
+	releaseTimePoint_ = nextReleaseTimePoint;
+	++activationCount_;
+	minimumReleaseLatency_ = std::min(minimumReleaseLatency_, releaseLatency);
+	maximumReleaseLatency_ = std::max(maximumReleaseLatency_, releaseLatency);
+	totalReleaseLatency_ += releaseLatency;
+}
+
+}	// namespace distortos
@@ -8,20 +8,74 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-03-03
+ * \date 2015-05-26
  */
 
 #include "distortos/ThisThread.hpp"
 
+#include "distortos/PeriodicActivation.hpp"
+#include "distortos/ThreadBase.hpp"
+
 #include "distortos/scheduler/getScheduler.hpp"
 #include "distortos/scheduler/Scheduler.hpp"
 
+#include "distortos/architecture/InterruptMaskingLock.hpp"
+
+#include <cerrno>
+
 namespace distortos
 {
 
 namespace ThisThread
 {
 
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Implementation of distortos::ThisThread::waitNotification(), distortos::ThisThread::tryWaitNotification() and
+ * distortos::ThisThread::tryWaitNotificationUntil().
+ *
+ * \param [in] nonBlocking selects whether this function operates in blocking mode (false) or non-blocking mode (true)
+ * \param [in] timePoint is a pointer to time point at which the wait for notification will be terminated, used only if
+ * blocking mode is selected, nullptr to block without timeout
+ *
+ * \return pair with return code (0 on success, error code otherwise) and value of accepted notification; error codes:
+ * - EAGAIN - no notification was pending and non-blocking mode was selected;
+ * - ETIMEDOUT - no notification was sent before specified \a timePoint;
+ */
+
+std::pair<int, uint32_t> waitNotificationImplementation(const bool nonBlocking,
+		const TickClock::time_point* const timePoint)
+{
+	auto& scheduler = scheduler::getScheduler();
+	auto& currentThreadControlBlock = scheduler.getCurrentThreadControlBlock();
+
+	architecture::InterruptMaskingLock interruptMaskingLock;
+
+	if (currentThreadControlBlock.isNotificationPending() == false)
+	{
+		if (nonBlocking == true)
+			return {EAGAIN, {}};
+
+		scheduler::ThreadControlBlockList waitingList {scheduler.getThreadControlBlockListAllocator(),
+				scheduler::ThreadControlBlock::State::WaitingForNotification};
+
+		const auto ret = timePoint == nullptr ? scheduler.block(waitingList) :
+				scheduler.blockUntil(waitingList, *timePoint);
+		if (ret != 0)
+			return {ret, {}};
+	}
+
+	return {0, currentThreadControlBlock.acceptNotification()};
+}
+
+}	// namespace
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | global functions
 +---------------------------------------------------------------------------------------------------------------------*/
@@ -46,6 +100,34 @@ void setPriority(const uint8_t priority, const bool alwaysBehind)
 	scheduler::getScheduler().getCurrentThreadControlBlock().setPriority(priority, alwaysBehind);
 }
 
+int startPeriodic(PeriodicActivation& periodicActivation, const TickClock::time_point firstRelease)
+{
+	auto& currentThreadControlBlock = scheduler::getScheduler().getCurrentThreadControlBlock();
+
+	if (currentThreadControlBlock.getPeriodicActivation() != nullptr)
+		return EBUSY;
+
+	periodicActivation.start(firstRelease);
+	currentThreadControlBlock.setPeriodicActivation(&periodicActivation);
+	return 0;
+}
+
+int startPeriodic(PeriodicActivation& periodicActivation)
+{
+	return startPeriodic(periodicActivation, TickClock::now());
+}
+
+int stopPeriodic()
+{
+	auto& currentThreadControlBlock = scheduler::getScheduler().getCurrentThreadControlBlock();
+
+	if (currentThreadControlBlock.getPeriodicActivation() == nullptr)
+		return EINVAL;
+
+	currentThreadControlBlock.setPeriodicActivation(nullptr);
+	return 0;
+}
+
 void sleepFor(const TickClock::duration duration)
 {
 	sleepUntil(TickClock::now() + duration + TickClock::duration{1});
@@ -59,11 +141,46 @@ void sleepUntil(const TickClock::time_point timePoint)
 	scheduler.blockUntil(sleepingList, timePoint);
 }
 
+std::pair<int, uint32_t> tryWaitNotification()
+{
+	return waitNotificationImplementation(true, nullptr);	// non-blocking mode
+}
+
+std::pair<int, uint32_t> tryWaitNotificationFor(const TickClock::duration duration)
+{
+	return tryWaitNotificationUntil(TickClock::now() + duration + TickClock::duration{1});
+}
+
+std::pair<int, uint32_t> tryWaitNotificationUntil(const TickClock::time_point timePoint)
+{
+	return waitNotificationImplementation(false, &timePoint);	// blocking mode, with timeout
+}
+
+std::pair<int, uint32_t> waitNotification()
+{
+	return waitNotificationImplementation(false, nullptr);	// blocking mode, no timeout
+}
+
+int waitForNextPeriod()
+{
+	const auto periodicActivation = scheduler::getScheduler().getCurrentThreadControlBlock().getPeriodicActivation();
+	if (periodicActivation == nullptr)
+		return EINVAL;
+
+	periodicActivation->waitForNextPeriod();
+	return 0;
+}
+
 void yield()
 {
 	scheduler::getScheduler().yield();
 }
 
+int yieldTo(ThreadBase& thread)
+{
+	return scheduler::getScheduler().yieldTo(thread.getThreadControlBlock());
+}
+
 }	// namespace ThisThread
 
 }	// namespace distortos
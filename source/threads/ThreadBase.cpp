@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-03-31
+ * \date 2015-06-03
  */
 
 #include "distortos/ThreadBase.hpp"
@@ -30,17 +30,18 @@ namespace distortos
 
 ThreadBase::ThreadBase(void* const buffer, const size_t size, const uint8_t priority,
 		const SchedulingPolicy schedulingPolicy, scheduler::ThreadGroupControlBlock* const threadGroupControlBlock,
-		SignalsReceiver* const signalsReceiver) :
+		SignalsReceiver* const signalsReceiver, _reent* const reent) :
 		ThreadBase{{buffer, size, threadRunner, *this}, priority, schedulingPolicy, threadGroupControlBlock,
-				signalsReceiver}
+				signalsReceiver, reent}
 {
 
 }
 
 ThreadBase::ThreadBase(architecture::Stack&& stack, const uint8_t priority, const SchedulingPolicy schedulingPolicy,
-		scheduler::ThreadGroupControlBlock* const threadGroupControlBlock, SignalsReceiver* const signalsReceiver) :
+		scheduler::ThreadGroupControlBlock* const threadGroupControlBlock, SignalsReceiver* const signalsReceiver,
+		_reent* const reent) :
 		threadControlBlock_{std::move(stack), priority, schedulingPolicy, threadGroupControlBlock, signalsReceiver,
-				*this},
+				reent, *this},
 		joinSemaphore_{0}
 {
 
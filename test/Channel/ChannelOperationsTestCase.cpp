@@ -0,0 +1,144 @@
+/**
+ * \file
+ * \brief ChannelOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-27
+ */
+
+#include "ChannelOperationsTestCase.hpp"
+
+#include "distortos/Channel.hpp"
+#include "distortos/StaticThread.hpp"
+#include "distortos/ThisThread.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// reply sent by server
+struct Reply
+{
+	/// request multiplied by 2
+	uint32_t value;
+
+	/// effective priority of server when it was handling the request
+	uint8_t serverPriority;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of stack for server thread, bytes
+constexpr size_t serverThreadStackSize {384};
+
+/// priority of server thread
+constexpr uint8_t serverThreadPriority {1};
+
+/// number of requests handled by server thread
+constexpr size_t requests {2};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Server thread - receives \a requests requests and replies to them.
+ *
+ * \param [in] channel is a reference to Channel used for communication
+ * \param [out] sharedRet is a reference to variable which will be set to false if any operation fails
+ */
+
+void serverThread(Channel& channel, bool& sharedRet)
+{
+	for (size_t i = 0; i < requests; ++i)
+	{
+		const auto receiveResult = channel.receive();
+		if (receiveResult.first != 0)
+		{
+			sharedRet = false;
+			return;
+		}
+
+		auto& message = *receiveResult.second;
+		if (message.getRequestSize() != sizeof(uint32_t) || message.getReplySize() != sizeof(Reply))
+			sharedRet = false;
+
+		// request and reply are accessed directly in client's buffers
+		auto& reply = *static_cast<Reply*>(message.getReply());
+		reply.value = *static_cast<const uint32_t*>(message.getRequest()) * 2;
+		reply.serverPriority = ThisThread::getEffectivePriority();
+
+		if (channel.reply(message) != 0 || channel.reply(message) != EINVAL)
+			sharedRet = false;
+	}
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool ChannelOperationsTestCase::run_() const
+{
+	Channel channel;
+	bool sharedRet {true};
+	auto server = makeStaticThread<serverThreadStackSize>(serverThreadPriority, serverThread, std::ref(channel),
+			std::ref(sharedRet));
+
+	{
+		// no clients, current thread may act as server
+		const auto tryReceiveResult = channel.tryReceive();
+		const auto tryReceiveForResult = channel.tryReceiveFor(TickClock::duration{1});
+		if (tryReceiveResult.first != EAGAIN || tryReceiveForResult.first != ETIMEDOUT)
+			return false;
+	}
+
+	server.start();
+
+	for (uint32_t request = 1; request <= requests; ++request)
+	{
+		Reply reply {};
+		const auto ret = channel.send(request, reply);
+		// server inherited priority of current thread, but it no longer has it after reply
+		if (ret != 0 || reply.value != request * 2 || reply.serverPriority != ThisThread::getEffectivePriority() ||
+				server.getEffectivePriority() != serverThreadPriority)
+			return false;
+
+		if (request == 1)
+		{
+			ThisThread::sleepFor(TickClock::duration{1});	// let the server block in receive()
+
+			// server is blocked in receive(), so current thread can't receive
+			const auto tryReceiveResult = channel.tryReceive();
+			if (tryReceiveResult.first != EBUSY)
+				return false;
+		}
+	}
+
+	server.join();
+
+	return sharedRet;
+}
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,49 @@
+/**
+ * \file
+ * \brief ChannelOperationsTestCase class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-27
+ */
+
+#ifndef TEST_CHANNEL_CHANNELOPERATIONSTESTCASE_HPP_
+#define TEST_CHANNEL_CHANNELOPERATIONSTESTCASE_HPP_
+
+#include "TestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests Channel operations.
+ *
+ * Tests whether request and reply are transferred between client and server, whether the server inherits priority of
+ * the client and whether invalid use of the Channel is rejected.
+ */
+
+class ChannelOperationsTestCase : public TestCase
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	virtual bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_CHANNEL_CHANNELOPERATIONSTESTCASE_HPP_
@@ -0,0 +1,36 @@
+/**
+ * \file
+ * \brief channelTestCases object declaration
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-27
+ */
+
+#ifndef TEST_CHANNEL_CHANNELTESTCASES_HPP_
+#define TEST_CHANNEL_CHANNELTESTCASES_HPP_
+
+#include "TestCaseRange.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// range of references to TestCase objects related to Channel
+extern const TestCaseRange channelTestCases;
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_CHANNEL_CHANNELTESTCASES_HPP_
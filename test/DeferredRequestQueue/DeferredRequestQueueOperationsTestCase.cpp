@@ -0,0 +1,110 @@
+/**
+ * \file
+ * \brief DeferredRequestQueueOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#include "DeferredRequestQueueOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/Semaphore.hpp"
+#include "distortos/SoftwareTimer.hpp"
+#include "distortos/statistics.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+#if CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// long duration used in tests
+constexpr auto longDuration = singleDuration * 10;
+
+/// expected number of context switches: 1 - main thread blocks on semaphore (main -> idle), 2 - deferred request is
+/// processed (idle -> main)
+constexpr decltype(statistics::getContextSwitchCount()) contextSwitchCount {2};
+
+}	// namespace
+
+#endif	// CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool DeferredRequestQueueOperationsTestCase::run_() const
+{
+#if CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+	Semaphore semaphore {0, 1};
+	int ret1 {};
+	int ret2 {};
+	Semaphore::Value value {};
+
+	auto softwareTimer = makeSoftwareTimer(
+			[&semaphore, &ret1, &ret2, &value]()
+			{
+				// value is incremented right away, so second post exceeds max value of semaphore, even though the
+				// main thread will take the value of first post
+				ret1 = semaphore.post();
+				value = semaphore.getValue();
+				ret2 = semaphore.post();
+			});
+
+	waitForNextTick();
+
+	const auto before = statistics::getKernelCounters();
+	const auto contextSwitchCountBefore = statistics::getContextSwitchCount();
+	const auto wakeUpTimePoint = TickClock::now() + longDuration;
+	softwareTimer.start(wakeUpTimePoint);
+
+	// semaphore is currently locked, but wait() should succeed at expected time, when deferred request is processed
+	const auto ret = semaphore.wait();
+	const auto wokenUpTimePoint = TickClock::now();
+	const auto after = statistics::getKernelCounters();
+
+	if (ret != 0 || wakeUpTimePoint != wokenUpTimePoint || semaphore.getValue() != 0 || ret1 != 0 || value != 1 ||
+			ret2 != EOVERFLOW)
+		return false;
+
+	// processing of deferred request must not request another context switch
+	if (statistics::getContextSwitchCount() - contextSwitchCountBefore != contextSwitchCount)
+		return false;
+
+	if (after.deferredRequests - before.deferredRequests != 1 ||
+			after.deferredRequestOverflows - before.deferredRequestOverflows != 0 ||
+			after.semaphorePosts - before.semaphorePosts != 1 ||
+			after.semaphoreOverflows - before.semaphoreOverflows != 1 ||
+			after.unblocks.semaphore - before.unblocks.semaphore != 1)
+		return false;
+
+#endif	// CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
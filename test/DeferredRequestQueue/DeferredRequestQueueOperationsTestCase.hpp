@@ -0,0 +1,53 @@
+/**
+ * \file
+ * \brief DeferredRequestQueueOperationsTestCase class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#ifndef TEST_DEFERREDREQUESTQUEUE_DEFERREDREQUESTQUEUEOPERATIONSTESTCASE_HPP_
+#define TEST_DEFERREDREQUESTQUEUE_DEFERREDREQUESTQUEUEOPERATIONSTESTCASE_HPP_
+
+#include "TestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests deferred processing of Semaphore::post() done in interrupt context.
+ *
+ * Software timer posts a semaphore on which main thread waits. Tests whether the post from interrupt is deferred,
+ * whether its result (including EOVERFLOW) and new value of semaphore are visible in the interrupt right away, whether
+ * main thread is unblocked at expected time point and whether no redundant context switch is done while processing the
+ * deferred request.
+ *
+ * \note Test is effective only when CONFIG_DEFERRED_INTERRUPT_REQUESTS == 1, otherwise it always succeeds.
+ */
+
+class DeferredRequestQueueOperationsTestCase : public TestCase
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	virtual bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_DEFERREDREQUESTQUEUE_DEFERREDREQUESTQUEUEOPERATIONSTESTCASE_HPP_
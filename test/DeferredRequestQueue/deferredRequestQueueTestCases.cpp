@@ -0,0 +1,50 @@
+/**
+ * \file
+ * \brief deferredRequestQueueTestCases object definition
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#include "deferredRequestQueueTestCases.hpp"
+
+#include "DeferredRequestQueueOperationsTestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// DeferredRequestQueueOperationsTestCase instance
+const DeferredRequestQueueOperationsTestCase operationsTestCase;
+
+/// array with references to TestCase objects related to deferred interrupt requests
+const TestCaseRange::value_type deferredRequestQueueTestCases_[]
+{
+		TestCaseRange::value_type{operationsTestCase},
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+const TestCaseRange deferredRequestQueueTestCases {deferredRequestQueueTestCases_};
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,36 @@
+/**
+ * \file
+ * \brief deferredRequestQueueTestCases object declaration
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#ifndef TEST_DEFERREDREQUESTQUEUE_DEFERREDREQUESTQUEUETESTCASES_HPP_
+#define TEST_DEFERREDREQUESTQUEUE_DEFERREDREQUESTQUEUETESTCASES_HPP_
+
+#include "TestCaseRange.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// range of references to TestCase objects related to deferred interrupt requests
+extern const TestCaseRange deferredRequestQueueTestCases;
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_DEFERREDREQUESTQUEUE_DEFERREDREQUESTQUEUETESTCASES_HPP_
@@ -0,0 +1,93 @@
+/**
+ * \file
+ * \brief HighResolutionClockOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-19
+ */
+
+#include "HighResolutionClockOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/HighResolutionClock.hpp"
+#include "distortos/ThisThread.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// number of ticks during which monotonicity of HighResolutionClock is checked
+constexpr auto ticks = 3;
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool HighResolutionClockOperationsTestCase::run_() const
+{
+	{
+		waitForNextTick();
+
+		// clock must be monotonic (especially at tick boundaries, where "tick" interrupt may be pending) and it must be
+		// consistent with TickClock
+		const auto end = TickClock::now() + singleDuration * ticks;
+		auto previous = HighResolutionClock::now();
+		bool advanced {};
+		while (TickClock::now() < end)
+		{
+			const auto before = TickClock::now();
+			const auto now = HighResolutionClock::now();
+			const auto after = TickClock::now();
+
+			const auto nowInTicks = std::chrono::time_point_cast<TickClock::duration>(now);
+			if (now < previous || nowInTicks < before || nowInTicks > after)
+				return false;
+
+			// clock must advance between ticks
+			if (now > previous && nowInTicks == before)
+				advanced = true;
+
+			previous = now;
+		}
+
+		if (advanced != true)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		// time point of HighResolutionClock can be used directly with kernel functions - value is truncated to ticks
+		const auto start = TickClock::now();
+		const auto wakeUpTimePoint = HighResolutionClock::now() + singleDuration;
+		ThisThread::sleepUntil(wakeUpTimePoint);
+		if (TickClock::now() != start + singleDuration)
+			return false;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,50 @@
+/**
+ * \file
+ * \brief highResolutionClockTestCases object definition
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-19
+ */
+
+#include "highResolutionClockTestCases.hpp"
+
+#include "HighResolutionClockOperationsTestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// HighResolutionClockOperationsTestCase instance
+const HighResolutionClockOperationsTestCase operationsTestCase;
+
+/// array with references to TestCase objects related to HighResolutionClock
+const TestCaseRange::value_type highResolutionClockTestCases_[]
+{
+		TestCaseRange::value_type{operationsTestCase},
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+const TestCaseRange highResolutionClockTestCases {highResolutionClockTestCases_};
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,115 @@
+/**
+ * \file
+ * \brief IdleOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-21
+ */
+
+#include "IdleOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+#include "wasteTime.hpp"
+
+#include "distortos/setIdleHook.hpp"
+#include "distortos/statistics.hpp"
+#include "distortos/ThisThread.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// number of ticks during which main thread sleeps (or is busy) in tests
+constexpr auto ticks = 10;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// number of executions of testIdleHook()
+volatile uint32_t idleHookCount;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Idle hook used in test - increments \a idleHookCount
+ */
+
+void testIdleHook()
+{
+	++idleHookCount;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool IdleOperationsTestCase::run_() const
+{
+	{
+		waitForNextTick();
+
+		// main thread sleeps, so almost whole time is spent in idle thread - only interrupts are not excluded
+		const auto idleTime = statistics::getIdleTime();
+		const auto start = HighResolutionClock::now();
+		ThisThread::sleepFor(singleDuration * ticks);
+		const auto realDuration = HighResolutionClock::now() - start;
+		const auto idleDuration = statistics::getIdleTime() - idleTime;
+		if (idleDuration > realDuration || idleDuration < realDuration - singleDuration)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		// main thread is busy, so idle thread must not run at all
+		const auto idleTime = statistics::getIdleTime();
+		wasteTime(singleDuration * ticks);
+		if (statistics::getIdleTime() != idleTime)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		idleHookCount = 0;
+		const auto previousIdleHook = setIdleHook(testIdleHook);
+		ThisThread::sleepFor(singleDuration * ticks);
+		const auto restoredIdleHook = setIdleHook(previousIdleHook);
+		if (restoredIdleHook != testIdleHook || idleHookCount == 0)
+			return false;
+
+		// after the hook is disabled it must not be executed anymore
+		const auto count = idleHookCount;
+		ThisThread::sleepFor(singleDuration * ticks);
+		if (previousIdleHook == nullptr && idleHookCount != count)
+			return false;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
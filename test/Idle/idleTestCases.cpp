@@ -0,0 +1,50 @@
+/**
+ * \file
+ * \brief idleTestCases object definition
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-21
+ */
+
+#include "idleTestCases.hpp"
+
+#include "IdleOperationsTestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// IdleOperationsTestCase instance
+const IdleOperationsTestCase operationsTestCase;
+
+/// array with references to TestCase objects related to idle thread
+const TestCaseRange::value_type idleTestCases_[]
+{
+		TestCaseRange::value_type{operationsTestCase},
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+const TestCaseRange idleTestCases {idleTestCases_};
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,308 @@
+/**
+ * \file
+ * \brief BasicMutexOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#include "BasicMutexOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/BasicMutex.hpp"
+#include "distortos/StaticThread.hpp"
+#include "distortos/ThisThread.hpp"
+#include "distortos/statistics.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// long duration used in tests
+constexpr auto longDuration = singleDuration * 10;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Tests locking and unlocking of BasicMutex by current thread.
+ *
+ * The mutex is locked with all locking functions, expected results depend on the type of mutex. Effective priority of
+ * current thread is checked while the mutex is locked and after it is unlocked.
+ *
+ * \param type is the type of mutex
+ * \param protocol is the mutex protocol
+ *
+ * \param [in] priorityCeiling is the priority ceiling of mutex, must not be lower than priority of current thread
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+template<Mutex::Type type, Mutex::Protocol protocol>
+bool testBasicMutex(const uint8_t priorityCeiling)
+{
+	BasicMutex<type, protocol> mutex {priorityCeiling};
+	const auto priority = ThisThread::getPriority();
+	const auto boostedPriority = protocol == Mutex::Protocol::PriorityProtect ? priorityCeiling : priority;
+
+	{
+		// simple lock - must succeed immediately
+		waitForNextTick();
+		const auto start = TickClock::now();
+		const auto ret = mutex.lock();
+		if (ret != 0 || start != TickClock::now() || ThisThread::getEffectivePriority() != boostedPriority)
+			return false;
+	}
+
+	size_t locks {1};
+
+	{
+		// re-lock attempt - must succeed for recursive mutex, fail with EBUSY otherwise, immediately
+		waitForNextTick();
+		const auto start = TickClock::now();
+		const auto ret = mutex.tryLock();
+		if (ret != (type == Mutex::Type::Recursive ? 0 : EBUSY) || start != TickClock::now())
+			return false;
+		locks += ret == 0;
+	}
+
+	if (type != Mutex::Type::Normal)
+	{
+		// re-lock attempt - must succeed for recursive mutex, fail with EDEADLK otherwise, immediately
+		waitForNextTick();
+		const auto start = TickClock::now();
+		const auto ret = mutex.tryLockFor(singleDuration);
+		if (ret != (type == Mutex::Type::Recursive ? 0 : EDEADLK) || start != TickClock::now())
+			return false;
+		locks += ret == 0;
+	}
+
+	while (locks-- != 0)
+	{
+		// simple unlock - must succeed immediately
+		waitForNextTick();
+		const auto start = TickClock::now();
+		const auto ret = mutex.unlock();
+		if (ret != 0 || start != TickClock::now())
+			return false;
+	}
+
+	if (ThisThread::getEffectivePriority() != priority)
+		return false;
+
+	if (type != Mutex::Type::Normal)
+	{
+		// excessive unlock - must fail with EPERM immediately
+		waitForNextTick();
+		const auto start = TickClock::now();
+		const auto ret = mutex.unlock();
+		if (ret != EPERM || start != TickClock::now())
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Tests lock transfer in lock(), tryLockFor() and tryLockUntil() functions of BasicMutex.
+ *
+ * Mutex is locked in another thread and current thread waits for this mutex to become available. Test thread unlocks
+ * the mutex at specified time point, current thread is expected to acquire ownership of this mutex in the same moment.
+ *
+ * \param type is the type of mutex
+ * \param protocol is the mutex protocol
+ *
+ * \param [in] priority is the priority of current thread and test thread
+ * \param [in] priorityCeiling is the priority ceiling of mutex, must not be lower than \a priority
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+template<Mutex::Type type, Mutex::Protocol protocol>
+bool testBasicMutexTransfer(const uint8_t priority, const uint8_t priorityCeiling)
+{
+	constexpr size_t testThreadStackSize {384};
+
+	BasicMutex<type, protocol> mutex {priorityCeiling};
+
+	const auto sleepUntilFunctor = [&mutex](const TickClock::time_point timePoint)
+			{
+				mutex.lock();
+				ThisThread::sleepUntil(timePoint);
+				mutex.unlock();
+			};
+
+	for (size_t i {}; i < 3; ++i)
+	{
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeStaticThread<testThreadStackSize>(priority, sleepUntilFunctor, wakeUpTimePoint);
+
+		waitForNextTick();
+		thread.start();
+		ThisThread::yield();
+
+		// mutex is currently locked, but lock(), tryLockFor() and tryLockUntil() should succeed at expected time
+		const auto ret = i == 0 ? mutex.lock() : i == 1 ?
+				mutex.tryLockFor(wakeUpTimePoint - TickClock::now() + longDuration) :
+				mutex.tryLockUntil(wakeUpTimePoint + longDuration);
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret != 0 || wakeUpTimePoint != wokenUpTimePoint)
+			return false;
+
+		// ownership was transferred to current thread, so the mutex must be locked now
+		const auto tryRet = mutex.tryLock();
+		if (tryRet != (type == Mutex::Type::Recursive ? 0 : EBUSY))
+			return false;
+		if (tryRet == 0 && mutex.unlock() != 0)
+			return false;
+
+		if (mutex.unlock() != 0)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Tests competitive unlocking mode of BasicMutex.
+ *
+ * Current thread locks the mutex and test thread with the same priority blocks on it. Current thread unlocks the mutex
+ * and immediately locks it again - this must succeed without any context switch, as the ownership is not transferred
+ * to the unblocked test thread. Test thread is expected to acquire the mutex after current thread unlocks it for the
+ * second time.
+ *
+ * \param type is the type of mutex
+ * \param protocol is the mutex protocol
+ *
+ * \param [in] priority is the priority of current thread and test thread
+ * \param [in] priorityCeiling is the priority ceiling of mutex, must not be lower than \a priority
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+template<Mutex::Type type, Mutex::Protocol protocol>
+bool testBasicMutexCompetitive(const uint8_t priority, const uint8_t priorityCeiling)
+{
+	constexpr size_t testThreadStackSize {256};
+
+	BasicMutex<type, protocol> mutex {priorityCeiling, true};
+
+	if (mutex.lock() != 0)
+		return false;
+
+	int sharedRet {EINVAL};
+	auto thread = makeStaticThread<testThreadStackSize>(priority, [&mutex, &sharedRet]()
+			{
+				sharedRet = mutex.lock();
+				if (sharedRet == 0)
+					sharedRet = mutex.unlock();
+			});
+
+	thread.start();
+	ThisThread::yield();
+
+	waitForNextTick();
+
+	// competitive unlock doesn't transfer ownership to blocked test thread, so the mutex can be locked again immediately
+	const auto contextSwitchCount = statistics::getContextSwitchCount();
+	const auto unlockRet = mutex.unlock();
+	const auto lockRet = mutex.lock();
+	const auto relocked = unlockRet == 0 && lockRet == 0 &&
+			statistics::getContextSwitchCount() == contextSwitchCount;
+
+	const auto ret = mutex.unlock();
+	thread.join();
+	return relocked == true && ret == 0 && sharedRet == 0;
+}
+
+/**
+ * \brief Runs all tests of BasicMutex with given type and protocol.
+ *
+ * \param type is the type of mutex
+ * \param protocol is the mutex protocol
+ *
+ * \param [in] priority is the priority of current thread
+ * \param [in] priorityCeiling is the priority ceiling of mutex, must not be lower than \a priority
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+template<Mutex::Type type, Mutex::Protocol protocol>
+bool testBasicMutexAll(const uint8_t priority, const uint8_t priorityCeiling)
+{
+	return testBasicMutex<type, protocol>(priorityCeiling) == true &&
+			testBasicMutexTransfer<type, protocol>(priority, priorityCeiling) == true &&
+			testBasicMutexCompetitive<type, protocol>(priority, priorityCeiling) == true;
+}
+
+/**
+ * \brief Tests locking and unlocking of BasicMutex with given type, for all protocols.
+ *
+ * \param type is the type of mutex
+ *
+ * \param [in] priority is the priority of current thread
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+template<Mutex::Type type>
+bool testBasicMutexType(const uint8_t priority)
+{
+	{
+		// priority ceiling lower than priority of current thread - lock attempts must fail with EINVAL immediately
+		BasicMutex<type, Mutex::Protocol::PriorityProtect> mutex {static_cast<uint8_t>(priority - 1)};
+		waitForNextTick();
+		const auto start = TickClock::now();
+		const auto ret = mutex.lock();
+		const auto tryRet = mutex.tryLock();
+		if (ret != EINVAL || tryRet != EINVAL || start != TickClock::now())
+			return false;
+	}
+
+	return testBasicMutexAll<type, Mutex::Protocol::None>(priority, {}) == true &&
+			testBasicMutexAll<type, Mutex::Protocol::PriorityInheritance>(priority, {}) == true &&
+			testBasicMutexAll<type, Mutex::Protocol::PriorityProtect>(priority, priority) == true &&
+			testBasicMutexAll<type, Mutex::Protocol::PriorityProtect>(priority, UINT8_MAX) == true;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool BasicMutexOperationsTestCase::Implementation::run_() const
+{
+	static_assert(sizeof(BasicMutex<Mutex::Type::Normal, Mutex::Protocol::None>) < sizeof(Mutex),
+			"BasicMutex without priority protocol should be smaller than Mutex!");
+
+	return testBasicMutexType<Mutex::Type::Normal>(testCasePriority_) == true &&
+			testBasicMutexType<Mutex::Type::ErrorChecking>(testCasePriority_) == true &&
+			testBasicMutexType<Mutex::Type::Recursive>(testCasePriority_) == true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
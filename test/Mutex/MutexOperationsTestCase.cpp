@@ -2,13 +2,13 @@
  * \file
  * \brief MutexOperationsTestCase class implementation
  *
- * \author Copyright (C) 2014 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-11-19
+ * \date 2015-05-14
  */
 
 #include "MutexOperationsTestCase.hpp"
@@ -19,6 +19,7 @@
 #include "distortos/Mutex.hpp"
 #include "distortos/StaticThread.hpp"
 #include "distortos/ThisThread.hpp"
+#include "distortos/statistics.hpp"
 
 #include <cerrno>
 
@@ -367,6 +368,55 @@ bool phase3(const Mutex::Type type, const Mutex::Protocol protocol, const uint8_
 	return true;
 }
 
+/**
+ * \brief Phase 4 of test case.
+ *
+ * Tests competitive unlocking mode. Main (current) thread locks the mutex and test thread with the same priority blocks
+ * on it. Main thread unlocks the mutex and immediately locks it again - this must succeed without any context switch,
+ * as the ownership is not transferred to the unblocked test thread. Test thread is expected to acquire the mutex after
+ * main thread unlocks it for the second time.
+ *
+ * \param [in] type is the type of mutex
+ * \param [in] protocol is the mutex protocol
+ * \param [in] priorityCeiling is the priority ceiling of mutex, ignored when protocol != Protocol::PriorityProtect
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase4(const Mutex::Type type, const Mutex::Protocol protocol, const uint8_t priorityCeiling)
+{
+	constexpr size_t testThreadStackSize {256};
+
+	Mutex mutex {type, protocol, priorityCeiling, true};
+
+	if (mutex.lock() != 0)
+		return false;
+
+	int sharedRet {EINVAL};
+	auto thread = makeStaticThread<testThreadStackSize>(testThreadPriority, [&mutex, &sharedRet]()
+			{
+				sharedRet = mutex.lock();
+				if (sharedRet == 0)
+					sharedRet = mutex.unlock();
+			});
+
+	thread.start();
+	ThisThread::yield();
+
+	waitForNextTick();
+
+	// competitive unlock doesn't transfer ownership to blocked test thread, so the mutex can be locked again immediately
+	const auto contextSwitchCount = statistics::getContextSwitchCount();
+	const auto unlockRet = mutex.unlock();
+	const auto lockRet = mutex.lock();
+	const auto relocked = unlockRet == 0 && lockRet == 0 &&
+			statistics::getContextSwitchCount() == contextSwitchCount;
+
+	const auto ret = mutex.unlock();
+	thread.join();
+	return relocked == true && ret == 0 && sharedRet == 0;
+}
+
 }	// namespace
 
 /*---------------------------------------------------------------------------------------------------------------------+
@@ -405,6 +455,10 @@ bool MutexOperationsTestCase::Implementation::run_() const
 		const auto ret3 = phase3(std::get<0>(parameters), std::get<1>(parameters), std::get<2>(parameters));
 		if (ret3 != true)
 			return ret3;
+
+		const auto ret4 = phase4(std::get<0>(parameters), std::get<1>(parameters), std::get<2>(parameters));
+		if (ret4 != true)
+			return ret4;
 	}
 
 	return true;
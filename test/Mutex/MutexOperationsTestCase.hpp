@@ -2,13 +2,13 @@
  * \file
  * \brief MutexOperationsTestCase class header
  *
- * \author Copyright (C) 2014 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-11-19
+ * \date 2015-05-14
  */
 
 #ifndef TEST_MUTEX_MUTEXOPERATIONSTESTCASE_HPP_
@@ -25,8 +25,8 @@ namespace test
 /**
  * \brief Tests various mutex operations.
  *
- * Tests locking (lock(), tryLock(), tryLockFor() and tryLockUntil()) and unlocking of all valid combinations of mutex
- * types, protocols and priority ceilings.
+ * Tests locking (lock(), tryLock(), tryLockFor() and tryLockUntil()) and unlocking (with and without competitive
+ * mode) of all valid combinations of mutex types, protocols and priority ceilings.
  */
 
 class MutexOperationsTestCase : public PrioritizedTestCase
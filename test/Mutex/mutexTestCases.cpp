@@ -8,7 +8,7 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-11-19
+ * \date 2015-06-02
  */
 
 #include "mutexTestCases.hpp"
@@ -20,6 +20,7 @@
 #include "MutexPriorityProtectOperationsTestCase.hpp"
 #include "MutexPriorityInheritanceOperationsTestCase.hpp"
 #include "MutexPriorityProtocolTestCase.hpp"
+#include "BasicMutexOperationsTestCase.hpp"
 
 namespace distortos
 {
@@ -79,6 +80,12 @@ const MutexPriorityInheritanceOperationsTestCase priorityInheritanceOperationsTe
 /// MutexPriorityProtocolTestCase instance
 const MutexPriorityProtocolTestCase priorityProtocolTestCase;
 
+/// BasicMutexOperationsTestCase::Implementation instance
+const BasicMutexOperationsTestCase::Implementation basicMutexOperationsTestCaseImplementation;
+
+/// BasicMutexOperationsTestCase instance
+const BasicMutexOperationsTestCase basicMutexOperationsTestCase {basicMutexOperationsTestCaseImplementation};
+
 /// array with references to TestCase objects related to mutexes
 const TestCaseRange::value_type mutexTestCases_[]
 {
@@ -89,6 +96,7 @@ const TestCaseRange::value_type mutexTestCases_[]
 		TestCaseRange::value_type{priorityProtectOperationsTestCase},
 		TestCaseRange::value_type{priorityInheritanceOperationsTestCase},
 		TestCaseRange::value_type{priorityProtocolTestCase},
+		TestCaseRange::value_type{basicMutexOperationsTestCase},
 };
 
 }	// namespace
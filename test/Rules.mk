@@ -6,23 +6,32 @@
 # This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
 # distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #
-# date: 2015-02-18
+# date: 2015-06-04
 #
 
 #-----------------------------------------------------------------------------------------------------------------------
 # subdirectories
 #-----------------------------------------------------------------------------------------------------------------------
 
+SUBDIRECTORIES += Channel
 SUBDIRECTORIES += ConditionVariable
+SUBDIRECTORIES += DeferredRequestQueue
 SUBDIRECTORIES += FifoQueue
+SUBDIRECTORIES += HighResolutionClock
+SUBDIRECTORIES += Idle
 SUBDIRECTORIES += MessageQueue
 SUBDIRECTORIES += Mutex
 SUBDIRECTORIES += RawFifoQueue
 SUBDIRECTORIES += RawMessageQueue
+SUBDIRECTORIES += RwLock
+SUBDIRECTORIES += ScheduleTable
 SUBDIRECTORIES += Semaphore
 SUBDIRECTORIES += Signals
 SUBDIRECTORIES += SoftwareTimer
+SUBDIRECTORIES += Statistics
 SUBDIRECTORIES += Thread
+SUBDIRECTORIES += WaitOnAddress
+SUBDIRECTORIES += WaitSet
 
 #-----------------------------------------------------------------------------------------------------------------------
 # compilation flags
@@ -0,0 +1,349 @@
+/**
+ * \file
+ * \brief RwLockOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-13
+ */
+
+#include "RwLockOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/RwLock.hpp"
+#include "distortos/StaticThread.hpp"
+#include "distortos/ThisThread.hpp"
+#include "distortos/statistics.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// long duration used in tests
+constexpr auto longDuration = singleDuration * 10;
+
+/// size of stack for test thread, bytes
+constexpr size_t testThreadStackSize {384};
+
+/// expected number of context switches in waitForNextTick(): main -> idle -> main
+constexpr decltype(statistics::getContextSwitchCount()) waitForNextTickContextSwitchCount {2};
+
+/// expected number of context switches in phase1 block involving tryLockFor() or tryLockUntil() (excluding
+/// waitForNextTick()): 1 - main thread blocks waiting for readers (main -> idle), 2 - main thread wakes up
+/// (idle -> main)
+constexpr decltype(statistics::getContextSwitchCount()) phase1TryLockForUntilContextSwitchCount {2};
+
+/// expected number of context switches in phase3 block involving test thread (excluding waitForNextTick()): 1 - test
+/// thread starts (main -> test), 2 - test thread goes to sleep (test -> main), 3 - main thread blocks on RwLock
+/// (main -> idle), 4 - test thread wakes (idle -> test), 5 - test thread terminates (test -> main)
+constexpr decltype(statistics::getContextSwitchCount()) phase3ThreadContextSwitchCount {5};
+
+/// expected number of context switches in phase4 block (excluding waitForNextTick()): 1 - test thread starts
+/// (main -> test), 2 - test thread blocks waiting for readers (test -> main), 3 - test thread is unblocked by last
+/// reader (main -> test), 4 - test thread terminates (test -> main)
+constexpr decltype(statistics::getContextSwitchCount()) phase4ThreadContextSwitchCount {4};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Phase 1 of test case.
+ *
+ * Tests behavior of RwLock locked in shared mode - additional shared locks must be granted immediately, all attempts to
+ * lock it in exclusive mode must fail (immediately or with timeout).
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase1()
+{
+	RwLock rwLock;
+
+	if (rwLock.lockShared() != 0)
+		return false;
+
+	{
+		waitForNextTick();
+		const auto start = TickClock::now();
+		const auto tryLockSharedRet = rwLock.tryLockShared();
+		const auto tryLockRet = rwLock.tryLock();
+		if (tryLockSharedRet != 0 || tryLockRet != EBUSY || start != TickClock::now())
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+
+		// RwLock is locked in shared mode, so tryLockFor() should time-out at expected time
+		const auto start = TickClock::now();
+		const auto ret = rwLock.tryLockFor(singleDuration);
+		const auto realDuration = TickClock::now() - start;
+		if (ret != ETIMEDOUT || realDuration != singleDuration + decltype(singleDuration){1} ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase1TryLockForUntilContextSwitchCount)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+
+		// RwLock is locked in shared mode, so tryLockUntil() should time-out at exact expected time
+		const auto requestedTimePoint = TickClock::now() + singleDuration;
+		const auto ret = rwLock.tryLockUntil(requestedTimePoint);
+		if (ret != ETIMEDOUT || requestedTimePoint != TickClock::now() ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase1TryLockForUntilContextSwitchCount)
+			return false;
+	}
+
+	if (rwLock.unlockShared() != 0 || rwLock.unlockShared() != 0 || rwLock.unlockShared() != EPERM)
+		return false;
+
+	return true;
+}
+
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Tests behavior of RwLock locked in exclusive mode by current thread - all attempts to lock it must fail immediately
+ * with proper error codes.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	RwLock rwLock;
+
+	if (rwLock.tryLock() != 0)
+		return false;
+
+	{
+		waitForNextTick();
+		const auto start = TickClock::now();
+		const auto tryLockRet = rwLock.tryLock();
+		const auto lockRet = rwLock.lock();
+		const auto tryLockSharedRet = rwLock.tryLockShared();
+		const auto lockSharedRet = rwLock.lockShared();
+		const auto tryLockSharedForRet = rwLock.tryLockSharedFor(singleDuration);
+		if (tryLockRet != EBUSY || lockRet != EDEADLK || tryLockSharedRet != EBUSY || lockSharedRet != EDEADLK ||
+				tryLockSharedForRet != EDEADLK || start != TickClock::now())
+			return false;
+	}
+
+	if (rwLock.unlockShared() != EPERM || rwLock.unlock() != 0 || rwLock.unlock() != EPERM)
+		return false;
+
+	return true;
+}
+
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Tests thread-thread scenario. Test thread locks RwLock and unlocks it at specified time point, main thread is
+ * expected to lock this RwLock (in exclusive mode with lock(), tryLockFor() and tryLockUntil() after test thread's
+ * shared lock, in shared mode with tryLockSharedUntil() after test thread's exclusive lock) in the same moment.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	RwLock rwLock;
+
+	const auto sharedFunctor = [&rwLock](const TickClock::time_point timePoint)
+			{
+				rwLock.lockShared();
+				ThisThread::sleepUntil(timePoint);
+				rwLock.unlockShared();
+			};
+	const auto exclusiveFunctor = [&rwLock](const TickClock::time_point timePoint)
+			{
+				rwLock.lock();
+				ThisThread::sleepUntil(timePoint);
+				rwLock.unlock();
+			};
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeStaticThread<testThreadStackSize>(UINT8_MAX, sharedFunctor, wakeUpTimePoint);
+
+		thread.start();
+		ThisThread::yield();
+
+		// RwLock is currently locked in shared mode, but lock() should succeed at expected time
+		const auto ret = rwLock.lock();
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret != 0 || wakeUpTimePoint != wokenUpTimePoint || rwLock.unlock() != 0 ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase3ThreadContextSwitchCount)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeStaticThread<testThreadStackSize>(UINT8_MAX, sharedFunctor, wakeUpTimePoint);
+
+		thread.start();
+		ThisThread::yield();
+
+		// RwLock is currently locked in shared mode, but tryLockFor() should succeed at expected time
+		const auto ret = rwLock.tryLockFor(wakeUpTimePoint - TickClock::now() + longDuration);
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret != 0 || wakeUpTimePoint != wokenUpTimePoint || rwLock.unlock() != 0 ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase3ThreadContextSwitchCount)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeStaticThread<testThreadStackSize>(UINT8_MAX, sharedFunctor, wakeUpTimePoint);
+
+		thread.start();
+		ThisThread::yield();
+
+		// RwLock is currently locked in shared mode, but tryLockUntil() should succeed at expected time
+		const auto ret = rwLock.tryLockUntil(wakeUpTimePoint + longDuration);
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret != 0 || wakeUpTimePoint != wokenUpTimePoint || rwLock.unlock() != 0 ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase3ThreadContextSwitchCount)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeStaticThread<testThreadStackSize>(UINT8_MAX, exclusiveFunctor, wakeUpTimePoint);
+
+		thread.start();
+		ThisThread::yield();
+
+		// RwLock is currently locked in exclusive mode, but tryLockSharedUntil() should succeed at expected time
+		const auto ret = rwLock.tryLockSharedUntil(wakeUpTimePoint + longDuration);
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret != 0 || wakeUpTimePoint != wokenUpTimePoint || rwLock.unlockShared() != 0 ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase3ThreadContextSwitchCount)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 4 of test case.
+ *
+ * Tests preference of RwLock. Main thread locks RwLock in shared mode, test thread tries to lock it in exclusive mode
+ * and blocks waiting for the reader to leave. New shared lock must be refused with writers' preference and granted
+ * with readers' preference. Test thread must acquire the lock as soon as the last shared lock is released.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase4()
+{
+	for (const auto preference : {RwLock::Preference::Writers, RwLock::Preference::Readers})
+	{
+		RwLock rwLock {preference};
+
+		if (rwLock.lockShared() != 0)
+			return false;
+
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		auto thread = makeStaticThread<testThreadStackSize>(UINT8_MAX, [&rwLock]()
+				{
+					rwLock.lock();
+					rwLock.unlock();
+				});
+
+		thread.start();
+		ThisThread::yield();
+
+		const auto tryLockSharedRet = rwLock.tryLockShared();
+		const auto expectedRet = preference == RwLock::Preference::Writers ? EBUSY : 0;
+		if (tryLockSharedRet == 0)
+			rwLock.unlockShared();
+		rwLock.unlockShared();
+		thread.join();
+
+		if (tryLockSharedRet != expectedRet ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase4ThreadContextSwitchCount)
+			return false;
+	}
+
+	return true;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool RwLockOperationsTestCase::run_() const
+{
+	constexpr auto phase1ExpectedContextSwitchCount = 3 * waitForNextTickContextSwitchCount +
+			2 * phase1TryLockForUntilContextSwitchCount;
+	constexpr auto phase2ExpectedContextSwitchCount = 1 * waitForNextTickContextSwitchCount;
+	constexpr auto phase3ExpectedContextSwitchCount = 4 * waitForNextTickContextSwitchCount +
+			4 * phase3ThreadContextSwitchCount;
+	constexpr auto phase4ExpectedContextSwitchCount = 2 * waitForNextTickContextSwitchCount +
+			2 * phase4ThreadContextSwitchCount;
+	constexpr auto expectedContextSwitchCount = phase1ExpectedContextSwitchCount + phase2ExpectedContextSwitchCount +
+			phase3ExpectedContextSwitchCount + phase4ExpectedContextSwitchCount;
+
+	const auto contextSwitchCount = statistics::getContextSwitchCount();
+
+	for (const auto& function : {phase1, phase2, phase3, phase4})
+	{
+		const auto ret = function();
+		if (ret != true)
+			return ret;
+	}
+
+	if (statistics::getContextSwitchCount() - contextSwitchCount != expectedContextSwitchCount)
+		return false;
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
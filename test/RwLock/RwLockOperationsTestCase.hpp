@@ -0,0 +1,49 @@
+/**
+ * \file
+ * \brief RwLockOperationsTestCase class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-13
+ */
+
+#ifndef TEST_RWLOCK_RWLOCKOPERATIONSTESTCASE_HPP_
+#define TEST_RWLOCK_RWLOCKOPERATIONSTESTCASE_HPP_
+
+#include "TestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests various RwLock operations.
+ *
+ * Tests locking in shared and exclusive mode (lock*(), tryLock*()), unlocking, error detection and selected preference
+ * of RwLock.
+ */
+
+class RwLockOperationsTestCase : public TestCase
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	virtual bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_RWLOCK_RWLOCKOPERATIONSTESTCASE_HPP_
@@ -0,0 +1,193 @@
+/**
+ * \file
+ * \brief ScheduleTableOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#include "ScheduleTableOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/ScheduleTable.hpp"
+#include "distortos/Semaphore.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// duration of major frame used in tests
+constexpr auto majorFrame = singleDuration * 5;
+
+/// offset of entry which releases main thread
+constexpr auto releaseOffset = singleDuration * 3;
+
+/// number of major frames tested
+constexpr size_t frames {3};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// time points at which testFunction() was executed
+TickClock::time_point functionTimePoints[frames];
+
+/// number of executions of testFunction()
+volatile size_t functionCount;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Function executed by schedule table - saves current time point in \a functionTimePoints
+ */
+
+void testFunction()
+{
+	if (functionCount < frames)
+		functionTimePoints[functionCount] = TickClock::now();
+	++functionCount;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants which depend on local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// constexpr array with entries, validated at compile time
+constexpr ScheduleTable::Entry constexprEntries[]
+{
+		{TickClock::duration{}, testFunction},
+		{releaseOffset, testFunction},
+};
+
+static_assert(ScheduleTable::isValid(constexprEntries, majorFrame) == true, "Valid table must pass the check!");
+static_assert(ScheduleTable::isValid(constexprEntries, releaseOffset) == false,
+		"Table with entry outside of major frame must fail the check!");
+static_assert(ScheduleTable::isValid(constexprEntries, TickClock::duration{}) == false,
+		"Table with empty major frame must fail the check!");
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool ScheduleTableOperationsTestCase::run_() const
+{
+	{
+		// empty major frame and unsorted entries must be rejected
+		const ScheduleTable::Entry entries[] {{singleDuration, testFunction}, {TickClock::duration{}, testFunction}};
+		ScheduleTable emptyFrameTable {entries, TickClock::duration{}};
+		ScheduleTable unsortedTable {entries, majorFrame};
+		if (emptyFrameTable.start() != EINVAL || unsortedTable.start() != EINVAL || unsortedTable.isActive() != false)
+			return false;
+	}
+
+	{
+		// entry outside of major frame must be rejected
+		const ScheduleTable::Entry entries[] {{majorFrame, testFunction}};
+		ScheduleTable scheduleTable {entries, majorFrame};
+		if (scheduleTable.start() != EINVAL)
+			return false;
+	}
+
+	Semaphore semaphore {0};
+	const ScheduleTable::Entry entries[] {{TickClock::duration{}, testFunction}, {releaseOffset, semaphore}};
+	ScheduleTable scheduleTable {entries, majorFrame};
+	ScheduleTable otherScheduleTable {entries, majorFrame};
+
+	functionCount = 0;
+	waitForNextTick();
+	const auto frameTimePoint = TickClock::now() + singleDuration;
+
+	{
+		const auto ret = scheduleTable.start(frameTimePoint);
+		if (ret != 0 || scheduleTable.isActive() != true)
+			return false;
+	}
+
+	{
+		// only one table may be active
+		const auto ret = otherScheduleTable.start();
+		if (ret != EBUSY || otherScheduleTable.isActive() != false)
+			return false;
+	}
+
+	for (size_t frame = 0; frame < frames; ++frame)
+	{
+		// thread is released at exact time point in each major frame
+		const auto ret = semaphore.wait();
+		if (ret != 0 || TickClock::now() != frameTimePoint + majorFrame * frame + releaseOffset)
+			return false;
+	}
+
+	{
+		const auto ret1 = scheduleTable.stop();
+		const auto ret2 = scheduleTable.stop();
+		if (ret1 != 0 || ret2 != EINVAL || scheduleTable.isActive() != false)
+			return false;
+	}
+
+	if (functionCount != frames)
+		return false;
+
+	for (size_t frame = 0; frame < frames; ++frame)
+		if (functionTimePoints[frame] != frameTimePoint + majorFrame * frame)
+			return false;
+
+	{
+		// no entries are executed after the table is stopped
+		const auto ret = semaphore.tryWaitFor(majorFrame * 2);
+		if (ret != ETIMEDOUT || functionCount != frames)
+			return false;
+	}
+
+	// table started in the past - missed entries are skipped and counted in the first tick, table keeps its phase
+	functionCount = 0;
+	waitForNextTick();
+	const auto currentFrameTimePoint = TickClock::now();
+
+	{
+		const auto ret = scheduleTable.start(currentFrameTimePoint - majorFrame * 2);
+		if (ret != 0)
+			return false;
+	}
+
+	{
+		// 2 missed major frames with 2 entries and entry with offset 0 in current major frame
+		constexpr uint32_t expectedOverrunCount {2 * 2 + 1};
+		const auto ret = semaphore.wait();
+		const auto wakeUpTimePoint = TickClock::now();
+		const auto ret2 = scheduleTable.stop();
+		if (ret != 0 || ret2 != 0 || wakeUpTimePoint != currentFrameTimePoint + releaseOffset ||
+				scheduleTable.getOverrunCount() != expectedOverrunCount || functionCount != 0)
+			return false;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
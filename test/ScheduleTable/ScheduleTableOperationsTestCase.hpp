@@ -0,0 +1,49 @@
+/**
+ * \file
+ * \brief ScheduleTableOperationsTestCase class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-25
+ */
+
+#ifndef TEST_SCHEDULETABLE_SCHEDULETABLEOPERATIONSTESTCASE_HPP_
+#define TEST_SCHEDULETABLE_SCHEDULETABLEOPERATIONSTESTCASE_HPP_
+
+#include "TestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests ScheduleTable operations.
+ *
+ * Tests whether entries of schedule table (functions and releases of threads with semaphores) are executed at exact
+ * time points in consecutive major frames and whether invalid tables and concurrent activation are rejected.
+ */
+
+class ScheduleTableOperationsTestCase : public TestCase
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	virtual bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_SCHEDULETABLE_SCHEDULETABLEOPERATIONSTESTCASE_HPP_
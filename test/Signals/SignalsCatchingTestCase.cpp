@@ -8,15 +8,19 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-05-05
+ * \date 2015-05-30
  */
 
 #include "SignalsCatchingTestCase.hpp"
 
 #include "SequenceAsserter.hpp"
+#include "waitForNextTick.hpp"
 
 #include "distortos/SignalAction.hpp"
+#include "distortos/SoftwareTimer.hpp"
 #include "distortos/statistics.hpp"
+#include "distortos/ThisThread.hpp"
+#include "distortos/ThreadBase.hpp"
 #include "distortos/ThisThread-Signals.hpp"
 
 #include "distortos/estd/ContiguousRange.hpp"
@@ -163,6 +167,17 @@ private:
 /// total number of signals that are tested
 constexpr size_t totalSignals {10};
 
+/// expected number of context switches in waitForNextTick(): main -> idle -> main
+constexpr decltype(statistics::getContextSwitchCount()) waitForNextTickContextSwitchCount {2};
+
+/// expected number of context switches in phase2 (excluding waitForNextTick()): 1 - request from interrupt is handled
+/// by PendSV (main -> main)
+constexpr decltype(statistics::getContextSwitchCount()) phase2ContextSwitchCount {1};
+
+/// expected number of context switches in phase3 (excluding waitForNextTick()): 1 - main thread goes to sleep
+/// (main -> idle), 2 - main thread wakes up (idle -> main)
+constexpr decltype(statistics::getContextSwitchCount()) phase3ContextSwitchCount {2};
+
 /// range of test steps for signal handler
 estd::ContiguousRange<const HandlerStep> handlerStepsRange;
 
@@ -251,6 +266,23 @@ void handler(const SignalInformation& signalInformation)
 		sharedSigAtomic = EINVAL;	// execution of signal handler was not expected
 }
 
+/**
+ * \brief Generates signal from interrupt context (software timer).
+ *
+ * \param [in] thread is a reference to thread for which the signal will be generated
+ * \param [in] signalNumber is the signal number that will be generated
+ * \param [in] sequencePoint is the sequence point of this step
+ */
+
+void interruptStep(ThreadBase& thread, const uint8_t signalNumber, const unsigned int sequencePoint)
+{
+	sharedSequenceAsserter.sequencePoint(sequencePoint);
+
+	const auto ret = thread.generateSignal(signalNumber);
+	if (ret != 0)
+		sharedSigAtomic = ret;
+}
+
 /**
  * \brief Phase 1 of test case.
  *
@@ -324,6 +356,72 @@ bool phase1()
 	return testResult;
 }
 
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Tests catching of signal generated for current thread from interrupt context - signal handler must be executed
+ * right after return from interrupt.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	constexpr uint8_t signalNumber {3};
+
+	static const HandlerStep handlerSteps[]
+	{
+			{1, SignalSet{SignalSet::empty}, getSignalMask(signalNumber), SignalInformation::Code::Generated,
+					signalNumber},
+	};
+
+	handlerStepsRange = decltype(handlerStepsRange){handlerSteps};
+
+	auto softwareTimer = makeSoftwareTimer(interruptStep, std::ref(ThisThread::get()), signalNumber, 0u);
+
+	waitForNextTick();
+	softwareTimer.start(TickClock::duration{1});
+
+	while (softwareTimer.isRunning() == true);	// current thread is interrupted by software timer
+
+	sharedSequenceAsserter.sequencePoint(2);
+
+	return sharedSequenceAsserter.assertSequence(3);
+}
+
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Tests catching of signal generated for non-current (sleeping) thread from interrupt context - signal handler must be
+ * executed as soon as the thread is scheduled again.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	constexpr uint8_t signalNumber {7};
+
+	static const HandlerStep handlerSteps[]
+	{
+			{1, SignalSet{SignalSet::empty}, getSignalMask(signalNumber), SignalInformation::Code::Generated,
+					signalNumber},
+	};
+
+	handlerStepsRange = decltype(handlerStepsRange){handlerSteps};
+
+	auto softwareTimer = makeSoftwareTimer(interruptStep, std::ref(ThisThread::get()), signalNumber, 0u);
+
+	waitForNextTick();
+	softwareTimer.start(TickClock::duration{1});
+
+	ThisThread::sleepFor(TickClock::duration{2});
+
+	sharedSequenceAsserter.sequencePoint(2);
+
+	return sharedSequenceAsserter.assertSequence(3);
+}
+
 }	// namespace
 
 /*---------------------------------------------------------------------------------------------------------------------+
@@ -345,7 +443,7 @@ bool SignalsCatchingTestCase::run_() const
 			return false;
 	}
 
-	for (const auto& function : {phase1})
+	for (const auto& function : {phase1, phase2, phase3})
 	{
 		// initially no signals may be pending
 		if (ThisThread::Signals::getPendingSignalSet().getBitset().any() == true)
@@ -365,7 +463,9 @@ bool SignalsCatchingTestCase::run_() const
 	if (ThisThread::Signals::getPendingSignalSet().getBitset().any() == true)
 		return false;
 
-	if (statistics::getContextSwitchCount() - contextSwitchCount != 0)
+	constexpr auto totalContextSwitchCount = 2 * waitForNextTickContextSwitchCount + phase2ContextSwitchCount +
+			phase3ContextSwitchCount;
+	if (statistics::getContextSwitchCount() - contextSwitchCount != totalContextSwitchCount)
 		return false;
 
 	return true;
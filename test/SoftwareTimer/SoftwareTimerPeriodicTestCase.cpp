@@ -0,0 +1,186 @@
+/**
+ * \file
+ * \brief SoftwareTimerPeriodicTestCase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#include "SoftwareTimerPeriodicTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/SoftwareTimer.hpp"
+
+#include <array>
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// period of software timer used in tests
+constexpr auto period = singleDuration * 3;
+
+/// number of executions of software timer checked in each phase
+constexpr size_t executions {4};
+
+/// number of periods which are "missed" in the overrun phase
+constexpr uint32_t missedPeriods {5};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// array with time points of executions of software timer
+using TimePoints = std::array<TickClock::time_point, executions>;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Checks whether software timer was executed exactly at expected time points.
+ *
+ * \param [in] timePoints is a reference to array with time points of executions
+ * \param [in] firstTimePoint is the expected time point of first execution
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool checkTimePoints(const TimePoints& timePoints, const TickClock::time_point firstTimePoint)
+{
+	for (size_t i {}; i < timePoints.size(); ++i)
+		if (timePoints[i] != firstTimePoint + period * i)
+			return false;
+
+	return true;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool SoftwareTimerPeriodicTestCase::run_() const
+{
+	TimePoints timePoints {};
+	volatile size_t count {};
+	auto softwareTimer = makeSoftwareTimer(
+			[&timePoints, &count]()
+			{
+				if (count < timePoints.size())
+					timePoints[count] = TickClock::now();
+				++count;
+			});
+
+	{
+		waitForNextTick();
+		count = 0;
+		const auto firstTimePoint = TickClock::now() + period;
+		softwareTimer.start(firstTimePoint, period);
+		// must be started, but may not execute yet
+		if (softwareTimer.isRunning() != true || softwareTimer.getPeriod() != period || count != 0)
+			return false;
+
+		while (count < executions)
+		{
+
+		}
+
+		softwareTimer.stop();
+
+		// each next expiration time point must be based on the previous one, there must be no overruns
+		if (softwareTimer.isRunning() != false || checkTimePoints(timePoints, firstTimePoint) != true ||
+				softwareTimer.getOverrunCount() != 0)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+		count = 0;
+		const auto start = TickClock::now();
+		softwareTimer.start(singleDuration, period);
+
+		while (count < executions)
+		{
+
+		}
+
+		softwareTimer.stop();
+
+		// first execution after requested duration (with one additional tick), then periodic
+		if (softwareTimer.isRunning() != false ||
+				checkTimePoints(timePoints, start + singleDuration + decltype(singleDuration){1}) != true ||
+				softwareTimer.getOverrunCount() != 0)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+		count = 0;
+		const auto now = TickClock::now();
+		// first expiration time point is in the past, so the timer is already late - it will be executed in next tick
+		// and all missed periods will be skipped, keeping the phase of the timer
+		softwareTimer.start(now - period * missedPeriods, period);
+
+		while (count < 2)
+		{
+
+		}
+
+		softwareTimer.stop();
+
+		if (timePoints[0] != now + singleDuration || timePoints[1] != now + period ||
+				softwareTimer.getOverrunCount() != missedPeriods)
+			return false;
+	}
+
+	{
+		// periodic mode requires positive period - such timer would expire again in the same tick forever
+		if (softwareTimer.start(singleDuration, TickClock::duration{}) != EINVAL ||
+				softwareTimer.start(TickClock::now() + period, -period) != EINVAL || softwareTimer.isRunning() != false)
+			return false;
+	}
+
+	{
+		// one-shot mode must still work after periodic mode
+		waitForNextTick();
+		count = 0;
+		const auto wakeUpTimePoint = TickClock::now() + period;
+		softwareTimer.start(wakeUpTimePoint);
+
+		while (softwareTimer.isRunning() == true)
+		{
+
+		}
+
+		if (count != 1 || timePoints[0] != wakeUpTimePoint || softwareTimer.getPeriod() != TickClock::duration{})
+			return false;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
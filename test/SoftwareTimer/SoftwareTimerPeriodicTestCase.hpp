@@ -0,0 +1,47 @@
+/**
+ * \file
+ * \brief SoftwareTimerPeriodicTestCase class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-04
+ */
+
+#ifndef TEST_SOFTWARETIMER_SOFTWARETIMERPERIODICTESTCASE_HPP_
+#define TEST_SOFTWARETIMER_SOFTWARETIMERPERIODICTESTCASE_HPP_
+
+#include "TestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests periodic mode of software timers - exact cadence without drift, counting of overruns and rejection of
+ * non-positive periods.
+ */
+
+class SoftwareTimerPeriodicTestCase : public TestCase
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	virtual bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_SOFTWARETIMER_SOFTWARETIMERPERIODICTESTCASE_HPP_
@@ -2,13 +2,13 @@
  * \file
  * \brief softwareTimerTestCases object definition
  *
- * \author Copyright (C) 2014 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-11-20
+ * \date 2015-05-18
  */
 
 #include "softwareTimerTestCases.hpp"
@@ -16,6 +16,7 @@
 #include "SoftwareTimerOrderingTestCase.hpp"
 #include "SoftwareTimerOperationsTestCase.hpp"
 #include "SoftwareTimerFunctionTypesTestCase.hpp"
+#include "SoftwareTimerPeriodicTestCase.hpp"
 
 namespace distortos
 {
@@ -39,12 +40,16 @@ const SoftwareTimerOperationsTestCase operationsTestCase;
 /// SoftwareTimerFunctionTypesTestCase instance
 const SoftwareTimerFunctionTypesTestCase functionTypesTestCase;
 
+/// SoftwareTimerPeriodicTestCase instance
+const SoftwareTimerPeriodicTestCase periodicTestCase;
+
 /// array with references to TestCase objects related to software timers
 const TestCaseRange::value_type softwareTimerTestCases_[]
 {
 		TestCaseRange::value_type{orderingTestCase},
 		TestCaseRange::value_type{operationsTestCase},
 		TestCaseRange::value_type{functionTypesTestCase},
+		TestCaseRange::value_type{periodicTestCase},
 };
 
 }	// namespace
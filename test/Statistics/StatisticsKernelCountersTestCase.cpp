@@ -0,0 +1,106 @@
+/**
+ * \file
+ * \brief StatisticsKernelCountersTestCase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-24
+ */
+
+#include "StatisticsKernelCountersTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/Semaphore.hpp"
+#include "distortos/SoftwareTimer.hpp"
+#include "distortos/statistics.hpp"
+#include "distortos/ThisThread.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool StatisticsKernelCountersTestCase::run_() const
+{
+	{
+		waitForNextTick();
+
+		const auto before = statistics::getKernelCounters();
+		ThisThread::sleepFor(singleDuration);
+		const auto after = statistics::getKernelCounters();
+		if (after.blocks.sleep - before.blocks.sleep != 1 || after.unblocks.sleep - before.unblocks.sleep != 1 ||
+				after.timeouts - before.timeouts != 1)
+			return false;
+	}
+
+	{
+		Semaphore semaphore {0, 1};
+
+		const auto before = statistics::getKernelCounters();
+		const auto ret1 = semaphore.post();
+		const auto ret2 = semaphore.post();
+		const auto after = statistics::getKernelCounters();
+		if (ret1 != 0 || ret2 != EOVERFLOW || after.semaphorePosts - before.semaphorePosts != 1 ||
+				after.semaphoreOverflows - before.semaphoreOverflows != 1)
+			return false;
+	}
+
+	{
+		Semaphore semaphore {0};
+
+		waitForNextTick();
+
+		const auto before = statistics::getKernelCounters();
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto ret = semaphore.tryWaitFor(singleDuration);
+		const auto after = statistics::getKernelCounters();
+		if (ret != ETIMEDOUT || after.blocks.semaphore - before.blocks.semaphore != 1 ||
+				after.unblocks.semaphore - before.unblocks.semaphore != 1 || after.timeouts - before.timeouts != 1 ||
+				after.contextSwitchRequests - before.contextSwitchRequests <
+				statistics::getContextSwitchCount() - contextSwitchCount)
+			return false;
+	}
+
+	{
+		auto softwareTimer = makeSoftwareTimer([](){});
+
+		waitForNextTick();
+
+		const auto before = statistics::getKernelCounters();
+		softwareTimer.start(singleDuration);
+		while (softwareTimer.isRunning() == true);
+		const auto after = statistics::getKernelCounters();
+		if (after.softwareTimerExpirations - before.softwareTimerExpirations != 1)
+			return false;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
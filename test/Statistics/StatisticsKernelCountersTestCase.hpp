@@ -0,0 +1,49 @@
+/**
+ * \file
+ * \brief StatisticsKernelCountersTestCase class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-24
+ */
+
+#ifndef TEST_STATISTICS_STATISTICSKERNELCOUNTERSTESTCASE_HPP_
+#define TEST_STATISTICS_STATISTICSKERNELCOUNTERSTESTCASE_HPP_
+
+#include "TestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests kernel event counters.
+ *
+ * Performs simple operations (sleep, semaphore post with and without overflow, timed-out wait, software timer
+ * expiration) and checks whether the snapshots returned by statistics::getKernelCounters() change as expected.
+ */
+
+class StatisticsKernelCountersTestCase : public TestCase
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	virtual bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_STATISTICS_STATISTICSKERNELCOUNTERSTESTCASE_HPP_
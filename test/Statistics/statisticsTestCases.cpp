@@ -0,0 +1,50 @@
+/**
+ * \file
+ * \brief statisticsTestCases object definition
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-24
+ */
+
+#include "statisticsTestCases.hpp"
+
+#include "StatisticsKernelCountersTestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// StatisticsKernelCountersTestCase instance
+const StatisticsKernelCountersTestCase kernelCountersTestCase;
+
+/// array with references to TestCase objects related to statistics
+const TestCaseRange::value_type statisticsTestCases_[]
+{
+		TestCaseRange::value_type{kernelCountersTestCase},
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+const TestCaseRange statisticsTestCases {statisticsTestCases_};
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,291 @@
+/**
+ * \file
+ * \brief ThreadNotificationOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-15
+ */
+
+#include "ThreadNotificationOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/SoftwareTimer.hpp"
+#include "distortos/ThisThread.hpp"
+#include "distortos/ThreadBase.hpp"
+#include "distortos/statistics.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// long duration used in tests
+constexpr auto longDuration = singleDuration * 10;
+
+/// expected number of context switches in waitForNextTick(): main -> idle -> main
+constexpr decltype(statistics::getContextSwitchCount()) waitForNextTickContextSwitchCount {2};
+
+/// expected number of context switches in phase2 and phase3 blocks (excluding waitForNextTick()): 1 - main thread
+/// waits for notification (main -> idle), 2 - main thread wakes up (idle -> main)
+constexpr decltype(statistics::getContextSwitchCount()) waitContextSwitchCount {2};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Tests ThisThread::tryWaitNotification() when no notification is pending - it must fail immediately and
+ * return EAGAIN
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testTryWaitNotificationWhenNotPending()
+{
+	waitForNextTick();
+	const auto start = TickClock::now();
+	const auto tryWaitNotificationResult = ThisThread::tryWaitNotification();
+	return tryWaitNotificationResult.first == EAGAIN && start == TickClock::now();
+}
+
+/**
+ * \brief Phase 1 of test case.
+ *
+ * Tests all notification actions in non-blocking mode - notifications are sent by current thread to itself and
+ * accepted with ThisThread::tryWaitNotification().
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase1()
+{
+	auto& thread = ThisThread::get();
+
+	{
+		const auto ret = testTryWaitNotificationWhenNotPending();
+		if (ret != true)
+			return ret;
+	}
+
+	{
+		const auto ret1 = thread.notify(ThreadBase::NotificationAction::SetBits, 0x5);
+		const auto ret2 = thread.notify(ThreadBase::NotificationAction::SetBits, 0xa);
+		const auto tryWaitNotificationResult = ThisThread::tryWaitNotification();
+		if (ret1 != 0 || ret2 != 0 || tryWaitNotificationResult.first != 0 || tryWaitNotificationResult.second != 0xf)
+			return false;
+	}
+
+	{
+		const auto ret1 = thread.notify(ThreadBase::NotificationAction::Increment);
+		const auto ret2 = thread.notify(ThreadBase::NotificationAction::Increment);
+		const auto tryWaitNotificationResult = ThisThread::tryWaitNotification();
+		if (ret1 != 0 || ret2 != 0 || tryWaitNotificationResult.first != 0 || tryWaitNotificationResult.second != 2)
+			return false;
+	}
+
+	{
+		const auto ret1 = thread.notify(ThreadBase::NotificationAction::SetBits, 0x5);
+		const auto ret2 = thread.notify(ThreadBase::NotificationAction::Overwrite, 0x1234);
+		const auto tryWaitNotificationResult = ThisThread::tryWaitNotification();
+		if (ret1 != 0 || ret2 != 0 || tryWaitNotificationResult.first != 0 ||
+				tryWaitNotificationResult.second != 0x1234)
+			return false;
+	}
+
+	{
+		// notification with value 0 must also be accepted
+		const auto ret = thread.notify(ThreadBase::NotificationAction::Overwrite, 0);
+		const auto tryWaitNotificationResult = ThisThread::tryWaitNotification();
+		if (ret != 0 || tryWaitNotificationResult.first != 0 || tryWaitNotificationResult.second != 0)
+			return false;
+	}
+
+	{
+		const auto ret = thread.notify(static_cast<ThreadBase::NotificationAction>(UINT8_MAX), 0x5);
+		if (ret != EINVAL)
+			return false;
+	}
+
+	{
+		const auto ret = testTryWaitNotificationWhenNotPending();
+		if (ret != true)
+			return ret;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Tests whether ThisThread::tryWaitNotificationFor() and ThisThread::tryWaitNotificationUntil() properly time-out when
+ * no notification is sent.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+
+		// no notification is pending, so tryWaitNotificationFor() should time-out at expected time
+		const auto start = TickClock::now();
+		const auto tryWaitNotificationResult = ThisThread::tryWaitNotificationFor(singleDuration);
+		const auto realDuration = TickClock::now() - start;
+		if (tryWaitNotificationResult.first != ETIMEDOUT ||
+				realDuration != singleDuration + decltype(singleDuration){1} ||
+				statistics::getContextSwitchCount() - contextSwitchCount != waitContextSwitchCount)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+
+		// no notification is pending, so tryWaitNotificationUntil() should time-out at exact expected time
+		const auto requestedTimePoint = TickClock::now() + singleDuration;
+		const auto tryWaitNotificationResult = ThisThread::tryWaitNotificationUntil(requestedTimePoint);
+		if (tryWaitNotificationResult.first != ETIMEDOUT || requestedTimePoint != TickClock::now() ||
+				statistics::getContextSwitchCount() - contextSwitchCount != waitContextSwitchCount)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Tests interrupt-thread signaling scenario. Main (current) thread waits for notification. Software timer is used to
+ * send the notification at specified time point from interrupt context, main thread is expected to accept it (with
+ * waitNotification(), tryWaitNotificationFor() and tryWaitNotificationUntil()) in the same moment.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	auto& thread = ThisThread::get();
+	auto softwareTimer = makeSoftwareTimer([&thread]()
+			{
+				thread.notify(ThreadBase::NotificationAction::Increment);
+			});
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+
+		softwareTimer.start(wakeUpTimePoint);
+
+		// no notification is pending, but waitNotification() should succeed at expected time
+		const auto waitNotificationResult = ThisThread::waitNotification();
+		const auto wokenUpTimePoint = TickClock::now();
+		if (waitNotificationResult.first != 0 || waitNotificationResult.second != 1 ||
+				wakeUpTimePoint != wokenUpTimePoint ||
+				statistics::getContextSwitchCount() - contextSwitchCount != waitContextSwitchCount)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+
+		softwareTimer.start(wakeUpTimePoint);
+
+		// no notification is pending, but tryWaitNotificationFor() should succeed at expected time
+		const auto tryWaitNotificationResult =
+				ThisThread::tryWaitNotificationFor(wakeUpTimePoint - TickClock::now() + longDuration);
+		const auto wokenUpTimePoint = TickClock::now();
+		if (tryWaitNotificationResult.first != 0 || tryWaitNotificationResult.second != 1 ||
+				wakeUpTimePoint != wokenUpTimePoint ||
+				statistics::getContextSwitchCount() - contextSwitchCount != waitContextSwitchCount)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+
+		softwareTimer.start(wakeUpTimePoint);
+
+		// no notification is pending, but tryWaitNotificationUntil() should succeed at expected time
+		const auto tryWaitNotificationResult = ThisThread::tryWaitNotificationUntil(wakeUpTimePoint + longDuration);
+		const auto wokenUpTimePoint = TickClock::now();
+		if (tryWaitNotificationResult.first != 0 || tryWaitNotificationResult.second != 1 ||
+				wakeUpTimePoint != wokenUpTimePoint ||
+				statistics::getContextSwitchCount() - contextSwitchCount != waitContextSwitchCount)
+			return false;
+	}
+
+	{
+		const auto ret = testTryWaitNotificationWhenNotPending();
+		if (ret != true)
+			return ret;
+	}
+
+	return true;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool ThreadNotificationOperationsTestCase::run_() const
+{
+	constexpr auto phase1ExpectedContextSwitchCount = 2 * waitForNextTickContextSwitchCount;
+	constexpr auto phase2ExpectedContextSwitchCount = 2 * waitForNextTickContextSwitchCount +
+			2 * waitContextSwitchCount;
+	constexpr auto phase3ExpectedContextSwitchCount = 4 * waitForNextTickContextSwitchCount +
+			3 * waitContextSwitchCount;
+	constexpr auto expectedContextSwitchCount = phase1ExpectedContextSwitchCount + phase2ExpectedContextSwitchCount +
+			phase3ExpectedContextSwitchCount;
+
+	const auto contextSwitchCount = statistics::getContextSwitchCount();
+
+	for (const auto& function : {phase1, phase2, phase3})
+	{
+		const auto ret = function();
+		if (ret != true)
+			return ret;
+	}
+
+	if (statistics::getContextSwitchCount() - contextSwitchCount != expectedContextSwitchCount)
+		return false;
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
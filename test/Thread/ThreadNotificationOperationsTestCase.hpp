@@ -0,0 +1,50 @@
+/**
+ * \file
+ * \brief ThreadNotificationOperationsTestCase class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-15
+ */
+
+#ifndef TEST_THREAD_THREADNOTIFICATIONOPERATIONSTESTCASE_HPP_
+#define TEST_THREAD_THREADNOTIFICATIONOPERATIONSTESTCASE_HPP_
+
+#include "TestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests various operations on thread notifications.
+ *
+ * Tests sending (ThreadBase::notify()) with all actions and waiting (ThisThread::waitNotification(),
+ * ThisThread::tryWaitNotification(), ThisThread::tryWaitNotificationFor() and ThisThread::tryWaitNotificationUntil())
+ * for thread notifications.
+ */
+
+class ThreadNotificationOperationsTestCase : public TestCase
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	virtual bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_THREAD_THREADNOTIFICATIONOPERATIONSTESTCASE_HPP_
@@ -0,0 +1,165 @@
+/**
+ * \file
+ * \brief ThreadPeriodicOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-22
+ */
+
+#include "ThreadPeriodicOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+#include "wasteTime.hpp"
+
+#include "distortos/PeriodicActivation.hpp"
+#include "distortos/ThisThread.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// period used in tests
+constexpr auto period = singleDuration * 3;
+
+/// relative deadline used in tests
+constexpr auto deadline = singleDuration * 2;
+
+/// number of activations in which the thread meets its deadline
+constexpr auto activations = 5;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// number of executions of testOverrunHook()
+uint32_t overrunHookCount;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Overrun hook used in test - increments \a overrunHookCount
+ */
+
+void testOverrunHook(PeriodicActivation&)
+{
+	++overrunHookCount;
+}
+
+/**
+ * \brief Checks counters of PeriodicActivation object.
+ *
+ * \param [in] periodicActivation is a reference to checked PeriodicActivation object
+ * \param [in] activationCount is the expected number of activations
+ * \param [in] missedDeadlineCount is the expected number of missed deadlines
+ * \param [in] overrunCount is the expected number of overruns
+ *
+ * \return true if all counters have expected values, false otherwise
+ */
+
+bool checkCounters(const PeriodicActivation& periodicActivation, const uint64_t activationCount,
+		const uint64_t missedDeadlineCount, const uint64_t overrunCount)
+{
+	return periodicActivation.getActivationCount() == activationCount &&
+			periodicActivation.getMissedDeadlineCount() == missedDeadlineCount &&
+			periodicActivation.getOverrunCount() == overrunCount;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool ThreadPeriodicOperationsTestCase::run_() const
+{
+	// current thread is not periodic
+	if (ThisThread::waitForNextPeriod() != EINVAL || ThisThread::stopPeriodic() != EINVAL)
+		return false;
+
+	overrunHookCount = 0;
+	PeriodicActivation periodicActivation {period, deadline, testOverrunHook};
+
+	waitForNextTick();
+
+	const auto firstRelease = TickClock::now() + period;
+	if (ThisThread::startPeriodic(periodicActivation, firstRelease) != 0)
+		return false;
+
+	{
+		PeriodicActivation otherPeriodicActivation {period};
+		if (ThisThread::startPeriodic(otherPeriodicActivation) != EBUSY)
+			return false;
+	}
+
+	if (periodicActivation.getReleaseTimePoint() != firstRelease || checkCounters(periodicActivation, 0, 0, 0) != true)
+		return false;
+
+	// releases must occur at exact time points
+	for (int i = 0; i < activations; ++i)
+	{
+		const auto ret = ThisThread::waitForNextPeriod();
+		const auto expectedRelease = firstRelease + period * i;
+		if (ret != 0 || TickClock::now() != expectedRelease ||
+				periodicActivation.getReleaseTimePoint() != expectedRelease ||
+				checkCounters(periodicActivation, i + 1, 0, 0) != true)
+			return false;
+	}
+
+	// activation which misses its deadline, but ends before next release
+	{
+		const auto release = periodicActivation.getReleaseTimePoint();
+		wasteTime(release + deadline);
+		const auto ret = ThisThread::waitForNextPeriod();
+		if (ret != 0 || TickClock::now() != release + period || overrunHookCount != 0 ||
+				checkCounters(periodicActivation, activations + 1, 1, 0) != true)
+			return false;
+	}
+
+	// activation which overruns two next releases - they are skipped
+	{
+		const auto release = periodicActivation.getReleaseTimePoint();
+		wasteTime(release + period * 2 + singleDuration);
+		const auto ret = ThisThread::waitForNextPeriod();
+		if (ret != 0 || TickClock::now() != release + period * 3 || overrunHookCount != 1 ||
+				checkCounters(periodicActivation, activations + 2, 2, 2) != true)
+			return false;
+	}
+
+	if (ThisThread::stopPeriodic() != 0 || ThisThread::waitForNextPeriod() != EINVAL)
+		return false;
+
+	// thread was woken up within the tick of release, statistics must be consistent
+	const auto minimumReleaseLatency = periodicActivation.getMinimumReleaseLatency();
+	const auto averageReleaseLatency = periodicActivation.getAverageReleaseLatency();
+	const auto maximumReleaseLatency = periodicActivation.getMaximumReleaseLatency();
+	if (minimumReleaseLatency > averageReleaseLatency || averageReleaseLatency > maximumReleaseLatency ||
+			maximumReleaseLatency >= singleDuration)
+		return false;
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,50 @@
+/**
+ * \file
+ * \brief ThreadPeriodicOperationsTestCase class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-22
+ */
+
+#ifndef TEST_THREAD_THREADPERIODICOPERATIONSTESTCASE_HPP_
+#define TEST_THREAD_THREADPERIODICOPERATIONSTESTCASE_HPP_
+
+#include "TestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests periodic threads.
+ *
+ * Tests ThisThread::startPeriodic(), ThisThread::waitForNextPeriod() and ThisThread::stopPeriodic() - releases at
+ * exact time points, detection of missed deadlines and overruns, execution of overrun hook and release latency
+ * statistics.
+ */
+
+class ThreadPeriodicOperationsTestCase : public TestCase
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	virtual bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_THREAD_THREADPERIODICOPERATIONSTESTCASE_HPP_
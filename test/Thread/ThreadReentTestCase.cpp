@@ -0,0 +1,98 @@
+/**
+ * \file
+ * \brief ThreadReentTestCase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-03
+ */
+
+#include "ThreadReentTestCase.hpp"
+
+#include "distortos/StaticThread.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of stack for test thread, bytes
+constexpr size_t testThreadStackSize {384};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Test thread - saves pointer to _reent structure used by the thread and modifies errno.
+ *
+ * \param [out] sharedReent is a reference to variable which will be set to value of _impure_ptr in the thread
+ */
+
+void testThread(_reent*& sharedReent)
+{
+	sharedReent = _impure_ptr;
+	errno = ENOMEM;
+}
+
+/**
+ * \brief Runs test thread and checks the _reent structure it used.
+ *
+ * \param HasOwnReent selects whether the thread has its own _reent structure (true) or uses the global one (false)
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+template<bool HasOwnReent>
+bool testReent()
+{
+	_reent* reent {};
+	auto thread = makeStaticThread<testThreadStackSize, false, 0, 0, HasOwnReent>(UINT8_MAX, testThread,
+			std::ref(reent));
+
+	errno = {};
+	thread.start();
+	thread.join();
+
+	if (HasOwnReent == false)
+		return reent == _GLOBAL_REENT;
+
+	// errno of current thread is not affected by the thread with its own _reent structure
+	return reent != _GLOBAL_REENT && reent != _impure_ptr && errno == 0;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool ThreadReentTestCase::run_() const
+{
+	using ThreadWithReent = decltype(makeStaticThread<testThreadStackSize, false, 0, 0, true>({}, testThread,
+			std::declval<std::reference_wrapper<_reent*>>()));
+	using ThreadWithoutReent = decltype(makeStaticThread<testThreadStackSize, false, 0, 0, false>({}, testThread,
+			std::declval<std::reference_wrapper<_reent*>>()));
+	static_assert(sizeof(ThreadWithoutReent) < sizeof(ThreadWithReent),
+			"Thread without its own _reent structure should not have storage for it!");
+
+	return testReent<true>() == true && testReent<false>() == true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
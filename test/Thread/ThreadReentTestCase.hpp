@@ -0,0 +1,49 @@
+/**
+ * \file
+ * \brief ThreadReentTestCase class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-06-03
+ */
+
+#ifndef TEST_THREAD_THREADREENTTESTCASE_HPP_
+#define TEST_THREAD_THREADREENTTESTCASE_HPP_
+
+#include "TestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests selection of newlib's _reent structure for threads.
+ *
+ * Starts threads with and without their own _reent structure, asserting that each of them uses the right structure
+ * and that errno of a thread with its own _reent structure is independent from errno of current thread.
+ */
+
+class ThreadReentTestCase : public TestCase
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	virtual bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_THREAD_THREADREENTTESTCASE_HPP_
@@ -0,0 +1,255 @@
+/**
+ * \file
+ * \brief ThreadYieldToTestCase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-26
+ */
+
+#include "ThreadYieldToTestCase.hpp"
+
+#include "SequenceAsserter.hpp"
+#include "waitForNextTick.hpp"
+
+#include "distortos/StaticFifoQueue.hpp"
+#include "distortos/StaticThread.hpp"
+#include "distortos/ThisThread.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of stack for test thread, bytes
+constexpr size_t testThreadStackSize {256};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// type of FIFO queue used in tests
+using TestFifoQueue = StaticFifoQueue<unsigned int, 1>;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Test thread which marks single sequence point.
+ *
+ * \param [in] sequenceAsserter is a reference to SequenceAsserter shared object
+ * \param [in] sequencePoint is the sequence point of this instance
+ */
+
+void markerThread(SequenceAsserter& sequenceAsserter, const unsigned int sequencePoint)
+{
+	sequenceAsserter.sequencePoint(sequencePoint);
+}
+
+/**
+ * \brief Test thread which waits for semaphore and then marks single sequence point.
+ *
+ * \param [in] sequenceAsserter is a reference to SequenceAsserter shared object
+ * \param [in] semaphore is a reference to semaphore which will be waited for
+ * \param [in] sequencePoint is the sequence point of this instance
+ */
+
+void semaphoreThread(SequenceAsserter& sequenceAsserter, Semaphore& semaphore, const unsigned int sequencePoint)
+{
+	if (semaphore.wait() == 0)
+		sequenceAsserter.sequencePoint(sequencePoint);
+}
+
+/**
+ * \brief Test thread which pops sequence point from FIFO queue and then marks it.
+ *
+ * \param [in] sequenceAsserter is a reference to SequenceAsserter shared object
+ * \param [in] fifoQueue is a reference to FIFO queue from which the sequence point will be popped
+ */
+
+void fifoQueueThread(SequenceAsserter& sequenceAsserter, TestFifoQueue& fifoQueue)
+{
+	unsigned int sequencePoint {};
+	if (fifoQueue.pop(sequencePoint) == 0)
+		sequenceAsserter.sequencePoint(sequencePoint);
+}
+
+/**
+ * \brief Phase 1 of test case.
+ *
+ * Tests whether invalid requests are rejected by ThisThread::yieldTo().
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase1()
+{
+	SequenceAsserter sequenceAsserter;
+	const auto priority = ThisThread::getPriority();
+	auto notStartedThread = makeStaticThread<testThreadStackSize>(priority, markerThread, std::ref(sequenceAsserter),
+			0u);
+	auto lowerPriorityThread = makeStaticThread<testThreadStackSize>(priority - 1, markerThread,
+			std::ref(sequenceAsserter), 0u);
+
+	{
+		const auto ret = ThisThread::yieldTo(ThisThread::get());
+		if (ret != EINVAL)
+			return false;
+	}
+
+	{
+		const auto ret = ThisThread::yieldTo(notStartedThread);
+		if (ret != EINVAL)
+			return false;
+	}
+
+	lowerPriorityThread.start();
+
+	{
+		const auto ret = ThisThread::yieldTo(lowerPriorityThread);
+		if (ret != EPERM || sequenceAsserter.assertSequence(0) == false)
+			return false;
+	}
+
+	lowerPriorityThread.join();
+	return sequenceAsserter.assertSequence(1);
+}
+
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Starts three threads with the same priority as current thread and yields the CPU directly to the last one. It must
+ * run before all others, and current thread must run right after it.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	SequenceAsserter sequenceAsserter;
+	const auto priority = ThisThread::getPriority();
+	auto thread1 = makeStaticThread<testThreadStackSize>(priority, markerThread, std::ref(sequenceAsserter), 3u);
+	auto thread2 = makeStaticThread<testThreadStackSize>(priority, markerThread, std::ref(sequenceAsserter), 4u);
+	auto thread3 = makeStaticThread<testThreadStackSize>(priority, markerThread, std::ref(sequenceAsserter), 1u);
+
+	waitForNextTick();
+
+	thread1.start();
+	thread2.start();
+	thread3.start();
+
+	sequenceAsserter.sequencePoint(0);
+	const auto ret = ThisThread::yieldTo(thread3);
+	sequenceAsserter.sequencePoint(2);
+
+	thread1.join();
+	thread2.join();
+	thread3.join();
+
+	return ret == 0 && sequenceAsserter.assertSequence(5);
+}
+
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Thread with the same priority as current thread waits for semaphore. Another thread with the same priority is
+ * started, then the semaphore is posted with Semaphore::postAndSwitch() - the waiting thread must run before all
+ * others.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	SequenceAsserter sequenceAsserter;
+	Semaphore semaphore {0};
+	const auto priority = ThisThread::getPriority();
+	auto waitingThread = makeStaticThread<testThreadStackSize>(priority, semaphoreThread, std::ref(sequenceAsserter),
+			std::ref(semaphore), 1u);
+	auto otherThread = makeStaticThread<testThreadStackSize>(priority, markerThread, std::ref(sequenceAsserter), 3u);
+
+	waitForNextTick();
+
+	waitingThread.start();
+	ThisThread::yield();	// let the thread block on semaphore
+	otherThread.start();
+
+	sequenceAsserter.sequencePoint(0);
+	const auto ret = semaphore.postAndSwitch();
+	sequenceAsserter.sequencePoint(2);
+
+	waitingThread.join();
+	otherThread.join();
+
+	return ret == 0 && sequenceAsserter.assertSequence(4);
+}
+
+/**
+ * \brief Phase 4 of test case.
+ *
+ * Same as phase 3, but with FifoQueue::pushAndSwitch().
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase4()
+{
+	SequenceAsserter sequenceAsserter;
+	TestFifoQueue fifoQueue;
+	const auto priority = ThisThread::getPriority();
+	auto waitingThread = makeStaticThread<testThreadStackSize>(priority, fifoQueueThread, std::ref(sequenceAsserter),
+			std::ref(fifoQueue));
+	auto otherThread = makeStaticThread<testThreadStackSize>(priority, markerThread, std::ref(sequenceAsserter), 3u);
+
+	waitForNextTick();
+
+	waitingThread.start();
+	ThisThread::yield();	// let the thread block on FIFO queue
+	otherThread.start();
+
+	sequenceAsserter.sequencePoint(0);
+	const auto ret = fifoQueue.pushAndSwitch(1u);
+	sequenceAsserter.sequencePoint(2);
+
+	waitingThread.join();
+	otherThread.join();
+
+	return ret == 0 && sequenceAsserter.assertSequence(4);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool ThreadYieldToTestCase::run_() const
+{
+	for (const auto& function : {phase1, phase2, phase3, phase4})
+	{
+		const auto ret = function();
+		if (ret != true)
+			return ret;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
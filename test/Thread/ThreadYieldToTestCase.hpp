@@ -0,0 +1,49 @@
+/**
+ * \file
+ * \brief ThreadYieldToTestCase class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-26
+ */
+
+#ifndef TEST_THREAD_THREADYIELDTOTESTCASE_HPP_
+#define TEST_THREAD_THREADYIELDTOTESTCASE_HPP_
+
+#include "TestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests directed yield of threads.
+ *
+ * Tests whether ThisThread::yieldTo(), Semaphore::postAndSwitch() and FifoQueue::pushAndSwitch() hand the CPU directly
+ * to selected thread, skipping other threads with the same priority, and whether invalid requests are rejected.
+ */
+
+class ThreadYieldToTestCase : public TestCase
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	virtual bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_THREAD_THREADYIELDTOTESTCASE_HPP_
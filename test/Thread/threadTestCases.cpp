@@ -2,13 +2,13 @@
  * \file
  * \brief threadTestCases object definition
  *
- * \author Copyright (C) 2014 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2014-11-19
+ * \date 2015-06-03
  */
 
 #include "threadTestCases.hpp"
@@ -19,6 +19,10 @@
 #include "ThreadSleepUntilTestCase.hpp"
 #include "ThreadSchedulingPolicyTestCase.hpp"
 #include "ThreadPriorityChangeTestCase.hpp"
+#include "ThreadNotificationOperationsTestCase.hpp"
+#include "ThreadPeriodicOperationsTestCase.hpp"
+#include "ThreadYieldToTestCase.hpp"
+#include "ThreadReentTestCase.hpp"
 
 namespace distortos
 {
@@ -54,6 +58,18 @@ const ThreadPriorityChangeTestCase::Implementation priorityChangeTestCaseImpleme
 /// ThreadPriorityChangeTestCase instance
 const ThreadPriorityChangeTestCase priorityChangeTestCase {priorityChangeTestCaseImplementation};
 
+/// ThreadNotificationOperationsTestCase instance
+const ThreadNotificationOperationsTestCase notificationOperationsTestCase;
+
+/// ThreadPeriodicOperationsTestCase instance
+const ThreadPeriodicOperationsTestCase periodicOperationsTestCase;
+
+/// ThreadYieldToTestCase instance
+const ThreadYieldToTestCase yieldToTestCase;
+
+/// ThreadReentTestCase instance
+const ThreadReentTestCase reentTestCase;
+
 /// array with references to TestCase objects related to threads
 const TestCaseRange::value_type threadTestCases_[]
 {
@@ -63,6 +79,10 @@ const TestCaseRange::value_type threadTestCases_[]
 		TestCaseRange::value_type{sleepUntilTestCase},
 		TestCaseRange::value_type{schedulingPolicyTestCase},
 		TestCaseRange::value_type{priorityChangeTestCase},
+		TestCaseRange::value_type{notificationOperationsTestCase},
+		TestCaseRange::value_type{periodicOperationsTestCase},
+		TestCaseRange::value_type{yieldToTestCase},
+		TestCaseRange::value_type{reentTestCase},
 };
 
 }	// namespace
@@ -0,0 +1,125 @@
+/**
+ * \file
+ * \brief WaitOnAddressOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-28
+ */
+
+#include "WaitOnAddressOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/waitOnAddress.hpp"
+#include "distortos/StaticThread.hpp"
+#include "distortos/ThisThread.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of stack for test thread, bytes
+constexpr size_t testThreadStackSize {384};
+
+/// value of return code which was not yet set by test thread
+constexpr int notSetReturnCode {-1};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Test thread - waits on address while the word is equal to 0.
+ *
+ * \param [in] address is a pointer to 32-bit word on which the thread will wait
+ * \param [out] ret is a reference to variable for value returned by waitOnAddress()
+ */
+
+void testThread(const volatile uint32_t* const address, int& ret)
+{
+	ret = waitOnAddress(address, 0);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool WaitOnAddressOperationsTestCase::run_() const
+{
+	// first and last words of this array belong to the same bucket of wait queues
+	volatile uint32_t words[CONFIG_WAIT_ON_ADDRESS_BUCKETS + 1] {};
+	const auto firstWord = &words[0];
+	const auto lastWord = &words[CONFIG_WAIT_ON_ADDRESS_BUCKETS];
+
+	if (waitOnAddress(firstWord, 1) != EAGAIN || tryWaitOnAddressFor(firstWord, 1, TickClock::duration{1}) != EAGAIN)
+		return false;
+
+	{
+		waitForNextTick();
+		const auto start = TickClock::now();
+		const auto ret = tryWaitOnAddressFor(firstWord, 0, TickClock::duration{1});
+		if (ret != ETIMEDOUT || TickClock::now() - start != TickClock::duration{2})
+			return false;
+	}
+
+	if (wakeAddress(firstWord, SIZE_MAX) != 0)
+		return false;
+
+	int highRet {notSetReturnCode};
+	int lowRet {notSetReturnCode};
+	int otherRet {notSetReturnCode};
+	auto highThread = makeStaticThread<testThreadStackSize>(2, testThread, firstWord, std::ref(highRet));
+	auto lowThread = makeStaticThread<testThreadStackSize>(1, testThread, firstWord, std::ref(lowRet));
+	auto otherThread = makeStaticThread<testThreadStackSize>(1, testThread, lastWord, std::ref(otherRet));
+	lowThread.start();
+	highThread.start();
+	otherThread.start();
+
+	ThisThread::sleepFor(TickClock::duration{1});	// let test threads block
+
+	// the highest priority thread is woken first, threads waiting on other address are not affected
+	if (wakeAddress(firstWord, 1) != 1)
+		return false;
+
+	highThread.join();
+
+	if (highRet != 0 || lowRet != notSetReturnCode || otherRet != notSetReturnCode)
+		return false;
+
+	if (wakeAddress(firstWord, SIZE_MAX) != 1)
+		return false;
+
+	lowThread.join();
+
+	if (lowRet != 0 || otherRet != notSetReturnCode)
+		return false;
+
+	if (wakeAddress(lastWord, SIZE_MAX) != 1)
+		return false;
+
+	otherThread.join();
+
+	return otherRet == 0;
+}
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,50 @@
+/**
+ * \file
+ * \brief WaitOnAddressOperationsTestCase class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-28
+ */
+
+#ifndef TEST_WAITONADDRESS_WAITONADDRESSOPERATIONSTESTCASE_HPP_
+#define TEST_WAITONADDRESS_WAITONADDRESSOPERATIONSTESTCASE_HPP_
+
+#include "TestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests waitOnAddress() and wakeAddress() operations.
+ *
+ * Tests whether waiting fails when the value of the word doesn't match, whether timeouts work, whether threads waiting
+ * on different addresses (which may share the same bucket) are woken independently and whether the number of woken
+ * threads is reported correctly.
+ */
+
+class WaitOnAddressOperationsTestCase : public TestCase
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	virtual bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_WAITONADDRESS_WAITONADDRESSOPERATIONSTESTCASE_HPP_
@@ -0,0 +1,501 @@
+/**
+ * \file
+ * \brief WaitSetOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-16
+ */
+
+#include "WaitSetOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/Semaphore.hpp"
+#include "distortos/SoftwareTimer.hpp"
+#include "distortos/StaticFifoQueue.hpp"
+#include "distortos/StaticRawMessageQueue.hpp"
+#include "distortos/StaticThread.hpp"
+#include "distortos/StaticWaitSet.hpp"
+#include "distortos/ThisThread.hpp"
+#include "distortos/ThisThread-Signals.hpp"
+#include "distortos/ThreadBase.hpp"
+#include "distortos/statistics.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// type of FifoQueue used in tests
+using TestFifoQueue = StaticFifoQueue<uint32_t, 1>;
+
+/// type of RawMessageQueue used in tests
+using TestRawMessageQueue = StaticRawMessageQueue<uint32_t, 1>;
+
+/// type of WaitSet used in tests
+using TestWaitSet = StaticWaitSet<5>;
+
+/// objects which are added to TestWaitSet
+struct Objects
+{
+	/// Semaphore, index 0
+	Semaphore semaphore {0};
+
+	/// FifoQueue, index 1
+	TestFifoQueue fifoQueue;
+
+	/// RawMessageQueue, index 2
+	TestRawMessageQueue rawMessageQueue;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of stack for test thread, bytes
+constexpr size_t testThreadStackSize {768};
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// long duration used in tests
+constexpr auto longDuration = singleDuration * 10;
+
+/// expected number of context switches related to test thread: 1 - main thread starts test thread (main -> test),
+/// 2 - test thread terminates (test -> main)
+constexpr decltype(statistics::getContextSwitchCount()) testThreadContextSwitchCount {2};
+
+/// expected number of context switches in waitForNextTick(): test -> idle -> test
+constexpr decltype(statistics::getContextSwitchCount()) waitForNextTickContextSwitchCount {2};
+
+/// expected number of context switches in phase2 and phase3 blocks (excluding waitForNextTick()): 1 - test thread
+/// waits on WaitSet (test -> idle), 2 - test thread wakes up (idle -> test)
+constexpr decltype(statistics::getContextSwitchCount()) waitContextSwitchCount {2};
+
+/// number of objects in TestWaitSet
+constexpr WaitSet::Index objectsCount {5};
+
+/// signal number used in tests
+constexpr uint8_t testSignalNumber {3};
+
+/// index of signals in TestWaitSet
+constexpr WaitSet::Index signalsIndex {3};
+
+/// index of notification in TestWaitSet
+constexpr WaitSet::Index notificationIndex {4};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Adds all objects to the set.
+ *
+ * \param [in] waitSet is a reference to TestWaitSet to which objects will be added
+ * \param [in] objects is a reference to Objects which will be added
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool addObjects(TestWaitSet& waitSet, Objects& objects)
+{
+	const std::pair<int, WaitSet::Index> results[]
+	{
+			waitSet.add(objects.semaphore),
+			waitSet.add(objects.fifoQueue),
+			waitSet.add(objects.rawMessageQueue),
+			waitSet.addSignals(SignalSet{1u << testSignalNumber}),
+			waitSet.addNotification(),
+	};
+
+	for (WaitSet::Index index {}; index < objectsCount; ++index)
+		if (results[index].first != 0 || results[index].second != index)
+			return false;
+
+	return true;
+}
+
+/**
+ * \brief Makes selected object "ready".
+ *
+ * \note This function may be called from thread or interrupt context.
+ *
+ * \param [in] objects is a reference to Objects
+ * \param [in] thread is a reference to thread which waits on TestWaitSet
+ * \param [in] index is the index of object that will be made "ready"
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool makeReady(Objects& objects, ThreadBase& thread, const WaitSet::Index index)
+{
+	const auto value = static_cast<uint32_t>(index);
+	int ret {EINVAL};
+	if (index == 0)
+		ret = objects.semaphore.post();
+	else if (index == 1)
+		ret = objects.fifoQueue.tryPush(value);
+	else if (index == 2)
+		ret = objects.rawMessageQueue.tryPush(uint8_t{}, value);
+	else if (index == signalsIndex)
+		ret = thread.generateSignal(testSignalNumber);
+	else if (index == notificationIndex)
+		ret = thread.notify(ThreadBase::NotificationAction::Increment);
+
+	return ret == 0;
+}
+
+/**
+ * \brief "Consumes" selected object, so that it is no longer "ready".
+ *
+ * \param [in] objects is a reference to Objects
+ * \param [in] index is the index of object that will be "consumed"
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool consume(Objects& objects, const WaitSet::Index index)
+{
+	if (index == 0)
+		return objects.semaphore.tryWait() == 0;
+
+	if (index == 1)
+	{
+		uint32_t value {};
+		return objects.fifoQueue.tryPop(value) == 0 && value == index;
+	}
+
+	if (index == 2)
+	{
+		uint8_t priority {};
+		uint32_t value {};
+		return objects.rawMessageQueue.tryPop(priority, value) == 0 && value == index;
+	}
+
+	if (index == signalsIndex)
+	{
+		const auto tryWaitResult = ThisThread::Signals::tryWait(SignalSet{1u << testSignalNumber});
+		return tryWaitResult.first == 0 && tryWaitResult.second.getSignalNumber() == testSignalNumber;
+	}
+
+	if (index == notificationIndex)
+	{
+		const auto tryWaitNotificationResult = ThisThread::tryWaitNotification();
+		return tryWaitNotificationResult.first == 0 && tryWaitNotificationResult.second == 1;
+	}
+
+	return false;
+}
+
+/**
+ * \brief Tests WaitSet::tryWait() when no object is "ready" - it must fail immediately and return EAGAIN
+ *
+ * \param [in] waitSet is a reference to TestWaitSet that will be tested
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testTryWaitWhenNotReady(TestWaitSet& waitSet)
+{
+	waitForNextTick();
+	const auto start = TickClock::now();
+	const auto tryWaitResult = waitSet.tryWait();
+	return tryWaitResult.first == EAGAIN && start == TickClock::now();
+}
+
+/**
+ * \brief Phase 1 of test case.
+ *
+ * Tests adding objects to the set with error detection. Tests WaitSet::tryWait() - objects are made "ready" by current
+ * thread, the lowest index of "ready" object must be returned.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase1()
+{
+	auto& thread = ThisThread::get();
+	Objects objects;
+	TestWaitSet waitSet;
+
+	{
+		const auto ret = addObjects(waitSet, objects);
+		if (ret != true)
+			return ret;
+	}
+
+	{
+		// set is full
+		Semaphore semaphore {0};
+		const auto addResult = waitSet.add(semaphore);
+		if (addResult.first != ENOSPC)
+			return false;
+	}
+
+	{
+		// notification was already added
+		const auto addNotificationResult = waitSet.addNotification();
+		if (addNotificationResult.first != EEXIST || addNotificationResult.second != notificationIndex)
+			return false;
+	}
+
+	{
+		// signals may be added again - sets are merged and index remains the same
+		const auto addSignalsResult = waitSet.addSignals(SignalSet{1u << testSignalNumber});
+		if (addSignalsResult.first != 0 || addSignalsResult.second != signalsIndex)
+			return false;
+	}
+
+	{
+		const auto ret = testTryWaitWhenNotReady(waitSet);
+		if (ret != true)
+			return ret;
+	}
+
+	// make all objects "ready", starting from the last one - each time the lowest index must be returned
+	for (auto index = objectsCount; index > 0; --index)
+	{
+		if (makeReady(objects, thread, index - 1) != true)
+			return false;
+
+		const auto tryWaitResult = waitSet.tryWait();
+		if (tryWaitResult.first != 0 || tryWaitResult.second != index - 1)
+			return false;
+	}
+
+	// "consume" objects, starting from the first one - each time next index must be returned
+	for (WaitSet::Index index {}; index < objectsCount; ++index)
+	{
+		if (consume(objects, index) != true)
+			return false;
+
+		const auto tryWaitResult = waitSet.tryWait();
+		if (index + 1 != objectsCount && (tryWaitResult.first != 0 || tryWaitResult.second != index + 1))
+			return false;
+	}
+
+	{
+		const auto ret = testTryWaitWhenNotReady(waitSet);
+		if (ret != true)
+			return ret;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Tests whether WaitSet::tryWaitFor() and WaitSet::tryWaitUntil() properly time-out when no object becomes "ready".
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	Objects objects;
+	TestWaitSet waitSet;
+
+	{
+		const auto ret = addObjects(waitSet, objects);
+		if (ret != true)
+			return ret;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+
+		// no object is "ready", so tryWaitFor() should time-out at expected time
+		const auto start = TickClock::now();
+		const auto tryWaitResult = waitSet.tryWaitFor(singleDuration);
+		const auto realDuration = TickClock::now() - start;
+		if (tryWaitResult.first != ETIMEDOUT || realDuration != singleDuration + decltype(singleDuration){1} ||
+				statistics::getContextSwitchCount() - contextSwitchCount != waitContextSwitchCount)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+
+		// no object is "ready", so tryWaitUntil() should time-out at exact expected time
+		const auto requestedTimePoint = TickClock::now() + singleDuration;
+		const auto tryWaitResult = waitSet.tryWaitUntil(requestedTimePoint);
+		if (tryWaitResult.first != ETIMEDOUT || requestedTimePoint != TickClock::now() ||
+				statistics::getContextSwitchCount() - contextSwitchCount != waitContextSwitchCount)
+			return false;
+	}
+
+	return testTryWaitWhenNotReady(waitSet);
+}
+
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Tests interrupt-thread communication scenario. Test (current) thread waits on WaitSet. Software timer is used to make
+ * selected object "ready" at specified time point from interrupt context, test thread is expected to wake up (with
+ * wait() for each object, tryWaitFor() and tryWaitUntil()) in the same moment.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	auto& thread = ThisThread::get();
+	Objects objects;
+	TestWaitSet waitSet;
+
+	{
+		const auto ret = addObjects(waitSet, objects);
+		if (ret != true)
+			return ret;
+	}
+
+	WaitSet::Index readyIndex {};
+	bool makeReadyResult {};
+	auto softwareTimer = makeSoftwareTimer([&objects, &thread, &readyIndex, &makeReadyResult]()
+			{
+				makeReadyResult = makeReady(objects, thread, readyIndex);
+			});
+
+	for (WaitSet::Index index {}; index < objectsCount; ++index)
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+
+		readyIndex = index;
+		makeReadyResult = false;
+		softwareTimer.start(wakeUpTimePoint);
+
+		// no object is "ready", but wait() should succeed at expected time
+		const auto waitResult = waitSet.wait();
+		const auto wokenUpTimePoint = TickClock::now();
+		if (waitResult.first != 0 || waitResult.second != index || makeReadyResult != true ||
+				wakeUpTimePoint != wokenUpTimePoint ||
+				statistics::getContextSwitchCount() - contextSwitchCount != waitContextSwitchCount ||
+				consume(objects, index) != true)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+
+		readyIndex = 1;
+		makeReadyResult = false;
+		softwareTimer.start(wakeUpTimePoint);
+
+		// no object is "ready", but tryWaitFor() should succeed at expected time
+		const auto tryWaitResult = waitSet.tryWaitFor(wakeUpTimePoint - TickClock::now() + longDuration);
+		const auto wokenUpTimePoint = TickClock::now();
+		if (tryWaitResult.first != 0 || tryWaitResult.second != readyIndex || makeReadyResult != true ||
+				wakeUpTimePoint != wokenUpTimePoint ||
+				statistics::getContextSwitchCount() - contextSwitchCount != waitContextSwitchCount ||
+				consume(objects, readyIndex) != true)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+
+		readyIndex = 2;
+		makeReadyResult = false;
+		softwareTimer.start(wakeUpTimePoint);
+
+		// no object is "ready", but tryWaitUntil() should succeed at expected time
+		const auto tryWaitResult = waitSet.tryWaitUntil(wakeUpTimePoint + longDuration);
+		const auto wokenUpTimePoint = TickClock::now();
+		if (tryWaitResult.first != 0 || tryWaitResult.second != readyIndex || makeReadyResult != true ||
+				wakeUpTimePoint != wokenUpTimePoint ||
+				statistics::getContextSwitchCount() - contextSwitchCount != waitContextSwitchCount ||
+				consume(objects, readyIndex) != true)
+			return false;
+	}
+
+	return testTryWaitWhenNotReady(waitSet);
+}
+
+/**
+ * \brief Test thread function - executes all phases of test case.
+ *
+ * Test must be executed in separate thread, because the main thread cannot receive signals.
+ *
+ * \param [out] sharedRet is a reference to variable in which result of test will be stored
+ */
+
+void testThreadFunction(bool& sharedRet)
+{
+	for (const auto& function : {phase1, phase2, phase3})
+	{
+		const auto ret = function();
+		if (ret != true)
+		{
+			sharedRet = ret;
+			return;
+		}
+	}
+
+	sharedRet = true;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool WaitSetOperationsTestCase::run_() const
+{
+	constexpr auto phase1ExpectedContextSwitchCount = 2 * waitForNextTickContextSwitchCount;
+	constexpr auto phase2ExpectedContextSwitchCount = 3 * waitForNextTickContextSwitchCount +
+			2 * waitContextSwitchCount;
+	constexpr auto phase3ExpectedContextSwitchCount = (objectsCount + 3) * waitForNextTickContextSwitchCount +
+			(objectsCount + 2) * waitContextSwitchCount;
+	constexpr auto expectedContextSwitchCount = testThreadContextSwitchCount + phase1ExpectedContextSwitchCount +
+			phase2ExpectedContextSwitchCount + phase3ExpectedContextSwitchCount;
+
+	const auto contextSwitchCount = statistics::getContextSwitchCount();
+
+	bool sharedRet {};
+	auto testThread = makeStaticThread<testThreadStackSize, true, 0>(UINT8_MAX, testThreadFunction,
+			std::ref(sharedRet));
+	testThread.start();
+	testThread.join();
+
+	if (sharedRet != true)
+		return sharedRet;
+
+	if (statistics::getContextSwitchCount() - contextSwitchCount != expectedContextSwitchCount)
+		return false;
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,49 @@
+/**
+ * \file
+ * \brief WaitSetOperationsTestCase class header
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-16
+ */
+
+#ifndef TEST_WAITSET_WAITSETOPERATIONSTESTCASE_HPP_
+#define TEST_WAITSET_WAITSETOPERATIONSTESTCASE_HPP_
+
+#include "TestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests various WaitSet operations.
+ *
+ * Tests adding objects to the set, error detection and waiting for various types of objects (Semaphore, FifoQueue,
+ * RawMessageQueue, signals and notification) with wait(), tryWait(), tryWaitFor() and tryWaitUntil().
+ */
+
+class WaitSetOperationsTestCase : public TestCase
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	virtual bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_WAITSET_WAITSETOPERATIONSTESTCASE_HPP_
@@ -0,0 +1,50 @@
+/**
+ * \file
+ * \brief waitSetTestCases object definition
+ *
+ * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \date 2015-05-16
+ */
+
+#include "waitSetTestCases.hpp"
+
+#include "WaitSetOperationsTestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// WaitSetOperationsTestCase instance
+const WaitSetOperationsTestCase operationsTestCase;
+
+/// array with references to TestCase objects related to WaitSet
+const TestCaseRange::value_type waitSetTestCases_[]
+{
+		TestCaseRange::value_type{operationsTestCase},
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+const TestCaseRange waitSetTestCases {waitSetTestCases_};
+
+}	// namespace test
+
+}	// namespace distortos
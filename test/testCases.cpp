@@ -8,21 +8,30 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
- * \date 2015-02-18
+ * \date 2015-06-04
  */
 
 #include "testCases.hpp"
 
 #include "Thread/threadTestCases.hpp"
 #include "SoftwareTimer/softwareTimerTestCases.hpp"
+#include "ScheduleTable/scheduleTableTestCases.hpp"
+#include "HighResolutionClock/highResolutionClockTestCases.hpp"
+#include "Idle/idleTestCases.hpp"
 #include "Semaphore/semaphoreTestCases.hpp"
 #include "Mutex/mutexTestCases.hpp"
+#include "RwLock/rwLockTestCases.hpp"
 #include "ConditionVariable/conditionVariableTestCases.hpp"
 #include "FifoQueue/fifoQueueTestCases.hpp"
 #include "RawFifoQueue/rawFifoQueueTestCases.hpp"
 #include "MessageQueue/messageQueueTestCases.hpp"
 #include "RawMessageQueue/rawMessageQueueTestCases.hpp"
 #include "Signals/signalsTestCases.hpp"
+#include "WaitSet/waitSetTestCases.hpp"
+#include "Channel/channelTestCases.hpp"
+#include "WaitOnAddress/waitOnAddressTestCases.hpp"
+#include "Statistics/statisticsTestCases.hpp"
+#include "DeferredRequestQueue/deferredRequestQueueTestCases.hpp"
 
 namespace distortos
 {
@@ -42,14 +51,23 @@ const TestCaseRangeRange::value_type testCases_[]
 {
 		TestCaseRangeRange::value_type{threadTestCases},
 		TestCaseRangeRange::value_type{softwareTimerTestCases},
+		TestCaseRangeRange::value_type{scheduleTableTestCases},
+		TestCaseRangeRange::value_type{highResolutionClockTestCases},
+		TestCaseRangeRange::value_type{idleTestCases},
 		TestCaseRangeRange::value_type{semaphoreTestCases},
 		TestCaseRangeRange::value_type{mutexTestCases},
+		TestCaseRangeRange::value_type{rwLockTestCases},
 		TestCaseRangeRange::value_type{conditionVariableTestCases},
 		TestCaseRangeRange::value_type{fifoQueueTestCases},
 		TestCaseRangeRange::value_type{rawFifoQueueTestCases},
 		TestCaseRangeRange::value_type{messageQueueTestCases},
 		TestCaseRangeRange::value_type{rawMessageQueueTestCases},
 		TestCaseRangeRange::value_type{signalsTestCases},
+		TestCaseRangeRange::value_type{waitSetTestCases},
+		TestCaseRangeRange::value_type{channelTestCases},
+		TestCaseRangeRange::value_type{waitOnAddressTestCases},
+		TestCaseRangeRange::value_type{statisticsTestCases},
+		TestCaseRangeRange::value_type{deferredRequestQueueTestCases},
 };
 
 }	// namespace